@@ -11,6 +11,15 @@ public:
     typedef size_t block_size_t;
     
     typedef void *block_pointer_t;
+    
+    struct allocation_result final
+    {
+        
+        block_pointer_t pointer;
+        
+        block_size_t size;
+        
+    };
 
 public:
     
@@ -36,6 +45,10 @@ public:
         size_t value_size,
         size_t values_count) = 0;
     
+    [[nodiscard]] virtual allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count);
+    
     virtual void deallocate(
         void *at) = 0;
     
@@ -59,4 +72,11 @@ inline void allocator::destruct(
     at->~T();
 }
 
+inline allocator::allocation_result allocator::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    return { allocate(value_size, values_count), value_size * values_count };
+}
+
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_H
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_MAINTENANCE_THREAD_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_MAINTENANCE_THREAD_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "allocator_with_coalescing_mode.h"
+
+// coalesces and trims attached allocators in batches off the request threads: every interval
+// or as soon as maintenance is requested. attached allocators are expected to run in deferred
+// coalescing mode, so deallocate only parks the block and the merge happens here;
+// they detach themselves on destruction, so the thread has to outlive them
+class allocator_maintenance_thread final
+{
+
+private:
+    
+    std::vector<allocator_with_coalescing_mode *> _allocators;
+    
+    std::chrono::milliseconds _interval;
+    
+    std::atomic<bool> _is_maintenance_requested;
+    
+    std::atomic<bool> _is_stopping;
+    
+    std::atomic<uint64_t> _passes_count;
+    
+    // guards the attached list only and is never held while an allocator is maintained
+    std::mutex _allocators_mutex;
+    
+    // held for a whole pass, so detach never returns while the allocator is being maintained
+    std::mutex _pass_mutex;
+    
+    // held by the thread only while it checks the flags and goes to sleep
+    std::mutex _wake_up_mutex;
+    
+    std::condition_variable _wake_up;
+    
+    std::thread _thread;
+
+public:
+    
+    explicit allocator_maintenance_thread(
+        std::chrono::milliseconds interval = std::chrono::milliseconds(10));
+    
+    ~allocator_maintenance_thread() noexcept;
+    
+    allocator_maintenance_thread(
+        allocator_maintenance_thread const &other) = delete;
+    
+    allocator_maintenance_thread &operator=(
+        allocator_maintenance_thread const &other) = delete;
+    
+    allocator_maintenance_thread(
+        allocator_maintenance_thread &&other) = delete;
+    
+    allocator_maintenance_thread &operator=(
+        allocator_maintenance_thread &&other) = delete;
+
+public:
+    
+    // one thread for the whole process, started on first use
+    static allocator_maintenance_thread &get_shared();
+
+public:
+    
+    void attach(
+        allocator_with_coalescing_mode *target_allocator);
+    
+    // waits for the running pass to finish, after return the allocator can be destroyed;
+    // must not be called under the allocator lock, the pass takes it
+    void detach(
+        allocator_with_coalescing_mode *target_allocator);
+    
+    // never waits for a running pass: it only touches the wake up mutex, which is held just around the sleep
+    void request_maintenance() noexcept;
+
+public:
+    
+    uint64_t get_passes_count() const noexcept;
+
+private:
+    
+    void run() noexcept;
+    
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_MAINTENANCE_THREAD_H
\ No newline at end of file
@@ -0,0 +1,163 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_STD_ADAPTER_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_STD_ADAPTER_H
+
+#include <memory>
+#include <new>
+
+#include "allocator.h"
+
+template<
+    typename T>
+class allocator_std_adapter
+{
+    
+    template<
+        typename U>
+    friend class allocator_std_adapter;
+
+public:
+    
+    typedef T value_type;
+    
+#if defined(__cpp_lib_allocate_at_least)
+    typedef std::allocation_result<T *> allocation_result;
+#else
+    struct allocation_result final
+    {
+        
+        T *ptr;
+        
+        size_t count;
+        
+    };
+#endif
+
+private:
+    
+    allocator *_allocator;
+
+public:
+    
+    explicit allocator_std_adapter(
+        allocator *allocator = nullptr) noexcept;
+    
+    template<
+        typename U>
+    allocator_std_adapter(
+        allocator_std_adapter<U> const &other) noexcept;
+
+public:
+    
+    [[nodiscard]] T *allocate(
+        size_t values_count);
+    
+    [[nodiscard]] allocation_result allocate_at_least(
+        size_t values_count);
+    
+    void deallocate(
+        T *at,
+        size_t values_count);
+
+public:
+    
+    allocator *get_allocator() const noexcept;
+
+public:
+    
+    template<
+        typename U>
+    bool operator==(
+        allocator_std_adapter<U> const &other) const noexcept;
+    
+    template<
+        typename U>
+    bool operator!=(
+        allocator_std_adapter<U> const &other) const noexcept;
+    
+};
+
+template<
+    typename T>
+allocator_std_adapter<T>::allocator_std_adapter(
+    allocator *allocator) noexcept:
+    _allocator(allocator)
+{
+
+}
+
+template<
+    typename T>
+template<
+    typename U>
+allocator_std_adapter<T>::allocator_std_adapter(
+    allocator_std_adapter<U> const &other) noexcept:
+    _allocator(other._allocator)
+{
+
+}
+
+template<
+    typename T>
+T *allocator_std_adapter<T>::allocate(
+    size_t values_count)
+{
+    return reinterpret_cast<T *>(_allocator == nullptr
+        ? ::operator new(sizeof(T) * values_count)
+        : _allocator->allocate(sizeof(T), values_count));
+}
+
+template<
+    typename T>
+typename allocator_std_adapter<T>::allocation_result allocator_std_adapter<T>::allocate_at_least(
+    size_t values_count)
+{
+    if (_allocator == nullptr)
+    {
+        return { reinterpret_cast<T *>(::operator new(sizeof(T) * values_count)), values_count };
+    }
+    
+    auto result = _allocator->allocate_at_least(sizeof(T), values_count);
+    
+    return { reinterpret_cast<T *>(result.pointer), result.size / sizeof(T) };
+}
+
+template<
+    typename T>
+void allocator_std_adapter<T>::deallocate(
+    T *at,
+    size_t values_count)
+{
+    // the global fallback takes the size back, as sized deallocation pairs with the ::operator new in allocate
+    _allocator == nullptr
+        ? ::operator delete(at, sizeof(T) * values_count)
+        : _allocator->deallocate(at);
+}
+
+template<
+    typename T>
+allocator *allocator_std_adapter<T>::get_allocator() const noexcept
+{
+    return _allocator;
+}
+
+template<
+    typename T>
+template<
+    typename U>
+bool allocator_std_adapter<T>::operator==(
+    allocator_std_adapter<U> const &other) const noexcept
+{
+    return _allocator == other._allocator;
+}
+
+template<
+    typename T>
+template<
+    typename U>
+bool allocator_std_adapter<T>::operator!=(
+    allocator_std_adapter<U> const &other) const noexcept
+{
+    return !(*this == other);
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_STD_ADAPTER_H
\ No newline at end of file
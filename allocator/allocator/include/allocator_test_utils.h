@@ -2,6 +2,8 @@
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_TEST_UTILS_H
 
 #include <cstddef>
+#include <iosfwd>
+#include <map>
 #include <vector>
 
 class allocator_test_utils
@@ -23,6 +25,58 @@ public:
             block_info const &other) const noexcept;
         
     };
+    
+    struct block_layout_info final
+    {
+        
+        // from the beginning of the trusted memory, metadata included
+        size_t block_offset;
+        
+        size_t block_size;
+        
+        bool is_block_occupied;
+        
+        // how many times the fit search has picked this block
+        size_t fit_hits_count;
+        
+        bool operator==(
+            block_layout_info const &other) const noexcept;
+        
+        bool operator!=(
+            block_layout_info const &other) const noexcept;
+        
+    };
+    
+    struct fragmentation_statistics final
+    {
+        
+        size_t total_size;
+        
+        size_t free_size;
+        
+        size_t free_blocks_count;
+        
+        size_t largest_free_block_size;
+        
+        // key is the lower power of two bound of a free block size
+        std::map<size_t, size_t> free_blocks_sizes_histogram;
+        
+        size_t request_size;
+        
+        // free bytes laying in blocks which are too small to serve the request size
+        size_t unusable_free_size;
+        
+        double get_unusable_free_percentage() const noexcept;
+        
+    };
+
+public:
+    
+    enum class layout_format
+    {
+        csv,
+        binary
+    };
 
 public:
     
@@ -32,6 +86,24 @@ public:
     
     virtual std::vector<block_info> get_blocks_info() const noexcept = 0;
     
+    // takes one pass over the blocks under the allocator lock, serialization happens outside of it
+    virtual std::vector<block_layout_info> get_blocks_layout() const = 0;
+
+public:
+    
+    static void export_layout(
+        std::vector<block_layout_info> const &layout,
+        std::ostream &stream,
+        layout_format format = layout_format::binary);
+    
+    // format is detected by the leading bytes of the stream
+    static std::vector<block_layout_info> import_layout(
+        std::istream &stream);
+    
+    static fragmentation_statistics get_fragmentation_statistics(
+        std::vector<block_layout_info> const &layout,
+        size_t request_size);
+    
 };
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_TEST_UTILS_H
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_WITH_COALESCING_MODE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_WITH_COALESCING_MODE_H
+
+#include <cstddef>
+
+class allocator_maintenance_thread;
+
+class allocator_with_coalescing_mode
+{
+
+    friend class allocator_maintenance_thread;
+
+public:
+    
+    enum class coalescing_mode
+    {
+        // freed block is merged with its free neighbours inside deallocate
+        immediate,
+        // freed block is parked in a size-keyed quick list; merging happens in one address-ordered sweep
+        // when an allocation can not be served from the quick lists or the quick lists hold too many blocks,
+        // the latter sweep is left to the maintenance thread the allocator is attached to, if any
+        deferred
+    };
+
+public:
+    
+    // max count of blocks parked in the quick lists before a sweep is forced
+    static constexpr size_t deferred_blocks_threshold = 32;
+
+public:
+    
+    virtual ~allocator_with_coalescing_mode() noexcept = default;
+
+public:
+    
+    inline virtual void set_coalescing_mode(
+        coalescing_mode mode) = 0;
+    
+    // merges all parked blocks with their free neighbours right now;
+    // may be called from a maintenance thread, so it has to take the allocator lock itself
+    virtual void coalesce() = 0;
+    
+    // hands whole pages inside free blocks back to the OS, same locking contract as coalesce
+    virtual void trim() = 0;
+    
+    // how many block size tags have been written so far, the work deferred coalescing is meant to save
+    virtual size_t get_header_writes_count() const noexcept = 0;
+
+private:
+    
+    // called by the maintenance thread on attach and with nullptr on detach; while it is set deallocate
+    // only requests a pass instead of sweeping inline, and the allocator has to detach itself before it dies
+    virtual void set_maintenance_thread(
+        allocator_maintenance_thread *maintenance_thread) noexcept = 0;
+
+protected:
+    
+    // returns how many bytes of the page aligned interior of the block have been released;
+    // released pages read as zeroes on the next touch
+    static size_t release_pages(
+        void *block,
+        size_t block_size) noexcept;
+    
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_WITH_COALESCING_MODE_H
\ No newline at end of file
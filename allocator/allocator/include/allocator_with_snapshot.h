@@ -0,0 +1,62 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_WITH_SNAPSHOT_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_WITH_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class allocator_with_snapshot
+{
+
+public:
+    
+    virtual ~allocator_with_snapshot() noexcept = default;
+
+public:
+    
+    // writes the whole trusted memory image to the file descriptor in one sequential pass
+    virtual void snapshot_to(
+        int fd) const = 0;
+    
+    // replaces the trusted memory with an image previously written by snapshot_to
+    virtual void restore_from(
+        int fd) = 0;
+
+protected:
+    
+    // the image is tagged with the allocator type and its layout version,
+    // so an image is never restored into another allocator or over a changed layout
+    static void write_image(
+        int fd,
+        std::string const &image_type,
+        uint32_t image_version,
+        void const *image,
+        size_t image_size);
+    
+    static size_t read_image_size(
+        int fd,
+        std::string const &image_type,
+        uint32_t image_version);
+    
+    static void read_image(
+        int fd,
+        void *image,
+        size_t image_size);
+    
+    // rebases a pointer into the [old_base, old_base + image_size) image onto new_base,
+    // pointers outside the image (parent allocator, logger, nullptr) are returned as is
+    static void *relocate(
+        void *pointer,
+        void const *old_base,
+        size_t image_size,
+        void *new_base) noexcept;
+    
+    // offset of a pointer into the [old_base, old_base + image_size) image, image_size for pointers outside it
+    static size_t get_image_offset(
+        void const *pointer,
+        void const *old_base,
+        size_t image_size) noexcept;
+    
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_WITH_SNAPSHOT_H
\ No newline at end of file
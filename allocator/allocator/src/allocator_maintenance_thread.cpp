@@ -0,0 +1,130 @@
+#include <algorithm>
+
+#include "../include/allocator_maintenance_thread.h"
+
+allocator_maintenance_thread::allocator_maintenance_thread(
+    std::chrono::milliseconds interval):
+    _interval(interval),
+    _is_maintenance_requested(false),
+    _is_stopping(false),
+    _passes_count(0)
+{
+    _thread = std::thread(&allocator_maintenance_thread::run, this);
+}
+
+allocator_maintenance_thread::~allocator_maintenance_thread() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_wake_up_mutex);
+        _is_stopping.store(true, std::memory_order_release);
+    }
+    
+    _wake_up.notify_one();
+    _thread.join();
+    
+    // an allocator that outlives the thread falls back to sweeping inline
+    for (auto target_allocator: _allocators)
+    {
+        target_allocator->set_maintenance_thread(nullptr);
+    }
+}
+
+allocator_maintenance_thread &allocator_maintenance_thread::get_shared()
+{
+    static allocator_maintenance_thread shared;
+    
+    return shared;
+}
+
+void allocator_maintenance_thread::attach(
+    allocator_with_coalescing_mode *target_allocator)
+{
+    std::lock_guard<std::mutex> lock(_allocators_mutex);
+    
+    if (std::find(_allocators.begin(), _allocators.end(), target_allocator) == _allocators.end())
+    {
+        _allocators.push_back(target_allocator);
+        target_allocator->set_maintenance_thread(this);
+    }
+}
+
+void allocator_maintenance_thread::detach(
+    allocator_with_coalescing_mode *target_allocator)
+{
+    {
+        std::lock_guard<std::mutex> lock(_allocators_mutex);
+        _allocators.erase(std::remove(_allocators.begin(), _allocators.end(), target_allocator), _allocators.end());
+        target_allocator->set_maintenance_thread(nullptr);
+    }
+    
+    // a pass that has taken its snapshot before the erase may still use the allocator
+    std::lock_guard<std::mutex> lock(_pass_mutex);
+}
+
+void allocator_maintenance_thread::request_maintenance() noexcept
+{
+    {
+        // without the lock the flag could be set between the check and the sleep and the wake up would be lost
+        std::lock_guard<std::mutex> lock(_wake_up_mutex);
+        _is_maintenance_requested.store(true, std::memory_order_release);
+    }
+    
+    _wake_up.notify_one();
+}
+
+uint64_t allocator_maintenance_thread::get_passes_count() const noexcept
+{
+    return _passes_count.load(std::memory_order_acquire);
+}
+
+void allocator_maintenance_thread::run() noexcept
+{
+    std::vector<allocator_with_coalescing_mode *> attached_allocators;
+    
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_wake_up_mutex);
+            _wake_up.wait_for(lock, _interval, [this]()
+            {
+                return _is_stopping.load(std::memory_order_acquire) || _is_maintenance_requested.load(std::memory_order_acquire);
+            });
+        }
+        
+        if (_is_stopping.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        
+        _is_maintenance_requested.store(false, std::memory_order_release);
+        
+        std::lock_guard<std::mutex> pass_lock(_pass_mutex);
+        
+        // attach and detach are not blocked by the pass, it walks a snapshot of the list
+        try
+        {
+            std::lock_guard<std::mutex> lock(_allocators_mutex);
+            attached_allocators = _allocators;
+        }
+        catch (...)
+        {
+            continue;
+        }
+        
+        for (auto target_allocator: attached_allocators)
+        {
+            // a failing allocator reports through its own logger, the rest still get maintained
+            try
+            {
+                target_allocator->coalesce();
+                target_allocator->trim();
+            }
+            catch (...)
+            {
+
+            }
+        }
+        
+        _passes_count.fetch_add(1, std::memory_order_release);
+    }
+}
\ No newline at end of file
@@ -1,5 +1,60 @@
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
 #include "../include/allocator_test_utils.h"
 
+namespace
+{
+    
+    char const layout_magic[] = { 'M', 'P', 'H', 'L' };
+    
+    uint32_t const layout_version = 1;
+    
+    char const layout_csv_header[] = "block_offset,block_size,is_block_occupied,fit_hits_count";
+    
+    uint64_t const occupied_flag = uint64_t(1) << 63;
+    
+    // values are always written little endian so images can be moved between machines
+    void write_uint(
+        std::ostream &stream,
+        uint64_t value,
+        size_t bytes_count)
+    {
+        char bytes[sizeof(uint64_t)];
+        for (size_t i = 0; i < bytes_count; ++i)
+        {
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+        
+        stream.write(bytes, bytes_count);
+    }
+    
+    uint64_t read_uint(
+        std::istream &stream,
+        size_t bytes_count)
+    {
+        unsigned char bytes[sizeof(uint64_t)];
+        if (!stream.read(reinterpret_cast<char *>(bytes), bytes_count))
+        {
+            throw std::runtime_error("heap layout is truncated");
+        }
+        
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes_count; ++i)
+        {
+            value |= uint64_t(bytes[i]) << (8 * i);
+        }
+        
+        return value;
+    }
+    
+}
+
 bool allocator_test_utils::block_info::operator==(
     allocator_test_utils::block_info const &other) const noexcept
 {
@@ -11,4 +66,162 @@ bool allocator_test_utils::block_info::operator!=(
     allocator_test_utils::block_info const &other) const noexcept
 {
     return !(*this == other);
+}
+
+bool allocator_test_utils::block_layout_info::operator==(
+    allocator_test_utils::block_layout_info const &other) const noexcept
+{
+    return block_offset == other.block_offset
+           && block_size == other.block_size
+           && is_block_occupied == other.is_block_occupied
+           && fit_hits_count == other.fit_hits_count;
+}
+
+bool allocator_test_utils::block_layout_info::operator!=(
+    allocator_test_utils::block_layout_info const &other) const noexcept
+{
+    return !(*this == other);
+}
+
+double allocator_test_utils::fragmentation_statistics::get_unusable_free_percentage() const noexcept
+{
+    return free_size == 0
+        ? 0
+        : 100.0 * unusable_free_size / free_size;
+}
+
+void allocator_test_utils::export_layout(
+    std::vector<block_layout_info> const &layout,
+    std::ostream &stream,
+    layout_format format)
+{
+    switch (format)
+    {
+        case layout_format::csv:
+            stream << layout_csv_header << '\n';
+            for (auto const &block: layout)
+            {
+                stream << block.block_offset << ','
+                    << block.block_size << ','
+                    << (block.is_block_occupied ? 1 : 0) << ','
+                    << block.fit_hits_count << '\n';
+            }
+            
+            break;
+        case layout_format::binary:
+            stream.write(layout_magic, sizeof(layout_magic));
+            write_uint(stream, layout_version, sizeof(uint32_t));
+            write_uint(stream, layout.size(), sizeof(uint64_t));
+            for (auto const &block: layout)
+            {
+                write_uint(stream, block.block_offset, sizeof(uint64_t));
+                write_uint(stream, block.block_size | (block.is_block_occupied ? occupied_flag : 0), sizeof(uint64_t));
+                write_uint(stream, block.fit_hits_count, sizeof(uint64_t));
+            }
+            
+            break;
+    }
+    
+    if (!stream)
+    {
+        throw std::runtime_error("can't write heap layout");
+    }
+}
+
+std::vector<allocator_test_utils::block_layout_info> allocator_test_utils::import_layout(
+    std::istream &stream)
+{
+    std::vector<block_layout_info> layout;
+    
+    if (stream.peek() == layout_magic[0])
+    {
+        char magic[sizeof(layout_magic)];
+        if (!stream.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), layout_magic))
+        {
+            throw std::runtime_error("heap layout has unknown format");
+        }
+        
+        if (read_uint(stream, sizeof(uint32_t)) != layout_version)
+        {
+            throw std::runtime_error("heap layout has unsupported version");
+        }
+        
+        uint64_t blocks_count = read_uint(stream, sizeof(uint64_t));
+        for (uint64_t i = 0; i < blocks_count; ++i)
+        {
+            block_layout_info block;
+            block.block_offset = read_uint(stream, sizeof(uint64_t));
+            uint64_t size_and_flag = read_uint(stream, sizeof(uint64_t));
+            block.block_size = size_and_flag & ~occupied_flag;
+            block.is_block_occupied = (size_and_flag & occupied_flag) != 0;
+            block.fit_hits_count = read_uint(stream, sizeof(uint64_t));
+            layout.push_back(block);
+        }
+        
+        return layout;
+    }
+    
+    std::string line;
+    if (!std::getline(stream, line) || line.compare(0, sizeof(layout_csv_header) - 1, layout_csv_header) != 0)
+    {
+        throw std::runtime_error("heap layout has unknown format");
+    }
+    
+    while (std::getline(stream, line))
+    {
+        if (line.empty() || line == "\r")
+        {
+            continue;
+        }
+        
+        block_layout_info block;
+        int is_block_occupied;
+        char separators[3];
+        std::istringstream line_stream(line);
+        if (!(line_stream >> block.block_offset >> separators[0] >> block.block_size >> separators[1] >> is_block_occupied >> separators[2] >> block.fit_hits_count)
+            || separators[0] != ',' || separators[1] != ',' || separators[2] != ',')
+        {
+            throw std::runtime_error("malformed heap layout line: " + line);
+        }
+        
+        block.is_block_occupied = is_block_occupied != 0;
+        layout.push_back(block);
+    }
+    
+    return layout;
+}
+
+allocator_test_utils::fragmentation_statistics allocator_test_utils::get_fragmentation_statistics(
+    std::vector<block_layout_info> const &layout,
+    size_t request_size)
+{
+    fragmentation_statistics statistics = { 0, 0, 0, 0, {}, request_size, 0 };
+    
+    for (auto const &block: layout)
+    {
+        statistics.total_size += block.block_size;
+        
+        if (block.is_block_occupied)
+        {
+            continue;
+        }
+        
+        statistics.free_size += block.block_size;
+        ++statistics.free_blocks_count;
+        statistics.largest_free_block_size = std::max(statistics.largest_free_block_size, block.block_size);
+        
+        size_t bucket = 1;
+        while (bucket <= block.block_size / 2)
+        {
+            bucket <<= 1;
+        }
+        ++statistics.free_blocks_sizes_histogram[block.block_size == 0 ? 0 : bucket];
+        
+        if (block.block_size < request_size)
+        {
+            statistics.unusable_free_size += block.block_size;
+        }
+    }
+    
+    return statistics;
 }
\ No newline at end of file
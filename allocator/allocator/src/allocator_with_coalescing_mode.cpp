@@ -0,0 +1,30 @@
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_WITH_COALESCING_MODE_USE_MADVISE
+#endif
+
+#include "../include/allocator_with_coalescing_mode.h"
+
+size_t allocator_with_coalescing_mode::release_pages(
+    void *block,
+    size_t block_size) noexcept
+{
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_WITH_COALESCING_MODE_USE_MADVISE
+    static uintptr_t const page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(block) + page_size - 1) / page_size * page_size;
+    uintptr_t end = (reinterpret_cast<uintptr_t>(block) + block_size) / page_size * page_size;
+    
+    if (begin >= end || madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED) != 0)
+    {
+        return 0;
+    }
+    
+    return end - begin;
+#else
+    return 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+#include "../include/allocator_with_snapshot.h"
+
+namespace
+{
+    
+    uint64_t const image_magic = 0x4d504f53414c4331ull;
+    
+    // 64 bit FNV-1a, stable across builds unlike std::hash
+    uint64_t get_image_type_tag(
+        std::string const &image_type) noexcept
+    {
+        uint64_t tag = 0xcbf29ce484222325ull;
+        for (auto symbol: image_type)
+        {
+            tag = (tag ^ static_cast<unsigned char>(symbol)) * 0x100000001b3ull;
+        }
+        
+        return tag;
+    }
+    
+    void write_all(
+        int fd,
+        void const *data,
+        size_t data_size)
+    {
+        auto const *current = reinterpret_cast<unsigned char const *>(data);
+        
+        while (data_size != 0)
+        {
+            ssize_t written = ::write(fd, current, data_size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                
+                throw std::system_error(errno, std::generic_category(), "allocator image write failed");
+            }
+            
+            current += written;
+            data_size -= written;
+        }
+    }
+    
+    void read_all(
+        int fd,
+        void *data,
+        size_t data_size)
+    {
+        auto *current = reinterpret_cast<unsigned char *>(data);
+        
+        while (data_size != 0)
+        {
+            ssize_t was_read = ::read(fd, current, data_size);
+            if (was_read < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                
+                throw std::system_error(errno, std::generic_category(), "allocator image read failed");
+            }
+            
+            if (was_read == 0)
+            {
+                throw std::runtime_error("allocator image is truncated");
+            }
+            
+            current += was_read;
+            data_size -= was_read;
+        }
+    }
+    
+}
+
+void allocator_with_snapshot::write_image(
+    int fd,
+    std::string const &image_type,
+    uint32_t image_version,
+    void const *image,
+    size_t image_size)
+{
+    uint64_t header[] = { image_magic, get_image_type_tag(image_type), image_version, image_size };
+    
+    write_all(fd, header, sizeof(header));
+    write_all(fd, image, image_size);
+}
+
+size_t allocator_with_snapshot::read_image_size(
+    int fd,
+    std::string const &image_type,
+    uint32_t image_version)
+{
+    uint64_t header[4];
+    
+    read_all(fd, header, sizeof(header));
+    if (header[0] != image_magic)
+    {
+        throw std::runtime_error("file descriptor does not point to an allocator image");
+    }
+    
+    if (header[1] != get_image_type_tag(image_type))
+    {
+        throw std::runtime_error("allocator image was written by another allocator type");
+    }
+    
+    if (header[2] != image_version)
+    {
+        throw std::runtime_error("allocator image layout version is not supported");
+    }
+    
+    return header[3];
+}
+
+void allocator_with_snapshot::read_image(
+    int fd,
+    void *image,
+    size_t image_size)
+{
+    read_all(fd, image, image_size);
+}
+
+void *allocator_with_snapshot::relocate(
+    void *pointer,
+    void const *old_base,
+    size_t image_size,
+    void *new_base) noexcept
+{
+    auto const *old_begin = reinterpret_cast<unsigned char const *>(old_base);
+    auto const *target = reinterpret_cast<unsigned char const *>(pointer);
+    
+    if (target < old_begin || target >= old_begin + image_size)
+    {
+        return pointer;
+    }
+    
+    return reinterpret_cast<unsigned char *>(new_base) + (target - old_begin);
+}
+
+size_t allocator_with_snapshot::get_image_offset(
+    void const *pointer,
+    void const *old_base,
+    size_t image_size) noexcept
+{
+    auto const *old_begin = reinterpret_cast<unsigned char const *>(old_base);
+    auto const *target = reinterpret_cast<unsigned char const *>(pointer);
+    
+    if (target < old_begin || target >= old_begin + image_size)
+    {
+        return image_size;
+    }
+    
+    return target - old_begin;
+}
\ No newline at end of file
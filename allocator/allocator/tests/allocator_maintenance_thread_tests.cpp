@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include <allocator_maintenance_thread.h>
+
+namespace
+{
+    
+    class coalescing_allocator_mock final:
+        public allocator_with_coalescing_mode
+    {
+    
+    public:
+        
+        std::atomic<size_t> coalesce_calls_count { 0 };
+        
+        std::atomic<size_t> trim_calls_count { 0 };
+        
+        bool is_failing = false;
+        
+        // keeps coalesce running until reset, so a test can act while a pass is in progress
+        std::atomic<bool> is_holding_pass { false };
+        
+        allocator_maintenance_thread *attached_thread = nullptr;
+    
+    public:
+        
+        void set_coalescing_mode(
+            coalescing_mode) override
+        {
+
+        }
+        
+        void coalesce() override
+        {
+            ++coalesce_calls_count;
+            while (is_holding_pass)
+            {
+                std::this_thread::yield();
+            }
+            
+            if (is_failing)
+            {
+                throw std::runtime_error("coalesce failed");
+            }
+        }
+        
+        void trim() override
+        {
+            ++trim_calls_count;
+        }
+        
+        size_t get_header_writes_count() const noexcept override
+        {
+            return 0;
+        }
+    
+    private:
+        
+        void set_maintenance_thread(
+            allocator_maintenance_thread *maintenance_thread) noexcept override
+        {
+            attached_thread = maintenance_thread;
+        }
+    
+    public:
+        
+        using allocator_with_coalescing_mode::release_pages;
+        
+    };
+    
+    void wait_for_passes(
+        allocator_maintenance_thread const &maintenance_thread,
+        uint64_t passes_count)
+    {
+        while (maintenance_thread.get_passes_count() < passes_count)
+        {
+            std::this_thread::yield();
+        }
+    }
+    
+}
+
+TEST(allocatorMaintenanceThreadPositiveTests, test1)
+{
+    coalescing_allocator_mock first_allocator;
+    coalescing_allocator_mock second_allocator;
+    second_allocator.is_failing = true;
+    
+    allocator_maintenance_thread maintenance_thread(std::chrono::hours(1));
+    maintenance_thread.attach(&first_allocator);
+    maintenance_thread.attach(&second_allocator);
+    maintenance_thread.attach(&first_allocator);
+    
+    ASSERT_EQ(first_allocator.attached_thread, &maintenance_thread);
+    
+    maintenance_thread.request_maintenance();
+    wait_for_passes(maintenance_thread, 1);
+    
+    ASSERT_EQ(first_allocator.coalesce_calls_count, 1);
+    ASSERT_EQ(first_allocator.trim_calls_count, 1);
+    ASSERT_EQ(second_allocator.coalesce_calls_count, 1);
+    ASSERT_EQ(second_allocator.trim_calls_count, 0);
+    
+    maintenance_thread.detach(&first_allocator);
+    maintenance_thread.request_maintenance();
+    wait_for_passes(maintenance_thread, 2);
+    
+    ASSERT_EQ(first_allocator.attached_thread, nullptr);
+    
+    ASSERT_EQ(first_allocator.coalesce_calls_count, 1);
+    ASSERT_EQ(second_allocator.coalesce_calls_count, 2);
+}
+
+TEST(allocatorMaintenanceThreadPositiveTests, test2)
+{
+    coalescing_allocator_mock target_allocator;
+    
+    allocator_maintenance_thread maintenance_thread(std::chrono::milliseconds(1));
+    maintenance_thread.attach(&target_allocator);
+    
+    wait_for_passes(maintenance_thread, 3);
+    maintenance_thread.detach(&target_allocator);
+    
+    ASSERT_GE(target_allocator.coalesce_calls_count, 3);
+}
+
+TEST(allocatorMaintenanceThreadPositiveTests, test3)
+{
+    size_t const block_size = 1 << 16;
+    std::unique_ptr<unsigned char[]> block(new unsigned char[block_size]);
+    std::memset(block.get(), 0xAB, block_size);
+    
+    size_t released_size = coalescing_allocator_mock::release_pages(block.get(), block_size);
+    
+    ASSERT_LE(released_size, block_size);
+    ASSERT_EQ(block[0], 0xAB);
+    ASSERT_EQ(block[block_size - 1], 0xAB);
+    
+    ASSERT_EQ(coalescing_allocator_mock::release_pages(block.get(), 16), 0);
+}
+
+TEST(allocatorMaintenanceThreadPositiveTests, test4)
+{
+    coalescing_allocator_mock held_allocator;
+    coalescing_allocator_mock attached_allocator;
+    held_allocator.is_holding_pass = true;
+    
+    allocator_maintenance_thread maintenance_thread(std::chrono::hours(1));
+    maintenance_thread.attach(&held_allocator);
+    maintenance_thread.request_maintenance();
+    while (held_allocator.coalesce_calls_count == 0)
+    {
+        std::this_thread::yield();
+    }
+    
+    // neither call waits for the running pass, which does not see the allocator attached in the middle of it
+    maintenance_thread.attach(&attached_allocator);
+    maintenance_thread.request_maintenance();
+    ASSERT_EQ(attached_allocator.coalesce_calls_count, 0);
+    
+    held_allocator.is_holding_pass = false;
+    wait_for_passes(maintenance_thread, 2);
+    maintenance_thread.detach(&held_allocator);
+    maintenance_thread.detach(&attached_allocator);
+    
+    ASSERT_EQ(held_allocator.coalesce_calls_count, 2);
+    ASSERT_EQ(attached_allocator.coalesce_calls_count, 1);
+}
+
+TEST(allocatorMaintenanceThreadPositiveTests, test5)
+{
+    coalescing_allocator_mock target_allocator;
+    
+    {
+        allocator_maintenance_thread maintenance_thread(std::chrono::hours(1));
+        maintenance_thread.attach(&target_allocator);
+    }
+    
+    // the allocator outlived the thread and must not detach from it any more
+    ASSERT_EQ(target_allocator.attached_thread, nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,671 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <allocator_boundary_tags.h>
+#include <allocator_buddies_system.h>
+#include <allocator_global_heap.h>
+#include <allocator_red_black_tree.h>
+#include <allocator_sorted_list.h>
+#include <allocator_synchronized.h>
+
+namespace
+{
+    
+    struct benchmark_settings final
+    {
+        
+        std::string allocator_name = "global_heap";
+        
+        std::string pattern_name = "all";
+        
+        unsigned max_threads_count = std::max(1u, std::thread::hardware_concurrency());
+        
+        size_t operations_per_thread = 1000000;
+        
+        size_t min_block_size = 8;
+        
+        size_t max_block_size = 256;
+        
+        size_t live_blocks_per_thread = 1000;
+        
+        size_t arena_size = size_t(1) << 26;
+        
+    };
+    
+    struct benchmark_result final
+    {
+        
+        uint64_t operations_count;
+        
+        double seconds;
+        
+    };
+    
+    // allocator under test together with everything it owns
+    struct benchmark_subject final
+    {
+        
+        std::unique_ptr<allocator> target_allocator;
+        
+        std::unique_ptr<allocator_synchronized> synchronized_allocator;
+        
+        allocator *get() const noexcept
+        {
+            return synchronized_allocator == nullptr
+                ? target_allocator.get()
+                : synchronized_allocator.get();
+        }
+        
+    };
+    
+    benchmark_subject create_subject(
+        benchmark_settings const &settings)
+    {
+        benchmark_subject subject;
+        bool is_thread_safe = false;
+        
+        if (settings.allocator_name == "global_heap")
+        {
+            subject.target_allocator.reset(new allocator_global_heap(nullptr, true));
+            is_thread_safe = true;
+        }
+        else if (settings.allocator_name == "global_heap_uncached")
+        {
+            subject.target_allocator.reset(new allocator_global_heap(nullptr, false));
+            is_thread_safe = true;
+        }
+        else if (settings.allocator_name == "sorted_list")
+        {
+            subject.target_allocator.reset(new allocator_sorted_list(settings.arena_size));
+        }
+        else if (settings.allocator_name == "boundary_tags")
+        {
+            subject.target_allocator.reset(new allocator_boundary_tags(settings.arena_size));
+        }
+        else if (settings.allocator_name == "buddies_system")
+        {
+            subject.target_allocator.reset(new allocator_buddies_system(allocator_buddies_system::space_size_in_bytes { settings.arena_size }));
+        }
+        else if (settings.allocator_name == "red_black_tree")
+        {
+            subject.target_allocator.reset(new allocator_red_black_tree(settings.arena_size));
+        }
+        else
+        {
+            throw std::invalid_argument("unknown allocator: " + settings.allocator_name);
+        }
+        
+        if (!is_thread_safe)
+        {
+            subject.synchronized_allocator.reset(new allocator_synchronized(subject.target_allocator.get()));
+        }
+        
+        return subject;
+    }
+    
+    class block_size_generator final
+    {
+    
+    private:
+        
+        std::mt19937_64 _engine;
+        
+        std::uniform_int_distribution<size_t> _distribution;
+    
+    public:
+        
+        block_size_generator(
+            benchmark_settings const &settings,
+            unsigned seed):
+            _engine(seed),
+            _distribution(settings.min_block_size, settings.max_block_size)
+        {
+            
+        }
+        
+        size_t operator()()
+        {
+            return _distribution(_engine);
+        }
+        
+    };
+    
+    // the first exception thrown by any worker thread; an exception escaping a thread function
+    // would call std::terminate, so workers park it here and the caller rethrows it after joining
+    class worker_failure final
+    {
+    
+    private:
+        
+        std::exception_ptr _exception;
+        
+        std::mutex _mutex;
+        
+        std::atomic<bool> _is_raised;
+    
+    public:
+        
+        worker_failure() noexcept:
+            _is_raised(false)
+        {
+
+        }
+    
+    public:
+        
+        void raise(
+            std::exception_ptr exception) noexcept
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_exception == nullptr)
+            {
+                _exception = exception;
+            }
+            
+            _is_raised.store(true, std::memory_order_release);
+        }
+        
+        // lets the other workers stop early instead of finishing a run that is going to be discarded
+        bool is_raised() const noexcept
+        {
+            return _is_raised.load(std::memory_order_acquire);
+        }
+        
+        void rethrow_if_raised()
+        {
+            if (_exception != nullptr)
+            {
+                std::rethrow_exception(_exception);
+            }
+        }
+        
+    };
+    
+    // every thread owns a window of live blocks and replaces a random one on each step
+    benchmark_result run_thread_private_churn(
+        allocator *subject,
+        benchmark_settings const &settings,
+        unsigned threads_count)
+    {
+        std::atomic<uint64_t> operations_count(0);
+        worker_failure failure;
+        std::vector<std::thread> threads;
+        
+        auto started_at = std::chrono::steady_clock::now();
+        
+        for (unsigned i = 0; i < threads_count; ++i)
+        {
+            threads.emplace_back([&, i]()
+            {
+                block_size_generator next_block_size(settings, i);
+                std::mt19937 engine(i);
+                std::vector<void *> live_blocks(settings.live_blocks_per_thread, nullptr);
+                uint64_t thread_operations_count = 0;
+                
+                try
+                {
+                    for (size_t j = 0; j < settings.operations_per_thread && !failure.is_raised(); ++j)
+                    {
+                        void *&slot = live_blocks[engine() % live_blocks.size()];
+                        if (slot != nullptr)
+                        {
+                            subject->deallocate(slot);
+                            slot = nullptr;
+                            ++thread_operations_count;
+                        }
+                        
+                        slot = subject->allocate(1, next_block_size());
+                        ++thread_operations_count;
+                    }
+                }
+                catch (...)
+                {
+                    failure.raise(std::current_exception());
+                }
+                
+                for (auto block: live_blocks)
+                {
+                    if (block != nullptr)
+                    {
+                        subject->deallocate(block);
+                        ++thread_operations_count;
+                    }
+                }
+                
+                operations_count += thread_operations_count;
+            });
+        }
+        
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+        
+        failure.rethrow_if_raised();
+        
+        return { operations_count, std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at).count() };
+    }
+    
+    // half of the threads allocate and publish blocks to a shared bounded queue, the other half frees them;
+    // needs at least two threads, so the thread counts measured for this pattern start from 2
+    benchmark_result run_producer_consumer(
+        allocator *subject,
+        benchmark_settings const &settings,
+        unsigned threads_count)
+    {
+        if (threads_count < 2)
+        {
+            throw std::invalid_argument("producer_consumer needs at least one producer and one consumer thread");
+        }
+        
+        unsigned producers_count = threads_count / 2;
+        unsigned consumers_count = threads_count - producers_count;
+        size_t const queue_capacity = settings.live_blocks_per_thread * producers_count;
+        
+        std::deque<void *> queue;
+        std::mutex queue_mutex;
+        std::condition_variable queue_not_empty;
+        std::condition_variable queue_not_full;
+        unsigned producers_left = producers_count;
+        std::atomic<uint64_t> operations_count(0);
+        worker_failure failure;
+        std::vector<std::thread> threads;
+        
+        auto started_at = std::chrono::steady_clock::now();
+        
+        for (unsigned i = 0; i < producers_count; ++i)
+        {
+            threads.emplace_back([&, i]()
+            {
+                block_size_generator next_block_size(settings, i);
+                uint64_t thread_operations_count = 0;
+                
+                try
+                {
+                    for (size_t j = 0; j < settings.operations_per_thread; ++j)
+                    {
+                        void *block = subject->allocate(1, next_block_size());
+                        ++thread_operations_count;
+                        
+                        std::unique_lock<std::mutex> lock(queue_mutex);
+                        queue_not_full.wait(lock, [&]() { return queue.size() < queue_capacity || failure.is_raised(); });
+                        queue.push_back(block);
+                        lock.unlock();
+                        queue_not_empty.notify_one();
+                        
+                        if (failure.is_raised())
+                        {
+                            break;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    failure.raise(std::current_exception());
+                }
+                
+                operations_count += thread_operations_count;
+                
+                // consumers drain the queue until the last producer leaves, even after a failure
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                --producers_left;
+                queue_not_empty.notify_all();
+            });
+        }
+        
+        for (unsigned i = 0; i < consumers_count; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                uint64_t thread_operations_count = 0;
+                
+                while (true)
+                {
+                    std::unique_lock<std::mutex> lock(queue_mutex);
+                    queue_not_empty.wait(lock, [&]() { return !queue.empty() || producers_left == 0; });
+                    if (queue.empty())
+                    {
+                        break;
+                    }
+                    
+                    void *block = queue.front();
+                    queue.pop_front();
+                    lock.unlock();
+                    queue_not_full.notify_one();
+                    
+                    try
+                    {
+                        subject->deallocate(block);
+                    }
+                    catch (...)
+                    {
+                        failure.raise(std::current_exception());
+                        
+                        // wakes the producers blocked on a full queue so they can leave
+                        std::lock_guard<std::mutex> failure_lock(queue_mutex);
+                        queue_not_full.notify_all();
+                        
+                        break;
+                    }
+                    ++thread_operations_count;
+                }
+                
+                operations_count += thread_operations_count;
+            });
+        }
+        
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+        
+        // left behind only when every consumer has failed
+        for (auto block: queue)
+        {
+            subject->deallocate(block);
+        }
+        
+        failure.rethrow_if_raised();
+        
+        return { operations_count, std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at).count() };
+    }
+    
+    // threads form a ring: each allocates a batch, hands it to its neighbour and frees what it got from the other side
+    benchmark_result run_cross_thread_free(
+        allocator *subject,
+        benchmark_settings const &settings,
+        unsigned threads_count)
+    {
+        struct mailbox final
+        {
+            
+            std::mutex mutex;
+            
+            std::vector<void *> blocks;
+            
+        };
+        
+        size_t const batch_size = std::max<size_t>(1, settings.live_blocks_per_thread / 10);
+        std::vector<mailbox> mailboxes(threads_count);
+        std::atomic<uint64_t> operations_count(0);
+        worker_failure failure;
+        std::vector<std::thread> threads;
+        
+        auto started_at = std::chrono::steady_clock::now();
+        
+        for (unsigned i = 0; i < threads_count; ++i)
+        {
+            threads.emplace_back([&, i]()
+            {
+                block_size_generator next_block_size(settings, i);
+                mailbox &outgoing = mailboxes[(i + 1) % threads_count];
+                mailbox &incoming = mailboxes[i];
+                std::vector<void *> batch;
+                std::vector<void *> received;
+                uint64_t thread_operations_count = 0;
+                
+                try
+                {
+                    for (size_t j = 0; j < settings.operations_per_thread && !failure.is_raised(); j += batch_size)
+                    {
+                        batch.clear();
+                        for (size_t k = 0; k < batch_size; ++k)
+                        {
+                            batch.push_back(subject->allocate(1, next_block_size()));
+                        }
+                        thread_operations_count += batch.size();
+                        
+                        {
+                            std::lock_guard<std::mutex> lock(outgoing.mutex);
+                            outgoing.blocks.insert(outgoing.blocks.end(), batch.begin(), batch.end());
+                        }
+                        batch.clear();
+                        
+                        {
+                            std::lock_guard<std::mutex> lock(incoming.mutex);
+                            received.swap(incoming.blocks);
+                        }
+                        
+                        for (auto block: received)
+                        {
+                            subject->deallocate(block);
+                        }
+                        thread_operations_count += received.size();
+                        received.clear();
+                    }
+                }
+                catch (...)
+                {
+                    failure.raise(std::current_exception());
+                    
+                    // the unsent part of a batch is not reachable from any mailbox
+                    for (auto block: batch)
+                    {
+                        subject->deallocate(block);
+                    }
+                }
+                
+                operations_count += thread_operations_count;
+            });
+        }
+        
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+        
+        for (auto &box: mailboxes)
+        {
+            for (auto block: box.blocks)
+            {
+                subject->deallocate(block);
+            }
+            operations_count += box.blocks.size();
+        }
+        
+        failure.rethrow_if_raised();
+        
+        return { operations_count, std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at).count() };
+    }
+    
+    void print_usage(
+        char const *program_name)
+    {
+        std::cout << "usage: " << program_name << " [options]" << std::endl
+            << "  --allocator <global_heap|global_heap_uncached|sorted_list|boundary_tags|buddies_system|red_black_tree>" << std::endl
+            << "  --pattern <churn|producer_consumer|cross_thread_free|all>" << std::endl
+            << "  --max-threads <count>         thread counts 1, 2, 4, ... up to this value are measured;" << std::endl
+            << "                                producer_consumer splits them into producers and consumers and starts from 2" << std::endl
+            << "  --operations <count>          allocations per thread" << std::endl
+            << "  --min-block-size <bytes>" << std::endl
+            << "  --max-block-size <bytes>" << std::endl
+            << "  --live-blocks <count>         live blocks window per thread" << std::endl
+            << "  --arena-size <bytes>          trusted memory size of arena allocators" << std::endl;
+    }
+    
+    benchmark_settings parse_settings(
+        int argc,
+        char *argv[])
+    {
+        benchmark_settings settings;
+        
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string option = argv[i];
+            if (option == "--help")
+            {
+                print_usage(argv[0]);
+                std::exit(0);
+            }
+            
+            if (i + 1 == argc)
+            {
+                throw std::invalid_argument("missing value for " + option);
+            }
+            
+            std::string value = argv[++i];
+            
+            if (option == "--allocator")
+            {
+                settings.allocator_name = value;
+            }
+            else if (option == "--pattern")
+            {
+                settings.pattern_name = value;
+            }
+            else if (option == "--max-threads")
+            {
+                settings.max_threads_count = static_cast<unsigned>(std::stoul(value));
+            }
+            else if (option == "--operations")
+            {
+                settings.operations_per_thread = std::stoull(value);
+            }
+            else if (option == "--min-block-size")
+            {
+                settings.min_block_size = std::stoull(value);
+            }
+            else if (option == "--max-block-size")
+            {
+                settings.max_block_size = std::stoull(value);
+            }
+            else if (option == "--live-blocks")
+            {
+                settings.live_blocks_per_thread = std::stoull(value);
+            }
+            else if (option == "--arena-size")
+            {
+                settings.arena_size = std::stoull(value);
+            }
+            else
+            {
+                throw std::invalid_argument("unknown option: " + option);
+            }
+        }
+        
+        if (settings.max_threads_count == 0 || settings.live_blocks_per_thread == 0 || settings.min_block_size > settings.max_block_size)
+        {
+            throw std::invalid_argument("inconsistent benchmark settings");
+        }
+        
+        return settings;
+    }
+    
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    benchmark_settings settings;
+    
+    try
+    {
+        settings = parse_settings(argc, argv);
+    }
+    catch (std::exception const &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        print_usage(argv[0]);
+        
+        return 1;
+    }
+    
+    struct benchmark_pattern final
+    {
+        
+        std::string name;
+        
+        std::function<benchmark_result(allocator *, benchmark_settings const &, unsigned)> run;
+        
+        unsigned min_threads_count;
+        
+    };
+    
+    std::vector<benchmark_pattern> patterns
+        {
+            { "churn", run_thread_private_churn, 1 },
+            { "producer_consumer", run_producer_consumer, 2 },
+            { "cross_thread_free", run_cross_thread_free, 1 }
+        };
+    
+    for (auto const &pattern: patterns)
+    {
+        if (settings.pattern_name == pattern.name && settings.max_threads_count < pattern.min_threads_count)
+        {
+            std::cerr << pattern.name << " needs --max-threads " << pattern.min_threads_count << " or more" << std::endl;
+            
+            return 1;
+        }
+    }
+    
+    std::cout << std::left
+        << std::setw(20) << "pattern"
+        << std::setw(10) << "threads"
+        << std::setw(16) << "ops/sec"
+        << std::setw(18) << "lock wait, ms"
+        << "contended locks" << std::endl;
+    
+    for (auto const &pattern: patterns)
+    {
+        if (settings.pattern_name != "all" && settings.pattern_name != pattern.name)
+        {
+            continue;
+        }
+        
+        for (unsigned threads_count = pattern.min_threads_count; threads_count <= settings.max_threads_count; threads_count *= 2)
+        {
+            try
+            {
+                benchmark_subject subject = create_subject(settings);
+                benchmark_result result = pattern.run(subject.get(), settings, threads_count);
+                
+                std::cout << std::left
+                    << std::setw(20) << pattern.name
+                    << std::setw(10) << threads_count
+                    << std::setw(16) << std::fixed << std::setprecision(0) << result.operations_count / result.seconds;
+                
+                if (subject.synchronized_allocator != nullptr)
+                {
+                    std::cout << std::setw(18) << std::setprecision(3) << subject.synchronized_allocator->get_lock_wait_nanoseconds() / 1e6
+                        << subject.synchronized_allocator->get_contended_lock_acquisitions() << '/' << subject.synchronized_allocator->get_lock_acquisitions();
+                }
+                else
+                {
+                    std::cout << std::setw(18) << "-" << "-";
+                }
+                
+                std::cout << std::endl;
+            }
+            catch (std::logic_error const &ex)
+            {
+                std::cerr << settings.allocator_name << " is not available: " << ex.what() << std::endl;
+                
+                return 1;
+            }
+            catch (std::bad_alloc const &)
+            {
+                std::cerr << settings.allocator_name << " ran out of memory, try a bigger --arena-size" << std::endl;
+                
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <allocator_boundary_tags.h>
+#include <allocator_sorted_list.h>
+
+namespace
+{
+    
+    size_t const sizes[] = { 24, 40, 64, 100, 200 };
+    
+    size_t const sizes_count = sizeof(sizes) / sizeof(sizes[0]);
+    
+    struct churn_step final
+    {
+        
+        size_t slot;
+        
+        size_t size;
+        
+    };
+    
+    // every step releases a live block and requests a block of a random size class right away;
+    // a block that always came back with its own size would settle into an exactly fitting hole
+    // after a few steps, so the sizes change to keep the freed block merged with its free neighbours
+    // only to be split again under immediate coalescing
+    std::vector<churn_step> build_churn_trace(
+        size_t slots_count,
+        size_t steps_count)
+    {
+        std::mt19937_64 engine(42);
+        std::uniform_int_distribution<size_t> slot_distribution(0, slots_count - 1);
+        std::uniform_int_distribution<size_t> size_distribution(0, sizes_count - 1);
+        
+        std::vector<churn_step> trace(steps_count);
+        for (auto &step: trace)
+        {
+            step.slot = slot_distribution(engine);
+            step.size = sizes[size_distribution(engine)];
+        }
+        
+        return trace;
+    }
+    
+    struct churn_result final
+    {
+        
+        double ns_per_step;
+        
+        double header_writes_per_step;
+        
+    };
+    
+    template<
+        typename tallocator>
+    churn_result run_churn(
+        std::vector<churn_step> const &trace,
+        size_t slots_count,
+        size_t arena_size,
+        allocator_with_coalescing_mode::coalescing_mode mode)
+    {
+        tallocator subject(arena_size, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit, mode);
+        
+        // a released spacer after every live block gives it a free neighbour to merge with
+        std::vector<void *> slots(slots_count);
+        std::vector<void *> spacers(slots_count);
+        for (size_t i = 0; i < slots_count; ++i)
+        {
+            slots[i] = subject.allocate(1, sizes[i % sizes_count]);
+            spacers[i] = subject.allocate(1, 32);
+        }
+        
+        for (auto spacer: spacers)
+        {
+            subject.deallocate(spacer);
+        }
+        
+        size_t header_writes_before = subject.get_header_writes_count();
+        auto started_at = std::chrono::steady_clock::now();
+        for (auto const &step: trace)
+        {
+            subject.deallocate(slots[step.slot]);
+            slots[step.slot] = subject.allocate(1, step.size);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - started_at;
+        size_t header_writes = subject.get_header_writes_count() - header_writes_before;
+        
+        for (auto slot: slots)
+        {
+            subject.deallocate(slot);
+        }
+        
+        return
+        {
+            std::chrono::duration<double, std::nano>(elapsed).count() / trace.size(),
+            static_cast<double>(header_writes) / trace.size()
+        };
+    }
+    
+    template<
+        typename tallocator>
+    void report(
+        std::string const &allocator_name,
+        std::vector<churn_step> const &trace,
+        size_t slots_count,
+        size_t arena_size)
+    {
+        churn_result immediate = run_churn<tallocator>(trace, slots_count, arena_size, allocator_with_coalescing_mode::coalescing_mode::immediate);
+        churn_result deferred = run_churn<tallocator>(trace, slots_count, arena_size, allocator_with_coalescing_mode::coalescing_mode::deferred);
+        
+        std::cout << "  " << std::left << std::setw(16) << allocator_name << std::right
+            << " immediate: " << std::setw(8) << immediate.ns_per_step << " ns/step " << std::setw(5) << immediate.header_writes_per_step << " header writes/step"
+            << "   deferred: " << std::setw(8) << deferred.ns_per_step << " ns/step " << std::setw(5) << deferred.header_writes_per_step << " header writes/step" << std::endl;
+    }
+    
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t slots_count = argc > 1
+        ? std::stoull(argv[1])
+        : 256;
+    size_t steps_count = argc > 2
+        ? std::stoull(argv[2])
+        : 1000000;
+    size_t const arena_size = slots_count * 1024;
+    
+    auto trace = build_churn_trace(slots_count, steps_count);
+    
+    std::cout << steps_count << " free/allocate steps over " << slots_count << " live blocks" << std::endl
+        << std::fixed << std::setprecision(1);
+    report<allocator_sorted_list>("sorted_list", trace, slots_count, arena_size);
+    report<allocator_boundary_tags>("boundary_tags", trace, slots_count, arena_size);
+    
+    return 0;
+}
\ No newline at end of file
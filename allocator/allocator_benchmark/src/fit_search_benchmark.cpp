@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <allocator_boundary_tags.h>
+#include <allocator_sorted_list.h>
+
+namespace
+{
+    
+    size_t const hole_size = 16;
+    
+    // a hole can't serve it, so every search walks the whole free list down to the trailing block
+    size_t const probe_size = 256;
+    
+    // holes_count holes separated by occupied blocks, released either in random order, so a free list
+    // kept in release order points all over the arena, or from the last one, which keeps an address ordered insert O(1)
+    template<
+        typename tallocator>
+    double run_fit_search(
+        size_t holes_count,
+        size_t probes_count,
+        allocator_with_fit_mode::fit_mode mode,
+        bool is_release_order_random)
+    {
+        tallocator subject(holes_count * 256 + (probe_size + 256) * 2, nullptr, nullptr, mode);
+        
+        std::vector<void *> holes(holes_count);
+        std::vector<void *> separators(holes_count);
+        for (size_t i = 0; i < holes_count; ++i)
+        {
+            holes[i] = subject.allocate(1, hole_size);
+            separators[i] = subject.allocate(1, hole_size);
+        }
+        
+        if (is_release_order_random)
+        {
+            std::shuffle(holes.begin(), holes.end(), std::mt19937_64(42));
+        }
+        else
+        {
+            std::reverse(holes.begin(), holes.end());
+        }
+        
+        for (auto hole: holes)
+        {
+            subject.deallocate(hole);
+        }
+        
+        // only the allocation is timed: the sorted list walks its free list on deallocate too
+        std::chrono::steady_clock::duration elapsed(0);
+        for (size_t i = 0; i < probes_count; ++i)
+        {
+            auto started_at = std::chrono::steady_clock::now();
+            void *probe = subject.allocate(1, probe_size);
+            elapsed += std::chrono::steady_clock::now() - started_at;
+            
+            subject.deallocate(probe);
+        }
+        
+        for (auto separator: separators)
+        {
+            subject.deallocate(separator);
+        }
+        
+        return std::chrono::duration<double, std::micro>(elapsed).count() / probes_count;
+    }
+    
+    template<
+        typename tallocator>
+    void report(
+        std::string const &allocator_name,
+        size_t holes_count,
+        size_t probes_count,
+        bool is_release_order_random)
+    {
+        std::cout << "  " << std::left << std::setw(28) << allocator_name << std::right
+            << " first fit: " << std::setw(8) << run_fit_search<tallocator>(holes_count, probes_count, allocator_with_fit_mode::fit_mode::first_fit, is_release_order_random) << " us"
+            << "   best fit: " << std::setw(8) << run_fit_search<tallocator>(holes_count, probes_count, allocator_with_fit_mode::fit_mode::the_best_fit, is_release_order_random) << " us"
+            << std::endl;
+    }
+    
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t holes_count = argc > 1
+        ? std::stoull(argv[1])
+        : 200000;
+    size_t probes_count = argc > 2
+        ? std::stoull(argv[2])
+        : 50;
+    
+    std::cout << "missing search over " << holes_count << " free blocks, per request" << std::endl
+        << std::fixed << std::setprecision(1);
+    // the sorted list keeps its free list address ordered whatever the release order, boundary tags keeps the release order
+    report<allocator_sorted_list>("sorted_list", holes_count, probes_count, false);
+    report<allocator_boundary_tags>("boundary_tags", holes_count, probes_count, false);
+    report<allocator_boundary_tags>("boundary_tags, random order", holes_count, probes_count, true);
+    
+    return 0;
+}
\ No newline at end of file
@@ -1,80 +1,851 @@
-#include <not_implemented.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <allocator_maintenance_thread.h>
 
 #include "../include/allocator_boundary_tags.h"
 
+namespace
+{
+    
+    enum class block_state:
+        uint32_t
+    {
+        free,
+        // freed in deferred coalescing mode, waits for the sweep in the parked list
+        parked,
+        occupied
+    };
+    
+    struct block_header final
+    {
+        
+        // header and footer included
+        size_t block_size;
+        
+        uint32_t fit_hits_count;
+        
+        block_state state;
+        
+    };
+    
+    // lives in the first payload bytes of a free or parked block, the parked list uses next only
+    struct free_block_links final
+    {
+        
+        block_header *previous;
+        
+        block_header *next;
+        
+    };
+    
+    // the last bytes of every block repeat its size, so the previous block is reachable in O(1)
+    struct block_footer final
+    {
+        
+        size_t block_size;
+        
+    };
+    
+    struct allocator_metadata final
+    {
+        
+        void *trusted_memory;
+        
+        allocator *parent_allocator;
+        
+        logger *target_logger;
+        
+        // blocks area only, metadata excluded
+        size_t space_size;
+        
+        allocator_with_fit_mode::fit_mode fit_mode;
+        
+        allocator_with_coalescing_mode::coalescing_mode coalescing_mode;
+        
+        std::mutex mutex;
+        
+        // not address ordered: freed blocks are pushed to the front
+        block_header *first_free_block;
+        
+        block_header *first_parked_block;
+        
+        size_t parked_blocks_count;
+        
+        // size tag writes of the constructor, splits and merges, header and footer count as one
+        size_t header_writes_count;
+        
+    };
+    
+    // bumped on every change of the metadata or block layout, snapshots of another layout are refused
+    constexpr uint32_t image_version = 1;
+    
+    constexpr size_t block_alignment = alignof(std::max_align_t);
+    
+    constexpr size_t align_up(
+        size_t value) noexcept
+    {
+        return (value + block_alignment - 1) / block_alignment * block_alignment;
+    }
+    
+    constexpr size_t metadata_size = align_up(sizeof(allocator_metadata));
+    
+    constexpr size_t block_header_size = align_up(sizeof(block_header));
+    
+    constexpr size_t min_block_size = align_up(block_header_size + sizeof(free_block_links) + sizeof(block_footer));
+    
+    inline allocator_metadata &get_metadata(
+        void *trusted_memory) noexcept
+    {
+        return *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    }
+    
+    inline block_header *get_first_block(
+        void *trusted_memory) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(trusted_memory) + metadata_size);
+    }
+    
+    inline void *get_blocks_end(
+        void *trusted_memory) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(trusted_memory) + metadata_size + get_metadata(trusted_memory).space_size;
+    }
+    
+    inline block_header *get_next_block(
+        block_header *block) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(block) + block->block_size);
+    }
+    
+    inline block_footer &get_footer(
+        block_header *block) noexcept
+    {
+        return *reinterpret_cast<block_footer *>(reinterpret_cast<unsigned char *>(block) + block->block_size - sizeof(block_footer));
+    }
+    
+    // the block must not be the first one
+    inline block_header *get_previous_block(
+        block_header *block) noexcept
+    {
+        size_t previous_block_size = reinterpret_cast<block_footer *>(block)[-1].block_size;
+        
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(block) - previous_block_size);
+    }
+    
+    inline free_block_links &get_links(
+        block_header *block) noexcept
+    {
+        return *reinterpret_cast<free_block_links *>(reinterpret_cast<unsigned char *>(block) + block_header_size);
+    }
+    
+    inline void *get_payload(
+        block_header *block) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(block) + block_header_size;
+    }
+    
+    inline block_header *get_block(
+        void *payload) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(payload) - block_header_size);
+    }
+    
+    inline void set_block_size(
+        allocator_metadata &metadata,
+        block_header *block,
+        size_t block_size) noexcept
+    {
+        ++metadata.header_writes_count;
+        block->block_size = block_size;
+        get_footer(block).block_size = block_size;
+    }
+    
+    inline void push_free_block(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        block->state = block_state::free;
+        get_links(block) = { nullptr, metadata.first_free_block };
+        if (metadata.first_free_block != nullptr)
+        {
+            get_links(metadata.first_free_block).previous = block;
+        }
+        
+        metadata.first_free_block = block;
+    }
+    
+    inline void unlink_free_block(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        free_block_links &links = get_links(block);
+        
+        (links.previous == nullptr
+            ? metadata.first_free_block
+            : get_links(links.previous).next) = links.next;
+        if (links.next != nullptr)
+        {
+            get_links(links.next).previous = links.previous;
+        }
+    }
+    
+    // one address ordered pass: every run of adjacent free and parked blocks becomes one free block,
+    // the free list is relinked in address order and the parked list gets empty
+    void merge_free_blocks(
+        void *trusted_memory) noexcept
+    {
+        allocator_metadata &metadata = get_metadata(trusted_memory);
+        void *blocks_end = get_blocks_end(trusted_memory);
+        block_header *last_free_block = nullptr;
+        block_header *run = nullptr;
+        
+        metadata.first_free_block = nullptr;
+        
+        for (block_header *block = get_first_block(trusted_memory); block != blocks_end; block = get_next_block(block))
+        {
+            if (block->state == block_state::occupied)
+            {
+                run = nullptr;
+                
+                continue;
+            }
+            
+            if (run != nullptr)
+            {
+                set_block_size(metadata, run, run->block_size + block->block_size);
+                block = run;
+                
+                continue;
+            }
+            
+            run = block;
+            run->state = block_state::free;
+            get_links(run) = { last_free_block, nullptr };
+            (last_free_block == nullptr
+                ? metadata.first_free_block
+                : get_links(last_free_block).next) = run;
+            last_free_block = run;
+        }
+        
+        metadata.first_parked_block = nullptr;
+        metadata.parked_blocks_count = 0;
+    }
+    
+    block_header *find_free_block(
+        allocator_metadata const &metadata,
+        size_t block_size) noexcept
+    {
+        block_header *found = nullptr;
+        
+        for (block_header *block = metadata.first_free_block; block != nullptr; block = get_links(block).next)
+        {
+            if (block->block_size < block_size)
+            {
+                continue;
+            }
+            
+            if (found == nullptr
+                || (metadata.fit_mode == allocator_with_fit_mode::fit_mode::the_best_fit && block->block_size < found->block_size)
+                || (metadata.fit_mode == allocator_with_fit_mode::fit_mode::the_worst_fit && block->block_size > found->block_size))
+            {
+                found = block;
+                
+                if (metadata.fit_mode == allocator_with_fit_mode::fit_mode::first_fit
+                    || (metadata.fit_mode == allocator_with_fit_mode::fit_mode::the_best_fit && block->block_size == block_size))
+                {
+                    break;
+                }
+            }
+        }
+        
+        return found;
+    }
+    
+    // parked blocks are reused only by a request of their own size, so a miss here never splits anything
+    block_header *take_parked_block(
+        allocator_metadata &metadata,
+        size_t block_size) noexcept
+    {
+        for (block_header **link = &metadata.first_parked_block; *link != nullptr; link = &get_links(*link).next)
+        {
+            block_header *block = *link;
+            if (block->block_size >= block_size && block->block_size < block_size + min_block_size)
+            {
+                *link = get_links(block).next;
+                --metadata.parked_blocks_count;
+                
+                return block;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+}
+
 allocator_boundary_tags::~allocator_boundary_tags()
 {
-    throw not_implemented("allocator_boundary_tags::~allocator_boundary_tags()", "your code should be here...");
+    // a moved from allocator is still attached, so this goes before the memory check
+    allocator_maintenance_thread *maintenance_thread = _maintenance_thread.load(std::memory_order_acquire);
+    if (maintenance_thread != nullptr)
+    {
+        maintenance_thread->detach(this);
+    }
+    
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    get_metadata(_trusted_memory).mutex.~mutex();
+    deallocate_with_guard(_trusted_memory);
 }
 
 allocator_boundary_tags::allocator_boundary_tags(
-    allocator_boundary_tags const &other)
+    allocator_boundary_tags const &other):
+    _trusted_memory(nullptr),
+    _maintenance_thread(nullptr)
 {
-    throw not_implemented("allocator_boundary_tags::allocator_boundary_tags(allocator_boundary_tags const &)", "your code should be here...");
+    if (other._trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &other_metadata = get_metadata(other._trusted_memory);
+    size_t image_size = metadata_size + other_metadata.space_size;
+    
+    _trusted_memory = other_metadata.parent_allocator == nullptr
+        ? ::operator new(image_size)
+        : other_metadata.parent_allocator->allocate(1, image_size);
+    
+    {
+        std::lock_guard<std::mutex> lock(other_metadata.mutex);
+        std::memcpy(_trusted_memory, other._trusted_memory, image_size);
+    }
+    
+    rebase_image(_trusted_memory);
 }
 
 allocator_boundary_tags &allocator_boundary_tags::operator=(
     allocator_boundary_tags const &other)
 {
-    throw not_implemented("allocator_boundary_tags &allocator_boundary_tags::operator=(allocator_boundary_tags const &)", "your code should be here...");
+    if (this != &other)
+    {
+        allocator_boundary_tags copy(other);
+        std::swap(_trusted_memory, copy._trusted_memory);
+    }
+    
+    return *this;
 }
 
 allocator_boundary_tags::allocator_boundary_tags(
-    allocator_boundary_tags &&other) noexcept
+    allocator_boundary_tags &&other) noexcept:
+    _trusted_memory(other._trusted_memory),
+    _maintenance_thread(nullptr)
 {
-    throw not_implemented("allocator_boundary_tags::allocator_boundary_tags(allocator_boundary_tags &&) noexcept", "your code should be here...");
+    other._trusted_memory = nullptr;
 }
 
 allocator_boundary_tags &allocator_boundary_tags::operator=(
     allocator_boundary_tags &&other) noexcept
 {
-    throw not_implemented("allocator_boundary_tags &allocator_boundary_tags::operator=(allocator_boundary_tags &&) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        std::swap(_trusted_memory, other._trusted_memory);
+    }
+    
+    return *this;
 }
 
 allocator_boundary_tags::allocator_boundary_tags(
     size_t space_size,
     allocator *parent_allocator,
     logger *logger,
-    allocator_with_fit_mode::fit_mode allocate_fit_mode)
+    allocator_with_fit_mode::fit_mode allocate_fit_mode,
+    allocator_with_coalescing_mode::coalescing_mode deallocate_coalescing_mode):
+    _maintenance_thread(nullptr)
 {
-    throw not_implemented("allocator_boundary_tags::allocator_boundary_tags(size_t, allocator *, logger *, allocator_with_fit_mode::fit_mode)", "your code should be here...");
+    space_size = space_size / block_alignment * block_alignment;
+    if (space_size < min_block_size)
+    {
+        throw std::logic_error("allocator_boundary_tags: space size can't hold a single block");
+    }
+    
+    _trusted_memory = parent_allocator == nullptr
+        ? ::operator new(metadata_size + space_size)
+        : parent_allocator->allocate(1, metadata_size + space_size);
+    
+    allocator_metadata &metadata = *new (_trusted_memory) allocator_metadata;
+    metadata.trusted_memory = _trusted_memory;
+    metadata.parent_allocator = parent_allocator;
+    metadata.target_logger = logger;
+    metadata.space_size = space_size;
+    metadata.fit_mode = allocate_fit_mode;
+    metadata.coalescing_mode = deallocate_coalescing_mode;
+    metadata.first_free_block = nullptr;
+    metadata.first_parked_block = nullptr;
+    metadata.parked_blocks_count = 0;
+    metadata.header_writes_count = 0;
+    
+    block_header *block = get_first_block(_trusted_memory);
+    block->fit_hits_count = 0;
+    set_block_size(metadata, block, space_size);
+    push_free_block(metadata, block);
+    
+    debug_with_guard(get_typename() + "::allocator_boundary_tags: " + std::to_string(space_size) + " bytes of blocks space");
 }
 
 [[nodiscard]] void *allocator_boundary_tags::allocate(
     size_t value_size,
     size_t values_count)
 {
-    throw not_implemented("[[nodiscard]] void *allocator_boundary_tags::allocate(size_t, size_t)", "your code should be here...");
+    return allocate_at_least(value_size, values_count).pointer;
+}
+
+[[nodiscard]] allocator::allocation_result allocator_boundary_tags::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    size_t const overhead = block_header_size + sizeof(block_footer);
+    
+    if (values_count != 0 && value_size > (metadata.space_size - overhead) / values_count)
+    {
+        error_with_guard(get_typename() + "::allocate: requested size exceeds the blocks space");
+        
+        throw std::bad_alloc();
+    }
+    
+    size_t requested_size = value_size * values_count;
+    size_t block_size = std::max(align_up(overhead + requested_size), min_block_size);
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    block_header *block = metadata.coalescing_mode == allocator_with_coalescing_mode::coalescing_mode::deferred
+        ? take_parked_block(metadata, block_size)
+        : nullptr;
+    
+    if (block == nullptr)
+    {
+        block = find_free_block(metadata, block_size);
+        
+        if (block == nullptr && metadata.parked_blocks_count != 0)
+        {
+            merge_free_blocks(_trusted_memory);
+            block = find_free_block(metadata, block_size);
+        }
+        
+        if (block == nullptr)
+        {
+            error_with_guard(get_typename() + "::allocate: no free block of " + std::to_string(block_size) + " bytes");
+            
+            throw std::bad_alloc();
+        }
+        
+        unlink_free_block(metadata, block);
+        
+        if (block->block_size - block_size >= min_block_size)
+        {
+            auto *remainder = reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(block) + block_size);
+            remainder->fit_hits_count = 0;
+            set_block_size(metadata, remainder, block->block_size - block_size);
+            push_free_block(metadata, remainder);
+            
+            set_block_size(metadata, block, block_size);
+        }
+    }
+    
+    block->state = block_state::occupied;
+    if (block->fit_hits_count != UINT32_MAX)
+    {
+        ++block->fit_hits_count;
+    }
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::allocate: " + std::to_string(requested_size) + " bytes requested, " + std::to_string(block->block_size) + " bytes block allocated");
+    }
+    
+    return { get_payload(block), block->block_size - overhead };
 }
 
 void allocator_boundary_tags::deallocate(
     void *at)
 {
-    throw not_implemented("void allocator_boundary_tags::deallocate(void *)", "your code should be here...");
+    if (at == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    block_header *first_block = get_first_block(_trusted_memory);
+    void *blocks_end = get_blocks_end(_trusted_memory);
+    block_header *block = get_block(at);
+    
+    if (block < first_block || block >= blocks_end || block->state != block_state::occupied
+        || block->block_size > static_cast<size_t>(reinterpret_cast<unsigned char *>(blocks_end) - reinterpret_cast<unsigned char *>(block))
+        || get_footer(block).block_size != block->block_size)
+    {
+        error_with_guard(get_typename() + "::deallocate: block does not belong to the allocator or is already released");
+        
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::deallocate: " + std::to_string(block->block_size) + " bytes block released");
+    }
+    
+    if (metadata.coalescing_mode == allocator_with_coalescing_mode::coalescing_mode::deferred)
+    {
+        block->state = block_state::parked;
+        get_links(block).next = metadata.first_parked_block;
+        metadata.first_parked_block = block;
+        
+        if (++metadata.parked_blocks_count > allocator_with_coalescing_mode::deferred_blocks_threshold)
+        {
+            // an attached thread is woken once per crossing and sweeps off the request thread;
+            // until it gets there allocate still sweeps inline when the quick lists can't serve a request
+            allocator_maintenance_thread *maintenance_thread = _maintenance_thread.load(std::memory_order_acquire);
+            if (maintenance_thread == nullptr)
+            {
+                merge_free_blocks(_trusted_memory);
+            }
+            else if (metadata.parked_blocks_count == allocator_with_coalescing_mode::deferred_blocks_threshold + 1)
+            {
+                maintenance_thread->request_maintenance();
+            }
+        }
+        
+        return;
+    }
+    
+    block_header *next = get_next_block(block);
+    if (next != blocks_end && next->state == block_state::free)
+    {
+        unlink_free_block(metadata, next);
+        set_block_size(metadata, block, block->block_size + next->block_size);
+    }
+    
+    if (block != first_block)
+    {
+        block_header *previous = get_previous_block(block);
+        if (previous->state == block_state::free)
+        {
+            unlink_free_block(metadata, previous);
+            set_block_size(metadata, previous, previous->block_size + block->block_size);
+            block = previous;
+        }
+    }
+    
+    push_free_block(metadata, block);
 }
 
 inline void allocator_boundary_tags::set_fit_mode(
     allocator_with_fit_mode::fit_mode mode)
 {
-    throw not_implemented("inline void allocator_boundary_tags::set_fit_mode(allocator_with_fit_mode::fit_mode)", "your code should be here...");
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    metadata.fit_mode = mode;
+}
+
+inline void allocator_boundary_tags::set_coalescing_mode(
+    allocator_with_coalescing_mode::coalescing_mode mode)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    // immediate mode relies on every non occupied block being merged already
+    if (mode == allocator_with_coalescing_mode::coalescing_mode::immediate && metadata.parked_blocks_count != 0)
+    {
+        merge_free_blocks(_trusted_memory);
+    }
+    
+    metadata.coalescing_mode = mode;
+}
+
+void allocator_boundary_tags::coalesce()
+{
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    merge_free_blocks(_trusted_memory);
+}
+
+void allocator_boundary_tags::trim()
+{
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    void *blocks_end = get_blocks_end(_trusted_memory);
+    size_t released_size = 0;
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    // the list links at the payload start and the footer at the block end have to survive
+    for (block_header *block = get_first_block(_trusted_memory); block != blocks_end; block = get_next_block(block))
+    {
+        if (block->state != block_state::occupied)
+        {
+            released_size += release_pages(
+                reinterpret_cast<unsigned char *>(&get_links(block)) + sizeof(free_block_links),
+                block->block_size - block_header_size - sizeof(free_block_links) - sizeof(block_footer));
+        }
+    }
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::trim: " + std::to_string(released_size) + " bytes released");
+    }
+}
+
+size_t allocator_boundary_tags::get_header_writes_count() const noexcept
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    return metadata.header_writes_count;
+}
+
+void allocator_boundary_tags::set_maintenance_thread(
+    allocator_maintenance_thread *maintenance_thread) noexcept
+{
+    _maintenance_thread.store(maintenance_thread, std::memory_order_release);
 }
 
 inline allocator *allocator_boundary_tags::get_allocator() const
 {
-    throw not_implemented("inline allocator *allocator_boundary_tags::get_allocator() const", "your code should be here...");
+    return get_metadata(_trusted_memory).parent_allocator;
 }
 
 std::vector<allocator_test_utils::block_info> allocator_boundary_tags::get_blocks_info() const noexcept
 {
-    throw not_implemented("std::vector<allocator_test_utils::block_info> allocator_boundary_tags::get_blocks_info() const noexcept", "your code should be here...");
+    std::vector<allocator_test_utils::block_info> blocks_info;
+    
+    try
+    {
+        for (auto const &block: get_blocks_layout())
+        {
+            blocks_info.push_back({ block.block_size, block.is_block_occupied });
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        blocks_info.clear();
+    }
+    
+    return blocks_info;
+}
+
+std::vector<allocator_test_utils::block_layout_info> allocator_boundary_tags::get_blocks_layout() const
+{
+    std::vector<allocator_test_utils::block_layout_info> layout;
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    void *blocks_end = get_blocks_end(_trusted_memory);
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    for (block_header *block = get_first_block(_trusted_memory); block != blocks_end; block = get_next_block(block))
+    {
+        layout.push_back({
+            static_cast<size_t>(reinterpret_cast<unsigned char *>(block) - reinterpret_cast<unsigned char *>(_trusted_memory)),
+            block->block_size,
+            block->state == block_state::occupied,
+            block->fit_hits_count });
+    }
+    
+    return layout;
+}
+
+void allocator_boundary_tags::snapshot_to(
+    int fd) const
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    write_image(fd, get_typename(), image_version, _trusted_memory, metadata_size + metadata.space_size);
+}
+
+void allocator_boundary_tags::restore_from(
+    int fd)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    size_t image_size = read_image_size(fd, get_typename(), image_version);
+    if (image_size < metadata_size + min_block_size)
+    {
+        error_with_guard(get_typename() + "::restore_from: image is too small");
+        
+        throw std::runtime_error("allocator image is too small");
+    }
+    
+    // the image lives in the same parent allocator as the current trusted memory
+    void *image = allocate_with_guard(1, image_size);
+    try
+    {
+        read_image(fd, image, image_size);
+        if (metadata_size + get_metadata(image).space_size != image_size)
+        {
+            throw std::runtime_error("allocator image size does not match its metadata");
+        }
+        
+        if (!is_image_valid(image, image_size))
+        {
+            throw std::runtime_error("allocator image is corrupted");
+        }
+    }
+    catch (...)
+    {
+        deallocate_with_guard(image);
+        
+        throw;
+    }
+    
+    allocator_metadata &image_metadata = get_metadata(image);
+    image_metadata.parent_allocator = metadata.parent_allocator;
+    image_metadata.target_logger = metadata.target_logger;
+    rebase_image(image);
+    
+    {
+        // operations already running on the current image finish before it is released
+        std::lock_guard<std::mutex> lock(metadata.mutex);
+        std::swap(_trusted_memory, image);
+    }
+    
+    get_metadata(image).mutex.~mutex();
+    deallocate_with_guard(image);
+    
+    debug_with_guard(get_typename() + "::restore_from: " + std::to_string(image_size) + " bytes image restored");
+}
+
+bool allocator_boundary_tags::is_image_valid(
+    void *trusted_memory,
+    size_t image_size)
+{
+    allocator_metadata &metadata = get_metadata(trusted_memory);
+    void const *old_base = metadata.trusted_memory;
+    auto get_block_at = [trusted_memory](size_t block_offset)
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(trusted_memory) + block_offset);
+    };
+    
+    if (metadata.fit_mode > allocator_with_fit_mode::fit_mode::the_worst_fit
+        || metadata.coalescing_mode > allocator_with_coalescing_mode::coalescing_mode::deferred)
+    {
+        return false;
+    }
+    
+    // a zero or oversized block size would send every walk over the blocks astray
+    std::vector<size_t> released_block_offsets;
+    for (size_t block_offset = metadata_size; block_offset != image_size; block_offset += get_block_at(block_offset)->block_size)
+    {
+        block_header *block = get_block_at(block_offset);
+        if (block->block_size < min_block_size || block->block_size % block_alignment != 0 || block->block_size > image_size - block_offset
+            || get_footer(block).block_size != block->block_size)
+        {
+            return false;
+        }
+        
+        if (block->state == block_state::free || block->state == block_state::parked)
+        {
+            released_block_offsets.push_back(block_offset);
+        }
+        else if (block->state != block_state::occupied)
+        {
+            return false;
+        }
+    }
+    
+    // every free block links back to its predecessor, and the walk can't be longer than the released blocks count
+    size_t free_blocks_count = 0;
+    block_header *previous = nullptr;
+    for (block_header *link = metadata.first_free_block; link != nullptr; ++free_blocks_count)
+    {
+        size_t block_offset = get_image_offset(link, old_base, image_size);
+        if (free_blocks_count == released_block_offsets.size()
+            || !std::binary_search(released_block_offsets.begin(), released_block_offsets.end(), block_offset)
+            || get_block_at(block_offset)->state != block_state::free
+            || get_links(get_block_at(block_offset)).previous != previous)
+        {
+            return false;
+        }
+        
+        previous = link;
+        link = get_links(get_block_at(block_offset)).next;
+    }
+    
+    size_t parked_blocks_count = 0;
+    for (block_header *link = metadata.first_parked_block; link != nullptr; ++parked_blocks_count)
+    {
+        size_t block_offset = get_image_offset(link, old_base, image_size);
+        if (parked_blocks_count == metadata.parked_blocks_count
+            || !std::binary_search(released_block_offsets.begin(), released_block_offsets.end(), block_offset)
+            || get_block_at(block_offset)->state != block_state::parked)
+        {
+            return false;
+        }
+        
+        link = get_links(get_block_at(block_offset)).next;
+    }
+    
+    return parked_blocks_count == metadata.parked_blocks_count
+        && free_blocks_count + parked_blocks_count == released_block_offsets.size();
+}
+
+void allocator_boundary_tags::rebase_image(
+    void *trusted_memory) noexcept
+{
+    allocator_metadata &metadata = *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    void const *old_base = metadata.trusted_memory;
+    size_t image_size = metadata_size + metadata.space_size;
+    auto rebase = [old_base, image_size, trusted_memory](auto *pointer)
+    {
+        return reinterpret_cast<decltype(pointer)>(relocate(pointer, old_base, image_size, trusted_memory));
+    };
+    
+    new (&metadata.mutex) std::mutex;
+    metadata.trusted_memory = trusted_memory;
+    metadata.first_free_block = rebase(metadata.first_free_block);
+    metadata.first_parked_block = rebase(metadata.first_parked_block);
+    
+    void *blocks_end = get_blocks_end(trusted_memory);
+    for (block_header *block = get_first_block(trusted_memory); block != blocks_end; block = get_next_block(block))
+    {
+        if (block->state != block_state::occupied)
+        {
+            free_block_links &links = get_links(block);
+            links.previous = rebase(links.previous);
+            links.next = rebase(links.next);
+        }
+    }
 }
 
 inline logger *allocator_boundary_tags::get_logger() const
 {
-    throw not_implemented("inline logger *allocator_boundary_tags::get_logger() const", "your code should be here...");
+    return _trusted_memory == nullptr
+        ? nullptr
+        : get_metadata(_trusted_memory).target_logger;
 }
 
 inline std::string allocator_boundary_tags::get_typename() const noexcept
 {
-    throw not_implemented("inline std::string allocator_boundary_tags::get_typename() const noexcept", "your code should be here...");
+    return "allocator_boundary_tags";
 }
\ No newline at end of file
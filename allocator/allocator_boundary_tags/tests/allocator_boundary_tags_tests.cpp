@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <unistd.h>
 #include <allocator.h>
 #include <allocator_boundary_tags.h>
+#include <allocator_maintenance_thread.h>
 #include <client_logger_builder.h>
 #include <logger.h>
 #include <logger_builder.h>
@@ -29,6 +36,55 @@ logger *create_logger(
     return logger_instance;
 }
 
+// stalls the maintenance pass in its coalesce until released; attached before the allocator under test,
+// so a test can deallocate while the pass that would sweep the allocator is held
+class maintenance_pass_gate final:
+    public allocator_with_coalescing_mode
+{
+
+public:
+    
+    std::atomic<bool> is_entered { false };
+    
+    std::atomic<bool> is_holding { true };
+
+public:
+    
+    void set_coalescing_mode(
+        coalescing_mode) override
+    {
+
+    }
+    
+    void coalesce() override
+    {
+        is_entered = true;
+        while (is_holding)
+        {
+            std::this_thread::yield();
+        }
+    }
+    
+    void trim() override
+    {
+
+    }
+    
+    size_t get_header_writes_count() const noexcept override
+    {
+        return 0;
+    }
+
+private:
+    
+    void set_maintenance_thread(
+        allocator_maintenance_thread *) noexcept override
+    {
+
+    }
+    
+};
+
 TEST(positiveTests, test1)
 {
     logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
@@ -38,14 +94,21 @@ TEST(positiveTests, test1)
                 logger::severity::information
             }
         });
-    allocator *subject = new allocator_boundary_tags(sizeof(int) * 40, nullptr, logger, allocator_with_fit_mode::fit_mode::first_fit);
+    allocator *subject = new allocator_boundary_tags(sizeof(int) * 100, nullptr, logger, allocator_with_fit_mode::fit_mode::first_fit);
     
     auto const *first_block = reinterpret_cast<int const *>(subject->allocate(sizeof(int), 10));
     auto const *second_block = reinterpret_cast<int const *>(subject->allocate(sizeof(int), 10));
     auto const *third_block = reinterpret_cast<int const *>(subject->allocate(sizeof(int), 10));
+    auto blocks_state = dynamic_cast<allocator_test_utils *>(subject)->get_blocks_info();
     
-    ASSERT_EQ(first_block + 10, second_block);
-    ASSERT_EQ(second_block + 10, third_block);
+    // every block carries its header and footer, so the payloads lie one whole block apart
+    size_t const block_size = blocks_state[0].block_size;
+    ASSERT_EQ(blocks_state.size(), 4);
+    ASSERT_EQ(blocks_state[1], (allocator_test_utils::block_info { .block_size = block_size, .is_block_occupied = true }));
+    ASSERT_EQ(blocks_state[2], (allocator_test_utils::block_info { .block_size = block_size, .is_block_occupied = true }));
+    ASSERT_EQ(blocks_state[3], (allocator_test_utils::block_info { .block_size = sizeof(int) * 100 - block_size * 3, .is_block_occupied = false }));
+    ASSERT_EQ(reinterpret_cast<char const *>(first_block) + block_size, reinterpret_cast<char const *>(second_block));
+    ASSERT_EQ(reinterpret_cast<char const *>(second_block) + block_size, reinterpret_cast<char const *>(third_block));
     
     subject->deallocate(const_cast<void *>(reinterpret_cast<void const *>(second_block)));
     
@@ -55,8 +118,8 @@ TEST(positiveTests, test1)
     the_same_subject->set_fit_mode(allocator_with_fit_mode::fit_mode::the_best_fit);
     auto const *fifth_block = reinterpret_cast<int const *>(subject->allocate(sizeof(int), 1));
     
-    ASSERT_EQ(first_block + 10, fifth_block);
-    ASSERT_EQ(third_block + 10, fourth_block);
+    ASSERT_EQ(second_block, fifth_block);
+    ASSERT_EQ(reinterpret_cast<char const *>(third_block) + block_size, reinterpret_cast<char const *>(fourth_block));
     
     subject->deallocate(const_cast<void *>(reinterpret_cast<void const *>(first_block)));
     subject->deallocate(const_cast<void *>(reinterpret_cast<void const *>(third_block)));
@@ -77,24 +140,33 @@ TEST(positiveTests, test2)
             }
         });
     allocator *allocator_instance = new allocator_boundary_tags(sizeof(unsigned char) * 3000, nullptr, logger_instance, allocator_with_fit_mode::fit_mode::first_fit);
+    auto *utils = dynamic_cast<allocator_test_utils *>(allocator_instance);
     
+    // the blocks space is cut down to the block alignment
+    size_t const space_size = utils->get_blocks_info()[0].block_size;
     char *first_block = reinterpret_cast<char *>(allocator_instance->allocate(sizeof(char), 1000));
     char *second_block = reinterpret_cast<char *>(allocator_instance->allocate(sizeof(char), 0));
+    auto blocks_state = utils->get_blocks_info();
+    size_t const first_block_size = blocks_state[0].block_size;
+    size_t const second_block_size = blocks_state[1].block_size;
+    
+    ASSERT_EQ(first_block_size, 1000 + sizeof(allocator::block_size_t) + sizeof(allocator::block_pointer_t) * 2);
+    ASSERT_LT(second_block_size, first_block_size);
+    ASSERT_EQ(first_block + first_block_size, second_block);
+    
     allocator_instance->deallocate(first_block);
     first_block = reinterpret_cast<char *>(allocator_instance->allocate(sizeof(char), 999));
-    auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(allocator_instance)->get_blocks_info();
+    
+    // the 999 bytes request takes the whole hole left by the first block, the 1 byte tail can't become a block
     std::vector<allocator_test_utils::block_info> expected_blocks_state
         {
-            { .block_size = 1000 + sizeof(allocator::block_size_t) + sizeof(allocator::block_pointer_t) * 2, .is_block_occupied = true },
-            { .block_size = 1000 + sizeof(allocator::block_size_t) + sizeof(allocator::block_pointer_t) * 2, .is_block_occupied = true },
-            { .block_size = 3000 - (1000 + sizeof(allocator::block_size_t) + sizeof(allocator::block_pointer_t)) * 2, .is_block_occupied = false }
+            { .block_size = first_block_size, .is_block_occupied = true },
+            { .block_size = second_block_size, .is_block_occupied = true },
+            { .block_size = space_size - first_block_size - second_block_size, .is_block_occupied = false }
         };
     
-    ASSERT_EQ(actual_blocks_state.size(), expected_blocks_state.size());
-    for (int i = 0; i < actual_blocks_state.size(); i++)
-    {
-        ASSERT_EQ(actual_blocks_state[i], expected_blocks_state[i]);
-    }
+    ASSERT_EQ(first_block + first_block_size, second_block);
+    ASSERT_EQ(utils->get_blocks_info(), expected_blocks_state);
     
     allocator_instance->deallocate(first_block);
     allocator_instance->deallocate(second_block);
@@ -103,6 +175,207 @@ TEST(positiveTests, test2)
     delete logger_instance;
 }
 
+TEST(positiveTests, test3)
+{
+    allocator *allocator_instance = new allocator_boundary_tags(3000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit, allocator_with_coalescing_mode::coalescing_mode::deferred);
+    
+    void *first_block = allocator_instance->allocate(sizeof(char), 100);
+    void *second_block = allocator_instance->allocate(sizeof(char), 100);
+    allocator_instance->deallocate(first_block);
+    allocator_instance->deallocate(second_block);
+    
+    auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(allocator_instance)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 3);
+    ASSERT_EQ(actual_blocks_state[0].is_block_occupied, false);
+    ASSERT_EQ(actual_blocks_state[1].is_block_occupied, false);
+    
+    void *third_block = allocator_instance->allocate(sizeof(char), 100);
+    ASSERT_EQ(third_block, second_block);
+    allocator_instance->deallocate(third_block);
+    
+    dynamic_cast<allocator_with_coalescing_mode *>(allocator_instance)->coalesce();
+    
+    actual_blocks_state = dynamic_cast<allocator_test_utils *>(allocator_instance)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 1);
+    ASSERT_EQ(actual_blocks_state[0].is_block_occupied, false);
+    
+    delete allocator_instance;
+}
+
+TEST(positiveTests, test4)
+{
+    allocator_boundary_tags subject(2000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto first_block = subject.allocate(sizeof(int), 50);
+    auto second_block = subject.allocate(sizeof(char), 300);
+    auto third_block = subject.allocate(sizeof(int), 20);
+    auto occupied_blocks_state = subject.get_blocks_info();
+    subject.deallocate(second_block);
+    
+    auto expected_blocks_state = subject.get_blocks_info();
+    
+    // the copy walks its own relocated free lists and leaves the source arena untouched
+    allocator_boundary_tags copy(subject);
+    ASSERT_EQ(copy.get_blocks_info(), expected_blocks_state);
+    (void)copy.allocate(sizeof(char), 300);
+    ASSERT_EQ(copy.get_blocks_info(), occupied_blocks_state);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    FILE *image = tmpfile();
+    ASSERT_NE(image, nullptr);
+    subject.snapshot_to(fileno(image));
+    ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+    
+    allocator_boundary_tags restored(2000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    restored.restore_from(fileno(image));
+    fclose(image);
+    ASSERT_EQ(restored.get_blocks_info(), expected_blocks_state);
+    (void)restored.allocate(sizeof(char), 300);
+    ASSERT_EQ(restored.get_blocks_info(), occupied_blocks_state);
+    
+    copy = subject;
+    ASSERT_EQ(copy.get_blocks_info(), expected_blocks_state);
+    
+    subject.deallocate(first_block);
+    subject.deallocate(third_block);
+}
+
+TEST(positiveTests, test5)
+{
+    allocator_boundary_tags subject(1 << 20, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit,
+        allocator_with_coalescing_mode::coalescing_mode::deferred);
+    allocator_with_coalescing_mode &maintained = subject;
+    
+    void *blocks[8];
+    for (auto &block: blocks)
+    {
+        block = subject.allocate(1, 1 << 16);
+        std::memset(block, 0xAB, 1 << 16);
+    }
+    
+    for (size_t i = 0; i < 8; i += 2)
+    {
+        subject.deallocate(blocks[i]);
+    }
+    
+    auto expected_blocks_state = subject.get_blocks_info();
+    
+    // the released pages hold no bookkeeping: the layout survives and the blocks are usable again
+    maintained.trim();
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    ASSERT_EQ(reinterpret_cast<unsigned char *>(blocks[1])[0], 0xAB);
+    
+    maintained.coalesce();
+    maintained.trim();
+    for (size_t i = 0; i < 8; i += 2)
+    {
+        blocks[i] = subject.allocate(1, 1 << 16);
+        std::memset(blocks[i], 0xCD, 1 << 16);
+    }
+    
+    for (auto block: blocks)
+    {
+        subject.deallocate(block);
+    }
+    
+    maintained.coalesce();
+    ASSERT_EQ(subject.get_blocks_info().size(), 1);
+}
+
+TEST(positiveTests, test6)
+{
+    allocator_boundary_tags subject(sizeof(int) * 100, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit,
+        allocator_with_coalescing_mode::coalescing_mode::deferred);
+    
+    auto const *first_block = reinterpret_cast<char const *>(subject.allocate(sizeof(int), 10));
+    auto const *second_block = reinterpret_cast<char const *>(subject.allocate(sizeof(int), 10));
+    auto const *third_block = reinterpret_cast<char const *>(subject.allocate(sizeof(int), 10));
+    size_t const block_size = subject.get_blocks_info()[0].block_size;
+    size_t header_writes_count = subject.get_header_writes_count();
+    
+    // the parked block is neither merged nor retagged and serves the next request of its size class
+    // whatever the fit mode, so the worst fit request lands in the hole instead of the trailing block
+    subject.deallocate(const_cast<char *>(second_block));
+    ASSERT_EQ(subject.get_header_writes_count(), header_writes_count);
+    
+    allocator_with_fit_mode &the_same_subject = subject;
+    the_same_subject.set_fit_mode(allocator_with_fit_mode::fit_mode::the_worst_fit);
+    auto const *fourth_block = reinterpret_cast<char const *>(subject.allocate(sizeof(int), 1));
+    the_same_subject.set_fit_mode(allocator_with_fit_mode::fit_mode::the_best_fit);
+    auto const *fifth_block = reinterpret_cast<char const *>(subject.allocate(sizeof(int), 1));
+    
+    ASSERT_EQ(second_block, fourth_block);
+    ASSERT_EQ(third_block + block_size, fifth_block);
+    ASSERT_EQ(subject.get_header_writes_count(), header_writes_count + 2);
+    
+    // two adjacent parked blocks stay apart until the sweep
+    subject.deallocate(const_cast<char *>(first_block));
+    subject.deallocate(const_cast<char *>(fourth_block));
+    auto blocks_state = subject.get_blocks_info();
+    ASSERT_EQ(blocks_state.size(), 5);
+    ASSERT_EQ(blocks_state[0], (allocator_test_utils::block_info { .block_size = block_size, .is_block_occupied = false }));
+    ASSERT_EQ(blocks_state[1], (allocator_test_utils::block_info { .block_size = block_size, .is_block_occupied = false }));
+    
+    subject.coalesce();
+    blocks_state = subject.get_blocks_info();
+    ASSERT_EQ(blocks_state.size(), 4);
+    ASSERT_EQ(blocks_state[0], (allocator_test_utils::block_info { .block_size = block_size * 2, .is_block_occupied = false }));
+    
+    subject.deallocate(const_cast<char *>(third_block));
+    subject.deallocate(const_cast<char *>(fifth_block));
+}
+
+TEST(positiveTests, test7)
+{
+    maintenance_pass_gate pass_gate;
+    allocator_maintenance_thread maintenance_thread(std::chrono::hours(1));
+    size_t const blocks_count = allocator_with_coalescing_mode::deferred_blocks_threshold + 2;
+    auto *subject = new allocator_boundary_tags(1 << 14, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit,
+        allocator_with_coalescing_mode::coalescing_mode::deferred);
+    
+    std::vector<void *> blocks(blocks_count);
+    for (auto &block: blocks)
+    {
+        block = subject->allocate(sizeof(int), 4);
+    }
+    
+    maintenance_thread.attach(&pass_gate);
+    maintenance_thread.attach(subject);
+    maintenance_thread.request_maintenance();
+    while (!pass_gate.is_entered)
+    {
+        std::this_thread::yield();
+    }
+    
+    // past the threshold deallocate only wakes the thread, the adjacent parked blocks stay apart
+    for (size_t i = 0; i < blocks_count - 1; ++i)
+    {
+        subject->deallocate(blocks[i]);
+    }
+    size_t const held_blocks_count = subject->get_blocks_info().size();
+    
+    // released before asserting, a held pass would never let the thread join
+    pass_gate.is_holding = false;
+    ASSERT_EQ(held_blocks_count, blocks_count + 1);
+    while (maintenance_thread.get_passes_count() < 2)
+    {
+        std::this_thread::yield();
+    }
+    
+    auto blocks_state = subject->get_blocks_info();
+    ASSERT_EQ(blocks_state.size(), 3);
+    ASSERT_FALSE(blocks_state[0].is_block_occupied);
+    ASSERT_TRUE(blocks_state[1].is_block_occupied);
+    
+    // the destructor detaches, so the next pass maintains the gate only
+    delete subject;
+    maintenance_thread.request_maintenance();
+    while (maintenance_thread.get_passes_count() < 3)
+    {
+        std::this_thread::yield();
+    }
+}
+
 TEST(falsePositiveTests, test1)
 {
     logger *logger_instance = create_logger(std::vector<std::pair<std::string, logger::severity>>
@@ -120,6 +393,44 @@ TEST(falsePositiveTests, test1)
     delete logger_instance;
 }
 
+TEST(falsePositiveTests, test2)
+{
+    allocator_boundary_tags subject(2000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto block = subject.allocate(sizeof(int), 50);
+    auto layout = subject.get_blocks_layout();
+    auto expected_blocks_state = subject.get_blocks_info();
+    
+    FILE *image = tmpfile();
+    ASSERT_NE(image, nullptr);
+    subject.snapshot_to(fileno(image));
+    
+    // the image header goes before the trusted memory bytes, and the block offsets count from the latter
+    off_t image_header_size = lseek(fileno(image), 0, SEEK_END) - static_cast<off_t>(layout.back().block_offset + layout.back().block_size);
+    auto restore_patched = [&subject, image](off_t position, uint64_t value)
+    {
+        uint64_t original_value;
+        ASSERT_EQ(pread(fileno(image), &original_value, sizeof(original_value), position), sizeof(original_value));
+        ASSERT_EQ(pwrite(fileno(image), &value, sizeof(value), position), sizeof(value));
+        ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+        ASSERT_THROW(subject.restore_from(fileno(image)), std::runtime_error);
+        ASSERT_EQ(pwrite(fileno(image), &original_value, sizeof(original_value), position), sizeof(original_value));
+    };
+    
+    // the type tag, the layout version and a zero size of the trailing block, which would loop every walk over the blocks
+    restore_patched(sizeof(uint64_t), 0);
+    restore_patched(sizeof(uint64_t) * 2, 2);
+    restore_patched(image_header_size + static_cast<off_t>(layout.back().block_offset), 0);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+    subject.restore_from(fileno(image));
+    fclose(image);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    subject.deallocate(block);
+}
+
 int main(
     int argc,
     char *argv[])
@@ -4,6 +4,7 @@
 #include <allocator_guardant.h>
 #include <allocator_test_utils.h>
 #include <allocator_with_fit_mode.h>
+#include <allocator_with_snapshot.h>
 #include <logger_guardant.h>
 #include <typename_holder.h>
 
@@ -11,10 +12,20 @@ class allocator_buddies_system final:
     private allocator_guardant,
     public allocator_test_utils,
     public allocator_with_fit_mode,
+    public allocator_with_snapshot,
     private logger_guardant,
     private typename_holder
 {
 
+public:
+    
+    struct space_size_in_bytes final
+    {
+        
+        size_t value;
+        
+    };
+
 private:
     
     void *_trusted_memory;
@@ -42,6 +53,14 @@ public:
         allocator *parent_allocator = nullptr,
         logger *logger = nullptr,
         allocator_with_fit_mode::fit_mode allocate_fit_mode = allocator_with_fit_mode::fit_mode::first_fit);
+    
+    // space is split into maximal power-of-two buddy trees laid out side by side (e.g. 5120 = 4096 + 1024);
+    // allocation is served from the smallest tree that has a fitting free block
+    explicit allocator_buddies_system(
+        space_size_in_bytes space_size,
+        allocator *parent_allocator = nullptr,
+        logger *logger = nullptr,
+        allocator_with_fit_mode::fit_mode allocate_fit_mode = allocator_with_fit_mode::fit_mode::first_fit);
 
 public:
     
@@ -49,6 +68,10 @@ public:
         size_t value_size,
         size_t values_count) override;
     
+    [[nodiscard]] allocator::allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count) override;
+    
     void deallocate(
         void *at) override;
 
@@ -64,6 +87,27 @@ private:
 public:
     
     std::vector<allocator_test_utils::block_info> get_blocks_info() const noexcept override;
+    
+    std::vector<allocator_test_utils::block_layout_info> get_blocks_layout() const override;
+
+public:
+    
+    void snapshot_to(
+        int fd) const override;
+    
+    void restore_from(
+        int fd) override;
+
+private:
+    
+    // makes a byte copy of a trusted memory image usable at its own address
+    static void rebase_image(
+        void *trusted_memory) noexcept;
+    
+    // checks the sizes and links of a freshly read image before rebase_image walks it
+    static bool is_image_valid(
+        void *trusted_memory,
+        size_t image_size);
 
 private:
     
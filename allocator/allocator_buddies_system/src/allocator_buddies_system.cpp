@@ -1,80 +1,670 @@
-#include <not_implemented.h>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "../include/allocator_buddies_system.h"
 
+namespace
+{
+    
+    enum class block_state:
+        uint8_t
+    {
+        free,
+        occupied
+    };
+    
+    struct block_header final
+    {
+        
+        // trusted memory for an occupied block, so a foreign pointer is caught on deallocate
+        void *owner;
+        
+        uint32_t fit_hits_count;
+        
+        // block size is 1 << power
+        uint8_t power;
+        
+        block_state state;
+        
+    };
+    
+    // lives in the first payload bytes of a free block
+    struct free_block_links final
+    {
+        
+        block_header *previous;
+        
+        block_header *next;
+        
+    };
+    
+    constexpr size_t max_power = sizeof(size_t) * CHAR_BIT - 1;
+    
+    struct allocator_metadata final
+    {
+        
+        void *trusted_memory;
+        
+        allocator *parent_allocator;
+        
+        logger *target_logger;
+        
+        // blocks area only, metadata excluded; every set bit is one buddy tree
+        size_t space_size;
+        
+        allocator_with_fit_mode::fit_mode fit_mode;
+        
+        std::mutex mutex;
+        
+        // one list of free blocks per power of two
+        block_header *free_blocks[max_power + 1];
+        
+    };
+    
+    // bumped on every change of the metadata or block layout, snapshots of another layout are refused
+    constexpr uint32_t image_version = 1;
+    
+    constexpr size_t block_alignment = alignof(std::max_align_t);
+    
+    constexpr size_t align_up(
+        size_t value) noexcept
+    {
+        return (value + block_alignment - 1) / block_alignment * block_alignment;
+    }
+    
+    constexpr size_t metadata_size = align_up(sizeof(allocator_metadata));
+    
+    constexpr size_t block_header_size = align_up(sizeof(block_header));
+    
+    constexpr size_t get_power_of(
+        size_t size,
+        size_t power = 0) noexcept
+    {
+        return (size_t(1) << power) >= size
+            ? power
+            : get_power_of(size, power + 1);
+    }
+    
+    // the smallest block has to hold the free list links
+    constexpr size_t min_block_power = get_power_of(block_header_size + sizeof(free_block_links));
+    
+    constexpr size_t min_block_size = size_t(1) << min_block_power;
+    
+    inline allocator_metadata &get_metadata(
+        void *trusted_memory) noexcept
+    {
+        return *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    }
+    
+    inline unsigned char *get_blocks_begin(
+        void *trusted_memory) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(trusted_memory) + metadata_size;
+    }
+    
+    inline block_header *get_block_at(
+        void *trusted_memory,
+        size_t block_offset) noexcept
+    {
+        return reinterpret_cast<block_header *>(get_blocks_begin(trusted_memory) + block_offset);
+    }
+    
+    inline size_t get_block_offset(
+        void *trusted_memory,
+        block_header *block) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(block) - get_blocks_begin(trusted_memory);
+    }
+    
+    inline free_block_links &get_links(
+        block_header *block) noexcept
+    {
+        return *reinterpret_cast<free_block_links *>(reinterpret_cast<unsigned char *>(block) + block_header_size);
+    }
+    
+    // trees are laid out from the biggest one, so every tree starts at a multiple of its own size
+    // and a buddy address is the block offset with the power bit flipped, as long as it stays inside the tree
+    size_t get_tree_power(
+        size_t space_size,
+        size_t block_offset) noexcept
+    {
+        size_t tree_offset = 0;
+        for (size_t power = max_power; power >= min_block_power; --power)
+        {
+            size_t tree_size = size_t(1) << power;
+            if ((space_size & tree_size) == 0)
+            {
+                continue;
+            }
+            
+            if (block_offset < tree_offset + tree_size)
+            {
+                return power;
+            }
+            
+            tree_offset += tree_size;
+        }
+        
+        return min_block_power;
+    }
+    
+    void push_free_block(
+        allocator_metadata &metadata,
+        block_header *block,
+        size_t power) noexcept
+    {
+        block->owner = nullptr;
+        block->power = static_cast<uint8_t>(power);
+        block->state = block_state::free;
+        
+        block_header *&head = metadata.free_blocks[power];
+        get_links(block) = { nullptr, head };
+        if (head != nullptr)
+        {
+            get_links(head).previous = block;
+        }
+        
+        head = block;
+    }
+    
+    void unlink_free_block(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        free_block_links &links = get_links(block);
+        
+        (links.previous == nullptr
+            ? metadata.free_blocks[block->power]
+            : get_links(links.previous).next) = links.next;
+        if (links.next != nullptr)
+        {
+            get_links(links.next).previous = links.previous;
+        }
+    }
+    
+    // returns the power of the list to take a block from or max_power + 1
+    size_t find_free_list(
+        allocator_metadata const &metadata,
+        size_t power) noexcept
+    {
+        size_t found = max_power + 1;
+        
+        for (size_t current = power; current <= max_power; ++current)
+        {
+            if (metadata.free_blocks[current] == nullptr)
+            {
+                continue;
+            }
+            
+            found = current;
+            
+            // with power of two size classes the first fitting class is the best fitting one
+            if (metadata.fit_mode != allocator_with_fit_mode::fit_mode::the_worst_fit)
+            {
+                break;
+            }
+        }
+        
+        return found;
+    }
+    
+    size_t get_space_size(
+        size_t space_size_power_of_two)
+    {
+        if (space_size_power_of_two < min_block_power || space_size_power_of_two > max_power)
+        {
+            throw std::logic_error("allocator_buddies_system: space size power of two is out of the supported range");
+        }
+        
+        return size_t(1) << space_size_power_of_two;
+    }
+    
+}
+
 allocator_buddies_system::~allocator_buddies_system()
 {
-    throw not_implemented("allocator_buddies_system::~allocator_buddies_system()", "your code should be here...");
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    get_metadata(_trusted_memory).mutex.~mutex();
+    deallocate_with_guard(_trusted_memory);
 }
 
 allocator_buddies_system::allocator_buddies_system(
-    allocator_buddies_system const &other)
+    allocator_buddies_system const &other):
+    _trusted_memory(nullptr)
 {
-    throw not_implemented("allocator_buddies_system::allocator_buddies_system(allocator_buddies_system const &)", "your code should be here...");
+    if (other._trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &other_metadata = get_metadata(other._trusted_memory);
+    size_t image_size = metadata_size + other_metadata.space_size;
+    
+    _trusted_memory = other_metadata.parent_allocator == nullptr
+        ? ::operator new(image_size)
+        : other_metadata.parent_allocator->allocate(1, image_size);
+    
+    {
+        std::lock_guard<std::mutex> lock(other_metadata.mutex);
+        std::memcpy(_trusted_memory, other._trusted_memory, image_size);
+    }
+    
+    rebase_image(_trusted_memory);
 }
 
 allocator_buddies_system &allocator_buddies_system::operator=(
     allocator_buddies_system const &other)
 {
-    throw not_implemented("allocator_buddies_system &allocator_buddies_system::operator=(allocator_buddies_system const &)", "your code should be here...");
+    if (this != &other)
+    {
+        allocator_buddies_system copy(other);
+        std::swap(_trusted_memory, copy._trusted_memory);
+    }
+    
+    return *this;
 }
 
 allocator_buddies_system::allocator_buddies_system(
-    allocator_buddies_system &&other) noexcept
+    allocator_buddies_system &&other) noexcept:
+    _trusted_memory(other._trusted_memory)
 {
-    throw not_implemented("allocator_buddies_system::allocator_buddies_system(allocator_buddies_system &&) noexcept", "your code should be here...");
+    other._trusted_memory = nullptr;
 }
 
 allocator_buddies_system &allocator_buddies_system::operator=(
     allocator_buddies_system &&other) noexcept
 {
-    throw not_implemented("allocator_buddies_system &allocator_buddies_system::operator=(allocator_buddies_system &&) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        std::swap(_trusted_memory, other._trusted_memory);
+    }
+    
+    return *this;
+}
+
+allocator_buddies_system::allocator_buddies_system(
+    size_t space_size_power_of_two,
+    allocator *parent_allocator,
+    logger *logger,
+    allocator_with_fit_mode::fit_mode allocate_fit_mode):
+    allocator_buddies_system(space_size_in_bytes { get_space_size(space_size_power_of_two) }, parent_allocator, logger, allocate_fit_mode)
+{
+
 }
 
 allocator_buddies_system::allocator_buddies_system(
-    size_t space_size,
+    allocator_buddies_system::space_size_in_bytes space_size,
     allocator *parent_allocator,
     logger *logger,
     allocator_with_fit_mode::fit_mode allocate_fit_mode)
 {
-    throw not_implemented("allocator_buddies_system::allocator_buddies_system(size_t, allocator *, logger *, allocator_with_fit_mode::fit_mode)", "your code should be here...");
+    size_t blocks_space_size = space_size.value / min_block_size * min_block_size;
+    if (blocks_space_size == 0 || blocks_space_size > SIZE_MAX - metadata_size)
+    {
+        throw std::logic_error("allocator_buddies_system: space size can't hold a single block");
+    }
+    
+    _trusted_memory = parent_allocator == nullptr
+        ? ::operator new(metadata_size + blocks_space_size)
+        : parent_allocator->allocate(1, metadata_size + blocks_space_size);
+    
+    allocator_metadata &metadata = *new (_trusted_memory) allocator_metadata;
+    metadata.trusted_memory = _trusted_memory;
+    metadata.parent_allocator = parent_allocator;
+    metadata.target_logger = logger;
+    metadata.space_size = blocks_space_size;
+    metadata.fit_mode = allocate_fit_mode;
+    std::fill(std::begin(metadata.free_blocks), std::end(metadata.free_blocks), nullptr);
+    
+    size_t tree_offset = 0;
+    for (size_t power = max_power; power >= min_block_power; --power)
+    {
+        if ((blocks_space_size & (size_t(1) << power)) != 0)
+        {
+            block_header *tree = get_block_at(_trusted_memory, tree_offset);
+            tree->fit_hits_count = 0;
+            push_free_block(metadata, tree, power);
+            tree_offset += size_t(1) << power;
+        }
+    }
+    
+    debug_with_guard(get_typename() + "::allocator_buddies_system: " + std::to_string(blocks_space_size) + " bytes of blocks space");
 }
 
 [[nodiscard]] void *allocator_buddies_system::allocate(
     size_t value_size,
     size_t values_count)
 {
-    throw not_implemented("[[nodiscard]] void *allocator_buddies_system::allocate(size_t, size_t)", "your code should be here...");
+    return allocate_at_least(value_size, values_count).pointer;
+}
+
+[[nodiscard]] allocator::allocation_result allocator_buddies_system::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    
+    if (values_count != 0 && value_size > (metadata.space_size - block_header_size) / values_count)
+    {
+        error_with_guard(get_typename() + "::allocate: requested size exceeds the blocks space");
+        
+        throw std::bad_alloc();
+    }
+    
+    size_t requested_size = value_size * values_count;
+    size_t power = std::max(get_power_of(block_header_size + requested_size), min_block_power);
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    size_t found_power = find_free_list(metadata, power);
+    if (found_power > max_power)
+    {
+        error_with_guard(get_typename() + "::allocate: no free block of " + std::to_string(size_t(1) << power) + " bytes");
+        
+        throw std::bad_alloc();
+    }
+    
+    block_header *block = metadata.free_blocks[found_power];
+    unlink_free_block(metadata, block);
+    
+    // the lower half is kept on every step, the upper one becomes a free buddy
+    while (found_power != power)
+    {
+        --found_power;
+        auto *buddy = reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(block) + (size_t(1) << found_power));
+        buddy->fit_hits_count = 0;
+        push_free_block(metadata, buddy, found_power);
+    }
+    
+    block->owner = _trusted_memory;
+    block->power = static_cast<uint8_t>(power);
+    block->state = block_state::occupied;
+    if (block->fit_hits_count != UINT32_MAX)
+    {
+        ++block->fit_hits_count;
+    }
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::allocate: " + std::to_string(requested_size) + " bytes requested, " + std::to_string(size_t(1) << power) + " bytes block allocated");
+    }
+    
+    return { reinterpret_cast<unsigned char *>(block) + block_header_size, (size_t(1) << power) - block_header_size };
 }
 
 void allocator_buddies_system::deallocate(
     void *at)
 {
-    throw not_implemented("void allocator_buddies_system::deallocate(void *)", "your code should be here...");
+    if (at == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    auto *block = reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(at) - block_header_size);
+    
+    if (reinterpret_cast<unsigned char *>(block) < get_blocks_begin(_trusted_memory)
+        || reinterpret_cast<unsigned char *>(block) >= get_blocks_begin(_trusted_memory) + metadata.space_size
+        || block->owner != _trusted_memory || block->state != block_state::occupied)
+    {
+        error_with_guard(get_typename() + "::deallocate: block does not belong to the allocator or is already released");
+        
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    size_t power = block->power;
+    size_t block_offset = get_block_offset(_trusted_memory, block);
+    size_t tree_power = get_tree_power(metadata.space_size, block_offset);
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::deallocate: " + std::to_string(size_t(1) << power) + " bytes block released");
+    }
+    
+    while (power < tree_power)
+    {
+        block_header *buddy = get_block_at(_trusted_memory, block_offset ^ (size_t(1) << power));
+        if (buddy->state != block_state::free || buddy->power != power)
+        {
+            break;
+        }
+        
+        unlink_free_block(metadata, buddy);
+        block_offset &= ~(size_t(1) << power);
+        ++power;
+    }
+    
+    block = get_block_at(_trusted_memory, block_offset);
+    push_free_block(metadata, block, power);
 }
 
 inline void allocator_buddies_system::set_fit_mode(
     allocator_with_fit_mode::fit_mode mode)
 {
-    throw not_implemented("inline void allocator_buddies_system::set_fit_mode(allocator_with_fit_mode::fit_mode)", "your code should be here...");
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    metadata.fit_mode = mode;
 }
 
 inline allocator *allocator_buddies_system::get_allocator() const
 {
-    throw not_implemented("inline allocator *allocator_buddies_system::get_allocator() const", "your code should be here...");
+    return get_metadata(_trusted_memory).parent_allocator;
 }
 
 std::vector<allocator_test_utils::block_info> allocator_buddies_system::get_blocks_info() const noexcept
 {
-    throw not_implemented("std::vector<allocator_test_utils::block_info> allocator_buddies_system::get_blocks_info() const noexcept", "your code should be here...");
+    std::vector<allocator_test_utils::block_info> blocks_info;
+    
+    try
+    {
+        for (auto const &block: get_blocks_layout())
+        {
+            blocks_info.push_back({ block.block_size, block.is_block_occupied });
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        blocks_info.clear();
+    }
+    
+    return blocks_info;
+}
+
+std::vector<allocator_test_utils::block_layout_info> allocator_buddies_system::get_blocks_layout() const
+{
+    std::vector<allocator_test_utils::block_layout_info> layout;
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    for (size_t block_offset = 0; block_offset < metadata.space_size; block_offset += size_t(1) << get_block_at(_trusted_memory, block_offset)->power)
+    {
+        block_header *block = get_block_at(_trusted_memory, block_offset);
+        layout.push_back({
+            metadata_size + block_offset,
+            size_t(1) << block->power,
+            block->state == block_state::occupied,
+            block->fit_hits_count });
+    }
+    
+    return layout;
+}
+
+void allocator_buddies_system::snapshot_to(
+    int fd) const
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    write_image(fd, get_typename(), image_version, _trusted_memory, metadata_size + metadata.space_size);
+}
+
+void allocator_buddies_system::restore_from(
+    int fd)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    size_t image_size = read_image_size(fd, get_typename(), image_version);
+    if (image_size < metadata_size + min_block_size)
+    {
+        error_with_guard(get_typename() + "::restore_from: image is too small");
+        
+        throw std::runtime_error("allocator image is too small");
+    }
+    
+    // the image lives in the same parent allocator as the current trusted memory
+    void *image = allocate_with_guard(1, image_size);
+    try
+    {
+        read_image(fd, image, image_size);
+        if (metadata_size + get_metadata(image).space_size != image_size)
+        {
+            throw std::runtime_error("allocator image size does not match its metadata");
+        }
+        
+        if (!is_image_valid(image, image_size))
+        {
+            throw std::runtime_error("allocator image is corrupted");
+        }
+    }
+    catch (...)
+    {
+        deallocate_with_guard(image);
+        
+        throw;
+    }
+    
+    allocator_metadata &image_metadata = get_metadata(image);
+    image_metadata.parent_allocator = metadata.parent_allocator;
+    image_metadata.target_logger = metadata.target_logger;
+    rebase_image(image);
+    
+    {
+        // operations already running on the current image finish before it is released
+        std::lock_guard<std::mutex> lock(metadata.mutex);
+        std::swap(_trusted_memory, image);
+    }
+    
+    get_metadata(image).mutex.~mutex();
+    deallocate_with_guard(image);
+    
+    debug_with_guard(get_typename() + "::restore_from: " + std::to_string(image_size) + " bytes image restored");
+}
+
+bool allocator_buddies_system::is_image_valid(
+    void *trusted_memory,
+    size_t image_size)
+{
+    allocator_metadata &metadata = get_metadata(trusted_memory);
+    void const *old_base = metadata.trusted_memory;
+    
+    if (metadata.fit_mode > allocator_with_fit_mode::fit_mode::the_worst_fit || metadata.space_size % min_block_size != 0)
+    {
+        return false;
+    }
+    
+    // a block has to fit its own buddy tree and start at a multiple of its size, or the walks over the blocks go astray
+    std::vector<size_t> free_block_offsets;
+    for (size_t block_offset = 0; block_offset != metadata.space_size; block_offset += size_t(1) << get_block_at(trusted_memory, block_offset)->power)
+    {
+        block_header *block = get_block_at(trusted_memory, block_offset);
+        if (block->power < min_block_power || block->power > get_tree_power(metadata.space_size, block_offset)
+            || block_offset % (size_t(1) << block->power) != 0)
+        {
+            return false;
+        }
+        
+        if (block->state == block_state::free && block->owner == nullptr)
+        {
+            free_block_offsets.push_back(block_offset);
+        }
+        else if (block->state != block_state::occupied || block->owner != old_base)
+        {
+            return false;
+        }
+    }
+    
+    // every listed block links back to its predecessor, so no list can loop within the free blocks count
+    size_t listed_blocks_count = 0;
+    for (size_t power = 0; power <= max_power; ++power)
+    {
+        block_header *previous = nullptr;
+        for (block_header *link = metadata.free_blocks[power]; link != nullptr; ++listed_blocks_count)
+        {
+            size_t block_offset = get_image_offset(link, old_base, image_size) - metadata_size;
+            if (listed_blocks_count == free_block_offsets.size()
+                || !std::binary_search(free_block_offsets.begin(), free_block_offsets.end(), block_offset))
+            {
+                return false;
+            }
+            
+            block_header *block = get_block_at(trusted_memory, block_offset);
+            if (block->power != power || get_links(block).previous != previous)
+            {
+                return false;
+            }
+            
+            previous = link;
+            link = get_links(block).next;
+        }
+    }
+    
+    return listed_blocks_count == free_block_offsets.size();
+}
+
+void allocator_buddies_system::rebase_image(
+    void *trusted_memory) noexcept
+{
+    allocator_metadata &metadata = *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    void const *old_base = metadata.trusted_memory;
+    size_t image_size = metadata_size + metadata.space_size;
+    auto rebase = [old_base, image_size, trusted_memory](auto *pointer)
+    {
+        return reinterpret_cast<decltype(pointer)>(relocate(pointer, old_base, image_size, trusted_memory));
+    };
+    
+    new (&metadata.mutex) std::mutex;
+    metadata.trusted_memory = trusted_memory;
+    for (auto &free_block: metadata.free_blocks)
+    {
+        free_block = rebase(free_block);
+    }
+    
+    for (size_t block_offset = 0; block_offset < metadata.space_size; block_offset += size_t(1) << get_block_at(trusted_memory, block_offset)->power)
+    {
+        block_header *block = get_block_at(trusted_memory, block_offset);
+        block->owner = rebase(block->owner);
+        if (block->state == block_state::free)
+        {
+            free_block_links &links = get_links(block);
+            links.previous = rebase(links.previous);
+            links.next = rebase(links.next);
+        }
+    }
 }
 
 inline logger *allocator_buddies_system::get_logger() const
 {
-    throw not_implemented("inline logger *allocator_buddies_system::get_logger() const", "your code should be here...");
+    return _trusted_memory == nullptr
+        ? nullptr
+        : get_metadata(_trusted_memory).target_logger;
 }
 
 inline std::string allocator_buddies_system::get_typename() const noexcept
 {
-    throw not_implemented("inline std::string allocator_buddies_system::get_typename() const noexcept", "your code should be here...");
+    return "allocator_buddies_system";
 }
\ No newline at end of file
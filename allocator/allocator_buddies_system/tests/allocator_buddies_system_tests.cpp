@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <unistd.h>
 #include <cmath>
 #include <allocator.h>
 #include <allocator_buddies_system.h>
+#include <allocator_std_adapter.h>
 #include <client_logger_builder.h>
 #include <logger.h>
 #include <logger_builder.h>
@@ -99,7 +102,7 @@ TEST(positiveTests, test3)
     allocator_instance->deallocate(first_block);
     
     auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(allocator_instance)->get_blocks_info();
-    ASSERT_EQ(actual_blocks_state.size(), 3);
+    ASSERT_EQ(actual_blocks_state.size(), 4);
     ASSERT_EQ(actual_blocks_state[0].block_size, 1 << (static_cast<int>(std::floor(std::log2(sizeof(allocator::block_pointer_t) * 2 + 1))) + 1));
     ASSERT_EQ(actual_blocks_state[0].is_block_occupied, false);
     ASSERT_EQ(actual_blocks_state[0].block_size, actual_blocks_state[1].block_size);
@@ -110,6 +113,107 @@ TEST(positiveTests, test3)
     delete allocator_instance;
 }
 
+TEST(positiveTests, test4)
+{
+    allocator *allocator_instance = new allocator_buddies_system(8, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto result = allocator_instance->allocate_at_least(sizeof(unsigned char), 40);
+    
+    auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(allocator_instance)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state[0].block_size, 64);
+    ASSERT_EQ(actual_blocks_state[0].is_block_occupied, true);
+    ASSERT_GE(result.size, 40);
+    ASSERT_LT(result.size, 64);
+    
+    allocator_instance->deallocate(result.pointer);
+    
+    allocator_std_adapter<int> adapter(allocator_instance);
+    auto adapted_result = adapter.allocate_at_least(10);
+    ASSERT_GE(adapted_result.count, 10);
+    adapter.deallocate(adapted_result.ptr, adapted_result.count);
+    
+    delete allocator_instance;
+}
+
+TEST(positiveTests, test5)
+{
+    allocator *allocator_instance = new allocator_buddies_system(allocator_buddies_system::space_size_in_bytes { 5120 }, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(allocator_instance)->get_blocks_info();
+    std::vector<allocator_test_utils::block_info> expected_blocks_state
+        {
+            { .block_size = 4096, .is_block_occupied = false },
+            { .block_size = 1024, .is_block_occupied = false }
+        };
+    
+    ASSERT_EQ(actual_blocks_state.size(), expected_blocks_state.size());
+    for (int i = 0; i < actual_blocks_state.size(); i++)
+    {
+        ASSERT_EQ(actual_blocks_state[i], expected_blocks_state[i]);
+    }
+    
+    void *first_block = allocator_instance->allocate(sizeof(unsigned char), 40);
+    
+    actual_blocks_state = dynamic_cast<allocator_test_utils *>(allocator_instance)->get_blocks_info();
+    expected_blocks_state =
+        {
+            { .block_size = 4096, .is_block_occupied = false },
+            { .block_size = 64, .is_block_occupied = true },
+            { .block_size = 64, .is_block_occupied = false },
+            { .block_size = 128, .is_block_occupied = false },
+            { .block_size = 256, .is_block_occupied = false },
+            { .block_size = 512, .is_block_occupied = false }
+        };
+    
+    ASSERT_EQ(actual_blocks_state.size(), expected_blocks_state.size());
+    for (int i = 0; i < actual_blocks_state.size(); i++)
+    {
+        ASSERT_EQ(actual_blocks_state[i], expected_blocks_state[i]);
+    }
+    
+    allocator_instance->deallocate(first_block);
+    
+    delete allocator_instance;
+}
+
+TEST(positiveTests, test6)
+{
+    allocator_buddies_system subject(12, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto first_block = subject.allocate(sizeof(int), 50);
+    auto second_block = subject.allocate(sizeof(char), 300);
+    auto third_block = subject.allocate(sizeof(int), 20);
+    auto occupied_blocks_state = subject.get_blocks_info();
+    subject.deallocate(second_block);
+    
+    auto expected_blocks_state = subject.get_blocks_info();
+    
+    // the copy walks its own relocated free lists and leaves the source arena untouched
+    allocator_buddies_system copy(subject);
+    ASSERT_EQ(copy.get_blocks_info(), expected_blocks_state);
+    (void)copy.allocate(sizeof(char), 300);
+    ASSERT_EQ(copy.get_blocks_info(), occupied_blocks_state);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    FILE *image = tmpfile();
+    ASSERT_NE(image, nullptr);
+    subject.snapshot_to(fileno(image));
+    ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+    
+    allocator_buddies_system restored(12, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    restored.restore_from(fileno(image));
+    fclose(image);
+    ASSERT_EQ(restored.get_blocks_info(), expected_blocks_state);
+    (void)restored.allocate(sizeof(char), 300);
+    ASSERT_EQ(restored.get_blocks_info(), occupied_blocks_state);
+    
+    copy = subject;
+    ASSERT_EQ(copy.get_blocks_info(), expected_blocks_state);
+    
+    subject.deallocate(first_block);
+    subject.deallocate(third_block);
+}
+
 TEST(falsePositiveTests, test1)
 {
     ASSERT_THROW(new allocator_buddies_system(static_cast<int>(std::floor(std::log2(sizeof(allocator::block_pointer_t) * 2 + 1))) - 1), std::logic_error);
@@ -0,0 +1,60 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <allocator_test_utils.h>
+
+int main(
+    int argc,
+    char *argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <heap layout file> [request size in bytes]" << std::endl;
+        
+        return 1;
+    }
+    
+    try
+    {
+        std::ifstream layout_stream(argv[1], std::ios::binary);
+        if (!layout_stream)
+        {
+            throw std::runtime_error(std::string("can't open ") + argv[1]);
+        }
+        
+        auto layout = allocator_test_utils::import_layout(layout_stream);
+        auto statistics = allocator_test_utils::get_fragmentation_statistics(layout, argc == 3
+            ? std::stoull(argv[2])
+            : 0);
+        
+        std::cout << "blocks:              " << layout.size() << std::endl
+            << "total size:          " << statistics.total_size << std::endl
+            << "free size:           " << statistics.free_size << std::endl
+            << "free blocks:         " << statistics.free_blocks_count << std::endl
+            << "largest free block:  " << statistics.largest_free_block_size << std::endl;
+        
+        if (argc == 3)
+        {
+            std::cout << "unusable for " << statistics.request_size << " bytes: "
+                << statistics.unusable_free_size << " bytes ("
+                << std::fixed << std::setprecision(2) << statistics.get_unusable_free_percentage() << "% of free memory)" << std::endl;
+        }
+        
+        std::cout << "free blocks sizes histogram:" << std::endl;
+        for (auto const &bucket: statistics.free_blocks_sizes_histogram)
+        {
+            std::cout << "  [" << std::setw(10) << bucket.first << ", " << std::setw(10) << (bucket.first == 0 ? 1 : bucket.first * 2) << "): " << bucket.second << std::endl;
+        }
+    }
+    catch (std::exception const &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        
+        return 1;
+    }
+    
+    return 0;
+}
\ No newline at end of file
@@ -15,11 +15,16 @@ class allocator_global_heap final:
 private:
     
     logger *_logger;
+    
+    bool _cache_freed_blocks;
 
 public:
     
+    // with cache_freed_blocks set, freed blocks up to max_cached_block_size bytes are kept in per-thread
+    // size class bins and reused by the next allocation of that class instead of going back to ::operator delete
     explicit allocator_global_heap(
-        logger *logger = nullptr);
+        logger *logger = nullptr,
+        bool cache_freed_blocks = true);
     
     ~allocator_global_heap() override;
     
@@ -41,9 +46,24 @@ public:
         size_t value_size,
         size_t values_count) override;
     
+    [[nodiscard]] allocator::allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count) override;
+    
     void deallocate(
         void *at) override;
 
+public:
+    
+    static constexpr size_t size_class_granularity = 16;
+    
+    static constexpr size_t max_cached_block_size = 1024;
+    
+    static constexpr size_t max_cached_blocks_per_size_class = 64;
+    
+    // requests of at least this size are mapped from the OS directly
+    static constexpr size_t mmap_threshold = 128 * 1024;
+
 public:
     
     void foo()
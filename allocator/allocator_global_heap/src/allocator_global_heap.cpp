@@ -1,49 +1,256 @@
-#include <not_implemented.h>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_GLOBAL_HEAP_USE_MMAP
+#endif
 
 #include "../include/allocator_global_heap.h"
 
+namespace
+{
+    
+    enum class block_origin:
+        size_t
+    {
+        size_class_bin,
+        global_heap,
+        mapped
+    };
+    
+    struct block_metadata final
+    {
+        
+        allocator::block_size_t usable_size;
+        
+        block_origin origin;
+        
+    };
+    
+    constexpr size_t metadata_size = (sizeof(block_metadata) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    
+    constexpr size_t size_classes_count = allocator_global_heap::max_cached_block_size / allocator_global_heap::size_class_granularity;
+    
+    // trivially destructible, so it stays readable while and after the thread_local destructors run
+    thread_local bool are_bins_destroyed = false;
+    
+    // freed blocks are chained through their first payload bytes
+    struct size_class_bins final
+    {
+        
+        void *heads[size_classes_count] = {};
+        
+        size_t counts[size_classes_count] = {};
+        
+        // a thread_local object destroyed after the bins may still allocate or deallocate through the allocator,
+        // from then on the bins are bypassed in favour of the global heap
+        ~size_class_bins()
+        {
+            are_bins_destroyed = true;
+            
+            for (auto head: heads)
+            {
+                while (head != nullptr)
+                {
+                    void *next = *reinterpret_cast<void **>(reinterpret_cast<unsigned char *>(head) + metadata_size);
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+        
+    };
+    
+    thread_local size_class_bins bins;
+    
+    inline size_t size_class_index(
+        size_t size) noexcept
+    {
+        return size == 0
+            ? 0
+            : (size - 1) / allocator_global_heap::size_class_granularity;
+    }
+    
+}
+
 allocator_global_heap::allocator_global_heap(
-    logger *logger)
+    logger *logger,
+    bool cache_freed_blocks):
+    _logger(logger),
+    _cache_freed_blocks(cache_freed_blocks)
 {
-    throw not_implemented("allocator_global_heap::allocator_global_heap(logger *)", "your code should be here...");
+
 }
 
 allocator_global_heap::~allocator_global_heap()
 {
-    throw not_implemented("allocator_global_heap::~allocator_global_heap()", "your code should be here...");
+
 }
 
 allocator_global_heap::allocator_global_heap(
-    allocator_global_heap &&other) noexcept
+    allocator_global_heap &&other) noexcept:
+    _logger(other._logger),
+    _cache_freed_blocks(other._cache_freed_blocks)
 {
-    throw not_implemented("allocator_global_heap::allocator_global_heap(allocator_global_heap &&) noexcept", "your code should be here...");
+    other._logger = nullptr;
 }
 
 allocator_global_heap &allocator_global_heap::operator=(
     allocator_global_heap &&other) noexcept
 {
-    throw not_implemented("allocator_global_heap &allocator_global_heap::operator=(allocator_global_heap &&) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        _logger = other._logger;
+        _cache_freed_blocks = other._cache_freed_blocks;
+        other._logger = nullptr;
+    }
+    
+    return *this;
 }
 
 [[nodiscard]] void *allocator_global_heap::allocate(
     size_t value_size,
     size_t values_count)
 {
-    throw not_implemented("[[nodiscard]] void *allocator_global_heap::allocate(size_t, size_t)", "your code should be here...");
+    return allocate_at_least(value_size, values_count).pointer;
+}
+
+[[nodiscard]] allocator::allocation_result allocator_global_heap::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    if (values_count != 0 && value_size > (SIZE_MAX - metadata_size) / values_count)
+    {
+        if (_logger != nullptr)
+        {
+            error_with_guard(get_typename() + "::allocate: requested size overflows size_t");
+        }
+        
+        throw std::bad_alloc();
+    }
+    
+    size_t requested_size = value_size * values_count;
+    
+    void *block = nullptr;
+    block_metadata metadata;
+    
+    try
+    {
+        if (_cache_freed_blocks && requested_size <= max_cached_block_size && !are_bins_destroyed)
+        {
+            size_t index = size_class_index(requested_size);
+            
+            metadata = { (index + 1) * size_class_granularity, block_origin::size_class_bin };
+            
+            if (bins.heads[index] != nullptr)
+            {
+                block = bins.heads[index];
+                bins.heads[index] = *reinterpret_cast<void **>(reinterpret_cast<unsigned char *>(block) + metadata_size);
+                --bins.counts[index];
+            }
+            else
+            {
+                block = ::operator new(metadata_size + metadata.usable_size);
+            }
+        }
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_GLOBAL_HEAP_USE_MMAP
+        else if (requested_size >= mmap_threshold)
+        {
+            static size_t const page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            
+            size_t mapping_size = (metadata_size + requested_size + page_size - 1) / page_size * page_size;
+            
+            block = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (block == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            
+            metadata = { mapping_size - metadata_size, block_origin::mapped };
+        }
+#endif
+        else
+        {
+            block = ::operator new(metadata_size + requested_size);
+            metadata = { requested_size, block_origin::global_heap };
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        if (_logger != nullptr)
+        {
+            error_with_guard(get_typename() + "::allocate: can't allocate " + std::to_string(requested_size) + " bytes");
+        }
+        
+        throw;
+    }
+    
+    *reinterpret_cast<block_metadata *>(block) = metadata;
+    
+    if (_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::allocate: " + std::to_string(requested_size) + " bytes requested, " + std::to_string(metadata.usable_size) + " bytes allocated");
+    }
+    
+    return { reinterpret_cast<unsigned char *>(block) + metadata_size, metadata.usable_size };
 }
 
 void allocator_global_heap::deallocate(
     void *at)
 {
-    throw not_implemented("void allocator_global_heap::deallocate(void *)", "your code should be here...");
+    if (at == nullptr)
+    {
+        return;
+    }
+    
+    void *block = reinterpret_cast<unsigned char *>(at) - metadata_size;
+    block_metadata metadata = *reinterpret_cast<block_metadata *>(block);
+    
+    if (_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::deallocate: " + std::to_string(metadata.usable_size) + " bytes released");
+    }
+    
+    switch (metadata.origin)
+    {
+        case block_origin::size_class_bin:
+        {
+            size_t index = size_class_index(metadata.usable_size);
+            
+            if (_cache_freed_blocks && !are_bins_destroyed && bins.counts[index] < max_cached_blocks_per_size_class)
+            {
+                *reinterpret_cast<void **>(at) = bins.heads[index];
+                bins.heads[index] = block;
+                ++bins.counts[index];
+                
+                return;
+            }
+            
+            ::operator delete(block);
+            
+            return;
+        }
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_GLOBAL_HEAP_USE_MMAP
+        case block_origin::mapped:
+            munmap(block, metadata_size + metadata.usable_size);
+            
+            return;
+#endif
+        default:
+            ::operator delete(block);
+    }
 }
 
 inline logger *allocator_global_heap::get_logger() const
 {
-    throw not_implemented("inline logger *allocator_global_heap::get_logger() const", "your code should be here...");
+    return _logger;
 }
 
 inline std::string allocator_global_heap::get_typename() const noexcept
 {
-    throw not_implemented("inline std::string allocator_global_heap::get_typename() const noexcept", "your code should be here...");
+    return "allocator_global_heap";
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <iostream>
+#include <thread>
 #include <allocator_global_heap.h>
 #include <client_logger_builder.h>
 #include <logger.h>
@@ -120,6 +121,72 @@ TEST(allocatorGlobalHeapTests, test5)
     delete allocator_instance;
 }
 
+TEST(allocatorGlobalHeapTests, test6)
+{
+    allocator *allocator_instance = new allocator_global_heap;
+    
+    auto first_block = allocator_instance->allocate(sizeof(int), 10);
+    allocator_instance->deallocate(first_block);
+    auto second_block = allocator_instance->allocate(sizeof(char), 33);
+    ASSERT_EQ(first_block, second_block);
+    
+    auto result = allocator_instance->allocate_at_least(sizeof(char), 33);
+    ASSERT_EQ(result.size, 48);
+    
+    auto huge_block = reinterpret_cast<unsigned char *>(allocator_instance->allocate(sizeof(unsigned char), allocator_global_heap::mmap_threshold));
+    huge_block[0] = huge_block[allocator_global_heap::mmap_threshold - 1] = 0xFF;
+    
+    allocator_instance->deallocate(huge_block);
+    allocator_instance->deallocate(result.pointer);
+    allocator_instance->deallocate(second_block);
+    
+    delete allocator_instance;
+    
+    allocator_instance = new allocator_global_heap(nullptr, false);
+    
+    result = allocator_instance->allocate_at_least(sizeof(char), 33);
+    ASSERT_EQ(result.size, 33);
+    allocator_instance->deallocate(result.pointer);
+    
+    delete allocator_instance;
+}
+
+TEST(allocatorGlobalHeapTests, test7)
+{
+    // constructed before the bins of its thread, so destroyed after them
+    struct late_releaser final
+    {
+        
+        allocator_global_heap *allocator_instance = nullptr;
+        
+        void *block = nullptr;
+        
+        bool *is_released = nullptr;
+        
+        ~late_releaser()
+        {
+            allocator_instance->deallocate(block);
+            block = allocator_instance->allocate(sizeof(char), 33);
+            allocator_instance->deallocate(block);
+            *is_released = true;
+        }
+        
+    };
+    
+    allocator_global_heap allocator_instance;
+    bool is_released = false;
+    
+    std::thread([&allocator_instance, &is_released]()
+    {
+        thread_local late_releaser releaser;
+        releaser.allocator_instance = &allocator_instance;
+        releaser.is_released = &is_released;
+        releaser.block = allocator_instance.allocate(sizeof(char), 33);
+    }).join();
+    
+    ASSERT_TRUE(is_released);
+}
+
 class A final
 {
 
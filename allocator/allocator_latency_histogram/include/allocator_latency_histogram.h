@@ -0,0 +1,179 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_LATENCY_HISTOGRAM_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <allocator.h>
+
+// wraps any allocator and records allocate/deallocate latencies per operation and per size class;
+// the size class of a block is kept in a small header in front of it, so deallocate needs no lookup.
+// built without MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED it only forwards calls
+// and keeps neither headers nor histograms
+class allocator_latency_histogram final:
+    public allocator
+{
+
+public:
+    
+    enum class operation
+    {
+        allocate,
+        deallocate
+    };
+    
+    // log-bucketed (HDR-style) histogram of nanosecond latencies: 2^precision_bits linear sub-buckets
+    // per power of two, so any reported value is within 1/2^precision_bits of the recorded one
+    class histogram final
+    {
+    
+    public:
+        
+        static constexpr unsigned precision_bits = 4;
+        
+        static constexpr size_t sub_buckets_count = size_t(1) << precision_bits;
+        
+        static constexpr size_t buckets_count = (64 - precision_bits + 1) * sub_buckets_count;
+    
+    private:
+        
+        std::atomic<uint64_t> _counts[buckets_count];
+        
+        std::atomic<uint64_t> _total_count;
+        
+        std::atomic<uint64_t> _max_value;
+    
+    public:
+        
+        histogram() noexcept;
+        
+        histogram(
+            histogram const &other) noexcept;
+        
+        histogram &operator=(
+            histogram const &other) noexcept;
+    
+    public:
+        
+        void record(
+            uint64_t value) noexcept;
+        
+        void merge(
+            histogram const &other) noexcept;
+        
+        void reset() noexcept;
+    
+    public:
+        
+        uint64_t get_total_count() const noexcept;
+        
+        uint64_t get_max_value() const noexcept;
+        
+        // percentile in [0, 100]; returns the highest value equivalent to the bucket holding it
+        uint64_t get_value_at_percentile(
+            double percentile) const noexcept;
+    
+    private:
+        
+        static size_t bucket_index(
+            uint64_t value) noexcept;
+        
+        static uint64_t highest_equivalent_value(
+            size_t index) noexcept;
+        
+    };
+
+public:
+    
+    // size class i holds requests of [2^(i - 1), 2^i) bytes, size class 0 holds empty requests
+    static constexpr size_t size_classes_count = 65;
+
+private:
+    
+    allocator *_target_allocator;
+
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    
+    // 2 * size_classes_count histograms of ~8 KB each, indexed by operation first
+    std::unique_ptr<histogram[]> _histograms;
+
+#endif
+
+public:
+    
+    explicit allocator_latency_histogram(
+        allocator *target_allocator);
+    
+    ~allocator_latency_histogram() override = default;
+    
+    allocator_latency_histogram(
+        allocator_latency_histogram const &other) = delete;
+    
+    allocator_latency_histogram &operator=(
+        allocator_latency_histogram const &other) = delete;
+    
+    allocator_latency_histogram(
+        allocator_latency_histogram &&other) = delete;
+    
+    allocator_latency_histogram &operator=(
+        allocator_latency_histogram &&other) = delete;
+
+public:
+    
+    [[nodiscard]] void *allocate(
+        size_t value_size,
+        size_t values_count) override;
+    
+    [[nodiscard]] allocator::allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count) override;
+    
+    void deallocate(
+        void *at) override;
+
+public:
+    
+    static size_t size_class(
+        size_t size) noexcept;
+    
+    histogram const &get_histogram(
+        operation op,
+        size_t size_class) const noexcept;
+    
+    // all size classes of the operation merged together
+    histogram get_histogram(
+        operation op) const noexcept;
+    
+    void reset() noexcept;
+
+public:
+    
+    // one line per non-empty (operation, size class) with count, p50, p99, p99.9 and max in nanoseconds
+    void dump_text(
+        std::ostream &stream) const;
+    
+    void dump_json(
+        std::ostream &stream) const;
+
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+
+private:
+    
+    void record(
+        operation op,
+        size_t size_class,
+        uint64_t latency) noexcept;
+    
+    // bytes in front of every block handed out, the size class is stored there
+    static size_t get_header_size() noexcept;
+    
+    static size_t get_wrapped_size(
+        size_t value_size,
+        size_t values_count);
+
+#endif
+    
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_LATENCY_HISTOGRAM_H
\ No newline at end of file
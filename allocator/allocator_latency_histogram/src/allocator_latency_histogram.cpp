@@ -0,0 +1,411 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <new>
+
+#include "../include/allocator_latency_histogram.h"
+
+namespace
+{
+    
+    inline unsigned most_significant_bit(
+        uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned result = 0;
+        while (value >>= 1)
+        {
+            ++result;
+        }
+        
+        return result;
+#endif
+    }
+    
+    char const *operation_to_string(
+        allocator_latency_histogram::operation op) noexcept
+    {
+        return op == allocator_latency_histogram::operation::allocate
+            ? "allocate"
+            : "deallocate";
+    }
+    
+    void dump_size_class_bounds(
+        std::ostream &stream,
+        size_t size_class,
+        char const *separator)
+    {
+        stream << (size_class == 0 ? 0 : (uint64_t(1) << (size_class - 1))) << separator;
+        if (size_class == 64)
+        {
+            stream << "18446744073709551616";
+        }
+        else
+        {
+            stream << (uint64_t(1) << size_class);
+        }
+    }
+    
+}
+
+// region histogram implementation
+
+allocator_latency_histogram::histogram::histogram() noexcept
+{
+    reset();
+}
+
+allocator_latency_histogram::histogram::histogram(
+    histogram const &other) noexcept
+{
+    reset();
+    merge(other);
+}
+
+allocator_latency_histogram::histogram &allocator_latency_histogram::histogram::operator=(
+    histogram const &other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        merge(other);
+    }
+    
+    return *this;
+}
+
+void allocator_latency_histogram::histogram::record(
+    uint64_t value) noexcept
+{
+    _counts[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    _total_count.fetch_add(1, std::memory_order_relaxed);
+    
+    uint64_t max_value = _max_value.load(std::memory_order_relaxed);
+    while (value > max_value && !_max_value.compare_exchange_weak(max_value, value, std::memory_order_relaxed))
+    {
+        
+    }
+}
+
+void allocator_latency_histogram::histogram::merge(
+    histogram const &other) noexcept
+{
+    for (size_t i = 0; i < buckets_count; ++i)
+    {
+        uint64_t count = other._counts[i].load(std::memory_order_relaxed);
+        if (count != 0)
+        {
+            _counts[i].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+    
+    _total_count.fetch_add(other._total_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    
+    uint64_t other_max_value = other._max_value.load(std::memory_order_relaxed);
+    uint64_t max_value = _max_value.load(std::memory_order_relaxed);
+    while (other_max_value > max_value && !_max_value.compare_exchange_weak(max_value, other_max_value, std::memory_order_relaxed))
+    {
+        
+    }
+}
+
+void allocator_latency_histogram::histogram::reset() noexcept
+{
+    for (auto &count: _counts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+    
+    _total_count.store(0, std::memory_order_relaxed);
+    _max_value.store(0, std::memory_order_relaxed);
+}
+
+uint64_t allocator_latency_histogram::histogram::get_total_count() const noexcept
+{
+    return _total_count.load(std::memory_order_relaxed);
+}
+
+uint64_t allocator_latency_histogram::histogram::get_max_value() const noexcept
+{
+    return _max_value.load(std::memory_order_relaxed);
+}
+
+uint64_t allocator_latency_histogram::histogram::get_value_at_percentile(
+    double percentile) const noexcept
+{
+    uint64_t total_count = get_total_count();
+    if (total_count == 0)
+    {
+        return 0;
+    }
+    
+    auto target_count = static_cast<uint64_t>(std::ceil(percentile / 100 * total_count));
+    if (target_count == 0)
+    {
+        target_count = 1;
+    }
+    
+    uint64_t passed_count = 0;
+    for (size_t i = 0; i < buckets_count; ++i)
+    {
+        passed_count += _counts[i].load(std::memory_order_relaxed);
+        if (passed_count >= target_count)
+        {
+            uint64_t value = highest_equivalent_value(i);
+            
+            return value < get_max_value()
+                ? value
+                : get_max_value();
+        }
+    }
+    
+    return get_max_value();
+}
+
+size_t allocator_latency_histogram::histogram::bucket_index(
+    uint64_t value) noexcept
+{
+    if (value < sub_buckets_count)
+    {
+        return static_cast<size_t>(value);
+    }
+    
+    unsigned shift = most_significant_bit(value) - precision_bits;
+    
+    return (shift + 1) * sub_buckets_count + static_cast<size_t>((value >> shift) - sub_buckets_count);
+}
+
+uint64_t allocator_latency_histogram::histogram::highest_equivalent_value(
+    size_t index) noexcept
+{
+    if (index < sub_buckets_count)
+    {
+        return index;
+    }
+    
+    size_t shift = index / sub_buckets_count - 1;
+    uint64_t sub_bucket = index % sub_buckets_count + sub_buckets_count;
+    
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+// endregion histogram implementation
+
+allocator_latency_histogram::allocator_latency_histogram(
+    allocator *target_allocator):
+    _target_allocator(target_allocator)
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    , _histograms(new histogram[2 * size_classes_count])
+#endif
+{
+
+}
+
+[[nodiscard]] void *allocator_latency_histogram::allocate(
+    size_t value_size,
+    size_t values_count)
+{
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    size_t wrapped_size = get_wrapped_size(value_size, values_count);
+    
+    auto started_at = std::chrono::steady_clock::now();
+    auto *result = reinterpret_cast<unsigned char *>(_target_allocator->allocate(1, wrapped_size));
+    auto finished_at = std::chrono::steady_clock::now();
+    
+    size_t request_size_class = size_class(wrapped_size - get_header_size());
+    record(operation::allocate, request_size_class, std::chrono::duration_cast<std::chrono::nanoseconds>(finished_at - started_at).count());
+    *reinterpret_cast<size_t *>(result) = request_size_class;
+    
+    return result + get_header_size();
+#else
+    return _target_allocator->allocate(value_size, values_count);
+#endif
+}
+
+[[nodiscard]] allocator::allocation_result allocator_latency_histogram::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    size_t wrapped_size = get_wrapped_size(value_size, values_count);
+    
+    auto started_at = std::chrono::steady_clock::now();
+    auto result = _target_allocator->allocate_at_least(1, wrapped_size);
+    auto finished_at = std::chrono::steady_clock::now();
+    
+    size_t request_size_class = size_class(wrapped_size - get_header_size());
+    record(operation::allocate, request_size_class, std::chrono::duration_cast<std::chrono::nanoseconds>(finished_at - started_at).count());
+    *reinterpret_cast<size_t *>(result.pointer) = request_size_class;
+    
+    return { reinterpret_cast<unsigned char *>(result.pointer) + get_header_size(), result.size - get_header_size() };
+#else
+    return _target_allocator->allocate_at_least(value_size, values_count);
+#endif
+}
+
+void allocator_latency_histogram::deallocate(
+    void *at)
+{
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    if (at == nullptr)
+    {
+        return;
+    }
+    
+    void *block = reinterpret_cast<unsigned char *>(at) - get_header_size();
+    size_t request_size_class = *reinterpret_cast<size_t *>(block);
+    
+    auto started_at = std::chrono::steady_clock::now();
+    _target_allocator->deallocate(block);
+    auto finished_at = std::chrono::steady_clock::now();
+    
+    record(operation::deallocate, request_size_class, std::chrono::duration_cast<std::chrono::nanoseconds>(finished_at - started_at).count());
+#else
+    _target_allocator->deallocate(at);
+#endif
+}
+
+size_t allocator_latency_histogram::size_class(
+    size_t size) noexcept
+{
+    return size == 0
+        ? 0
+        : most_significant_bit(size) + 1;
+}
+
+allocator_latency_histogram::histogram const &allocator_latency_histogram::get_histogram(
+    operation op,
+    size_t size_class) const noexcept
+{
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    return _histograms[static_cast<size_t>(op) * size_classes_count + size_class];
+#else
+    static histogram const empty;
+    
+    return empty;
+#endif
+}
+
+allocator_latency_histogram::histogram allocator_latency_histogram::get_histogram(
+    operation op) const noexcept
+{
+    histogram result;
+    
+    for (size_t i = 0; i < size_classes_count; ++i)
+    {
+        result.merge(get_histogram(op, i));
+    }
+    
+    return result;
+}
+
+void allocator_latency_histogram::reset() noexcept
+{
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    for (size_t i = 0; i < 2 * size_classes_count; ++i)
+    {
+        _histograms[i].reset();
+    }
+#endif
+}
+
+void allocator_latency_histogram::dump_text(
+    std::ostream &stream) const
+{
+    for (auto op: { operation::allocate, operation::deallocate })
+    {
+        for (size_t i = 0; i < size_classes_count; ++i)
+        {
+            histogram const &target = get_histogram(op, i);
+            if (target.get_total_count() == 0)
+            {
+                continue;
+            }
+            
+            stream << operation_to_string(op) << " [";
+            dump_size_class_bounds(stream, i, ", ");
+            stream << ") count=" << target.get_total_count()
+                << " p50=" << target.get_value_at_percentile(50)
+                << " p99=" << target.get_value_at_percentile(99)
+                << " p99.9=" << target.get_value_at_percentile(99.9)
+                << " max=" << target.get_max_value() << std::endl;
+        }
+    }
+}
+
+void allocator_latency_histogram::dump_json(
+    std::ostream &stream) const
+{
+    stream << '{';
+    
+    for (auto op: { operation::allocate, operation::deallocate })
+    {
+        if (op == operation::deallocate)
+        {
+            stream << ',';
+        }
+        
+        stream << '"' << operation_to_string(op) << "\":[";
+        
+        bool is_first = true;
+        for (size_t i = 0; i < size_classes_count; ++i)
+        {
+            histogram const &target = get_histogram(op, i);
+            if (target.get_total_count() == 0)
+            {
+                continue;
+            }
+            
+            if (!is_first)
+            {
+                stream << ',';
+            }
+            is_first = false;
+            
+            stream << "{\"size_class\":[";
+            dump_size_class_bounds(stream, i, ",");
+            stream << "],\"count\":" << target.get_total_count()
+                << ",\"p50\":" << target.get_value_at_percentile(50)
+                << ",\"p99\":" << target.get_value_at_percentile(99)
+                << ",\"p99_9\":" << target.get_value_at_percentile(99.9)
+                << ",\"max\":" << target.get_max_value() << '}';
+        }
+        
+        stream << ']';
+    }
+    
+    stream << '}';
+}
+
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+
+void allocator_latency_histogram::record(
+    operation op,
+    size_t size_class,
+    uint64_t latency) noexcept
+{
+    _histograms[static_cast<size_t>(op) * size_classes_count + size_class].record(latency);
+}
+
+size_t allocator_latency_histogram::get_header_size() noexcept
+{
+    static_assert(sizeof(size_t) <= alignof(std::max_align_t), "size class header must keep the payload aligned");
+    
+    return alignof(std::max_align_t);
+}
+
+size_t allocator_latency_histogram::get_wrapped_size(
+    size_t value_size,
+    size_t values_count)
+{
+    if (values_count != 0 && value_size > (SIZE_MAX - get_header_size()) / values_count)
+    {
+        throw std::bad_alloc();
+    }
+    
+    return value_size * values_count + get_header_size();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <vector>
+#include <allocator_global_heap.h>
+#include <allocator_latency_histogram.h>
+
+TEST(allocatorLatencyHistogramTests, test1)
+{
+    allocator_latency_histogram::histogram subject;
+    
+    for (uint64_t value = 1; value <= 10000; ++value)
+    {
+        subject.record(value);
+    }
+    
+    ASSERT_EQ(subject.get_total_count(), 10000);
+    ASSERT_EQ(subject.get_max_value(), 10000);
+    ASSERT_EQ(subject.get_value_at_percentile(100), 10000);
+    
+    for (double percentile: { 50.0, 99.0, 99.9 })
+    {
+        auto expected = static_cast<uint64_t>(percentile * 100);
+        auto actual = subject.get_value_at_percentile(percentile);
+        
+        ASSERT_GE(actual, expected);
+        ASSERT_LE(actual, expected + expected / allocator_latency_histogram::histogram::sub_buckets_count);
+    }
+    
+    for (uint64_t value = 0; value < allocator_latency_histogram::histogram::sub_buckets_count; ++value)
+    {
+        allocator_latency_histogram::histogram exact;
+        exact.record(value);
+        ASSERT_EQ(exact.get_value_at_percentile(50), value);
+    }
+}
+
+TEST(allocatorLatencyHistogramTests, test2)
+{
+    allocator_global_heap target_allocator;
+    allocator_latency_histogram subject(&target_allocator);
+    
+    std::vector<void *> blocks;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        blocks.push_back(subject.allocate(sizeof(char), 24));
+    }
+    blocks.push_back(subject.allocate(sizeof(int), 1000));
+    
+    for (auto block: blocks)
+    {
+        subject.deallocate(block);
+    }
+
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    size_t small_size_class = allocator_latency_histogram::size_class(24);
+    size_t large_size_class = allocator_latency_histogram::size_class(4000);
+    
+    ASSERT_EQ(small_size_class, 5);
+    ASSERT_EQ(subject.get_histogram(allocator_latency_histogram::operation::allocate, small_size_class).get_total_count(), 1000);
+    ASSERT_EQ(subject.get_histogram(allocator_latency_histogram::operation::allocate, large_size_class).get_total_count(), 1);
+    ASSERT_EQ(subject.get_histogram(allocator_latency_histogram::operation::deallocate, small_size_class).get_total_count(), 1000);
+    ASSERT_EQ(subject.get_histogram(allocator_latency_histogram::operation::deallocate).get_total_count(), 1001);
+    
+    auto merged = subject.get_histogram(allocator_latency_histogram::operation::allocate);
+    ASSERT_LE(merged.get_value_at_percentile(50), merged.get_value_at_percentile(99));
+    ASSERT_LE(merged.get_value_at_percentile(99), merged.get_value_at_percentile(99.9));
+    ASSERT_LE(merged.get_value_at_percentile(99.9), merged.get_max_value());
+    
+    std::ostringstream text;
+    subject.dump_text(text);
+    ASSERT_NE(text.str().find("allocate [16, 32) count=1000 p50="), std::string::npos);
+    
+    std::ostringstream json;
+    subject.dump_json(json);
+    ASSERT_EQ(json.str().find("{\"allocate\":[{\"size_class\":[16,32],\"count\":1000,\"p50\":"), 0);
+    
+    subject.reset();
+    ASSERT_EQ(subject.get_histogram(allocator_latency_histogram::operation::allocate).get_total_count(), 0);
+#endif
+}
+
+TEST(allocatorLatencyHistogramTests, test3)
+{
+    allocator_global_heap target_allocator;
+    allocator_latency_histogram subject(&target_allocator);
+    
+    auto *block = reinterpret_cast<unsigned char *>(subject.allocate(sizeof(char), 40));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t), 0);
+    std::fill(block, block + 40, 0xAB);
+    
+    auto result = subject.allocate_at_least(sizeof(int), 100);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(result.pointer) % alignof(std::max_align_t), 0);
+    ASSERT_GE(result.size, sizeof(int) * 100);
+    
+    // the size class stored in front of each block survives writes to the payload
+    subject.deallocate(result.pointer);
+    subject.deallocate(block);
+    subject.deallocate(nullptr);
+
+#ifdef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_LATENCY_HISTOGRAM_ENABLED
+    ASSERT_EQ(subject.get_histogram(allocator_latency_histogram::operation::deallocate, allocator_latency_histogram::size_class(40)).get_total_count(), 1);
+    ASSERT_EQ(subject.get_histogram(allocator_latency_histogram::operation::deallocate, allocator_latency_histogram::size_class(400)).get_total_count(), 1);
+    ASSERT_EQ(subject.get_histogram(allocator_latency_histogram::operation::deallocate).get_total_count(), 2);
+#endif
+    
+    ASSERT_THROW((void)subject.allocate(SIZE_MAX / 2, 3), std::bad_alloc);
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
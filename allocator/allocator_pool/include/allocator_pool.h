@@ -0,0 +1,98 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_POOL_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_POOL_H
+
+#include <allocator.h>
+#include <allocator_guardant.h>
+#include <logger.h>
+#include <logger_guardant.h>
+#include <typename_holder.h>
+
+// fixed size blocks carved from slabs of the parent allocator; freed blocks are kept in a local
+// free list and handed out again, slabs go back to the parent only when the pool is destroyed.
+// meant for containers allocating one kind of node, e.g. search trees
+class allocator_pool final:
+    public allocator,
+    private allocator_guardant,
+    private logger_guardant,
+    private typename_holder
+{
+
+private:
+    
+    allocator *_parent_allocator;
+    
+    logger *_logger;
+    
+    size_t _block_size;
+    
+    size_t _blocks_per_slab;
+    
+    // slabs are chained through their first bytes
+    void *_slabs;
+    
+    unsigned char *_slab_top;
+    
+    unsigned char *_slab_end;
+    
+    // freed blocks are chained through their first bytes
+    void *_free_blocks;
+    
+    size_t _occupied_blocks_count;
+
+public:
+    
+    explicit allocator_pool(
+        size_t block_size,
+        size_t blocks_per_slab = 64,
+        allocator *parent_allocator = nullptr,
+        logger *logger = nullptr);
+    
+    ~allocator_pool() override;
+    
+    allocator_pool(
+        allocator_pool const &other) = delete;
+    
+    allocator_pool &operator=(
+        allocator_pool const &other) = delete;
+    
+    allocator_pool(
+        allocator_pool &&other) noexcept;
+    
+    allocator_pool &operator=(
+        allocator_pool &&other) noexcept;
+
+public:
+    
+    // requests bigger than the block size are rejected with std::bad_alloc
+    [[nodiscard]] void *allocate(
+        size_t value_size,
+        size_t values_count) override;
+    
+    [[nodiscard]] allocator::allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count) override;
+    
+    void deallocate(
+        void *at) override;
+
+public:
+    
+    size_t get_block_size() const noexcept;
+    
+    size_t get_occupied_blocks_count() const noexcept;
+
+private:
+    
+    inline allocator *get_allocator() const override;
+    
+    inline logger *get_logger() const override;
+    
+    inline std::string get_typename() const noexcept override;
+
+private:
+    
+    void release_slabs() noexcept;
+    
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_POOL_H
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "../include/allocator_pool.h"
+
+namespace
+{
+    
+    constexpr size_t block_alignment = alignof(std::max_align_t);
+    
+    constexpr size_t align_up(
+        size_t value) noexcept
+    {
+        return (value + block_alignment - 1) / block_alignment * block_alignment;
+    }
+    
+    // slab header keeps the next slab pointer, the first block starts on the next aligned boundary
+    constexpr size_t slab_header_size = align_up(sizeof(void *));
+    
+}
+
+allocator_pool::allocator_pool(
+    size_t block_size,
+    size_t blocks_per_slab,
+    allocator *parent_allocator,
+    logger *logger):
+    _parent_allocator(parent_allocator),
+    _logger(logger),
+    _block_size(align_up(std::max(block_size, sizeof(void *)))),
+    _blocks_per_slab(std::max<size_t>(blocks_per_slab, 1)),
+    _slabs(nullptr),
+    _slab_top(nullptr),
+    _slab_end(nullptr),
+    _free_blocks(nullptr),
+    _occupied_blocks_count(0)
+{
+
+}
+
+allocator_pool::~allocator_pool()
+{
+    if (_occupied_blocks_count != 0)
+    {
+        warning_with_guard(get_typename() + "::~allocator_pool: " + std::to_string(_occupied_blocks_count) + " blocks have not been deallocated");
+    }
+    
+    release_slabs();
+}
+
+allocator_pool::allocator_pool(
+    allocator_pool &&other) noexcept:
+    _parent_allocator(other._parent_allocator),
+    _logger(other._logger),
+    _block_size(other._block_size),
+    _blocks_per_slab(other._blocks_per_slab),
+    _slabs(std::exchange(other._slabs, nullptr)),
+    _slab_top(std::exchange(other._slab_top, nullptr)),
+    _slab_end(std::exchange(other._slab_end, nullptr)),
+    _free_blocks(std::exchange(other._free_blocks, nullptr)),
+    _occupied_blocks_count(std::exchange(other._occupied_blocks_count, 0))
+{
+
+}
+
+allocator_pool &allocator_pool::operator=(
+    allocator_pool &&other) noexcept
+{
+    if (this != &other)
+    {
+        release_slabs();
+        
+        _parent_allocator = other._parent_allocator;
+        _logger = other._logger;
+        _block_size = other._block_size;
+        _blocks_per_slab = other._blocks_per_slab;
+        _slabs = std::exchange(other._slabs, nullptr);
+        _slab_top = std::exchange(other._slab_top, nullptr);
+        _slab_end = std::exchange(other._slab_end, nullptr);
+        _free_blocks = std::exchange(other._free_blocks, nullptr);
+        _occupied_blocks_count = std::exchange(other._occupied_blocks_count, 0);
+    }
+    
+    return *this;
+}
+
+[[nodiscard]] void *allocator_pool::allocate(
+    size_t value_size,
+    size_t values_count)
+{
+    return allocate_at_least(value_size, values_count).pointer;
+}
+
+[[nodiscard]] allocator::allocation_result allocator_pool::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    if (values_count != 0 && value_size > _block_size / values_count)
+    {
+        error_with_guard(get_typename() + "::allocate: " + std::to_string(value_size) + " * " + std::to_string(values_count) + " bytes do not fit into a " + std::to_string(_block_size) + " bytes block");
+        
+        throw std::bad_alloc();
+    }
+    
+    void *block;
+    
+    if (_free_blocks != nullptr)
+    {
+        block = _free_blocks;
+        _free_blocks = *reinterpret_cast<void **>(block);
+    }
+    else
+    {
+        if (_slab_top == _slab_end)
+        {
+            size_t slab_size = slab_header_size + block_alignment + _block_size * _blocks_per_slab;
+            
+            void *slab;
+            try
+            {
+                slab = allocate_with_guard(1, slab_size);
+            }
+            catch (std::bad_alloc const &)
+            {
+                error_with_guard(get_typename() + "::allocate: can't get a slab of " + std::to_string(slab_size) + " bytes from the parent allocator");
+                
+                throw;
+            }
+            
+            *reinterpret_cast<void **>(slab) = _slabs;
+            _slabs = slab;
+            
+            // the parent allocator does not have to align blocks as strictly as we do
+            _slab_top = reinterpret_cast<unsigned char *>(align_up(reinterpret_cast<uintptr_t>(slab) + slab_header_size));
+            _slab_end = _slab_top + _block_size * _blocks_per_slab;
+        }
+        
+        block = _slab_top;
+        _slab_top += _block_size;
+    }
+    
+    ++_occupied_blocks_count;
+    
+    return { block, _block_size };
+}
+
+void allocator_pool::deallocate(
+    void *at)
+{
+    if (at == nullptr)
+    {
+        return;
+    }
+    
+    *reinterpret_cast<void **>(at) = _free_blocks;
+    _free_blocks = at;
+    --_occupied_blocks_count;
+}
+
+size_t allocator_pool::get_block_size() const noexcept
+{
+    return _block_size;
+}
+
+size_t allocator_pool::get_occupied_blocks_count() const noexcept
+{
+    return _occupied_blocks_count;
+}
+
+inline allocator *allocator_pool::get_allocator() const
+{
+    return _parent_allocator;
+}
+
+inline logger *allocator_pool::get_logger() const
+{
+    return _logger;
+}
+
+inline std::string allocator_pool::get_typename() const noexcept
+{
+    return "allocator_pool";
+}
+
+void allocator_pool::release_slabs() noexcept
+{
+    while (_slabs != nullptr)
+    {
+        void *next_slab = *reinterpret_cast<void **>(_slabs);
+        deallocate_with_guard(_slabs);
+        _slabs = next_slab;
+    }
+    
+    _slab_top = _slab_end = nullptr;
+    _free_blocks = nullptr;
+    _occupied_blocks_count = 0;
+}
\ No newline at end of file
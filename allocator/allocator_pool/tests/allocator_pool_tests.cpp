@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+
+#include "../include/allocator_pool.h"
+
+class counting_allocator final:
+    public allocator
+{
+
+public:
+    
+    size_t allocations_count = 0;
+    
+    size_t deallocations_count = 0;
+
+public:
+    
+    [[nodiscard]] void *allocate(
+        size_t value_size,
+        size_t values_count) override
+    {
+        ++allocations_count;
+        
+        return ::operator new(value_size * values_count);
+    }
+    
+    void deallocate(
+        void *at) override
+    {
+        ++deallocations_count;
+        
+        ::operator delete(at);
+    }
+    
+};
+
+TEST(allocatorPoolPositiveTests, test1)
+{
+    allocator *alloc = new allocator_pool(24);
+    
+    auto first_block = alloc->allocate(24, 1);
+    auto second_block = alloc->allocate(8, 3);
+    
+    ASSERT_NE(first_block, second_block);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(first_block) % alignof(std::max_align_t), 0);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(second_block) % alignof(std::max_align_t), 0);
+    
+    alloc->deallocate(first_block);
+    ASSERT_EQ(alloc->allocate(sizeof(char), 1), first_block);
+    
+    ASSERT_EQ(dynamic_cast<allocator_pool *>(alloc)->get_occupied_blocks_count(), 2);
+    ASSERT_GE(dynamic_cast<allocator_pool *>(alloc)->get_block_size(), 24);
+    
+    alloc->deallocate(first_block);
+    alloc->deallocate(second_block);
+    
+    delete alloc;
+}
+
+TEST(allocatorPoolPositiveTests, test2)
+{
+    counting_allocator parent;
+    
+    {
+        allocator_pool pool(40, 16, &parent);
+        
+        std::set<void *> blocks;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            ASSERT_TRUE(blocks.insert(pool.allocate(40, 1)).second);
+        }
+        
+        ASSERT_EQ(parent.allocations_count, 7);
+        
+        for (auto block: blocks)
+        {
+            pool.deallocate(block);
+        }
+        
+        for (size_t i = 0; i < 100; ++i)
+        {
+            ASSERT_EQ(blocks.count(pool.allocate(40, 1)), 1);
+        }
+        
+        ASSERT_EQ(parent.allocations_count, 7);
+        ASSERT_EQ(parent.deallocations_count, 0);
+    }
+    
+    ASSERT_EQ(parent.deallocations_count, 7);
+}
+
+TEST(allocatorPoolNegativeTests, test1)
+{
+    allocator_pool pool(32);
+    
+    ASSERT_THROW((void)pool.allocate(sizeof(int), 100), std::bad_alloc);
+    ASSERT_THROW((void)pool.allocate(SIZE_MAX, 2), std::bad_alloc);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <allocator_guardant.h>
 #include <allocator_test_utils.h>
 #include <allocator_with_fit_mode.h>
+#include <allocator_with_snapshot.h>
 #include <logger_guardant.h>
 #include <typename_holder.h>
 
@@ -11,6 +12,7 @@ class allocator_red_black_tree final:
     private allocator_guardant,
     public allocator_test_utils,
     public allocator_with_fit_mode,
+    public allocator_with_snapshot,
     private logger_guardant,
     private typename_holder
 {
@@ -49,6 +51,10 @@ public:
         size_t value_size,
         size_t values_count) override;
     
+    [[nodiscard]] allocator::allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count) override;
+    
     void deallocate(
         void *at) override;
 
@@ -57,6 +63,14 @@ public:
     inline void set_fit_mode(
         allocator_with_fit_mode::fit_mode mode) override;
 
+public:
+    
+    // every free block node keeps the max free block size of its subtree, fixed up along rotations
+    // and on the path to the root, so the root value answers in O(1) whether a request can be served
+    // at all, worst fit takes the block found by this value and first fit descends into the leftmost
+    // subtree whose max is big enough
+    size_t get_largest_free_block_size() const noexcept;
+
 private:
     
     inline allocator *get_allocator() const override;
@@ -64,6 +78,27 @@ private:
 public:
     
     std::vector<allocator_test_utils::block_info> get_blocks_info() const noexcept override;
+    
+    std::vector<allocator_test_utils::block_layout_info> get_blocks_layout() const override;
+
+public:
+    
+    void snapshot_to(
+        int fd) const override;
+    
+    void restore_from(
+        int fd) override;
+
+private:
+    
+    // makes a byte copy of a trusted memory image usable at its own address
+    static void rebase_image(
+        void *trusted_memory) noexcept;
+    
+    // checks the sizes and links of a freshly read image before rebase_image walks it
+    static bool is_image_valid(
+        void *trusted_memory,
+        size_t image_size);
 
 private:
     
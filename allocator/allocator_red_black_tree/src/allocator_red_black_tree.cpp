@@ -1,34 +1,601 @@
-#include <not_implemented.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "../include/allocator_red_black_tree.h"
 
+namespace
+{
+    
+    enum class block_state:
+        uint8_t
+    {
+        free,
+        occupied
+    };
+    
+    struct block_header final
+    {
+        
+        // header included
+        size_t block_size;
+        
+        // physically previous block, nullptr for the first one
+        block_header *previous_block;
+        
+        // trusted memory for an occupied block, nullptr for a free one
+        void *owner;
+        
+        uint32_t fit_hits_count;
+        
+        block_state state;
+        
+        // colour of a free block node
+        bool is_red;
+        
+    };
+    
+    // free blocks form an address ordered red-black tree, the node lives in the first payload bytes
+    struct free_block_node final
+    {
+        
+        block_header *left;
+        
+        block_header *right;
+        
+        block_header *parent;
+        
+        // max block size over the subtree rooted at this node
+        size_t subtree_max_size;
+        
+    };
+    
+    struct allocator_metadata final
+    {
+        
+        // occupied blocks are tagged with it
+        void *trusted_memory;
+        
+        allocator *parent_allocator;
+        
+        logger *target_logger;
+        
+        // blocks area only, metadata excluded
+        size_t space_size;
+        
+        allocator_with_fit_mode::fit_mode fit_mode;
+        
+        std::mutex mutex;
+        
+        block_header *root;
+        
+        // root subtree max published after every tree change, so it can be read without the lock
+        std::atomic<size_t> largest_free_block_size;
+        
+    };
+    
+    // bumped on every change of the metadata or block layout, snapshots of another layout are refused
+    constexpr uint32_t image_version = 1;
+    
+    constexpr size_t block_alignment = alignof(std::max_align_t);
+    
+    constexpr size_t align_up(
+        size_t value) noexcept
+    {
+        return (value + block_alignment - 1) / block_alignment * block_alignment;
+    }
+    
+    constexpr size_t metadata_size = align_up(sizeof(allocator_metadata));
+    
+    constexpr size_t block_header_size = align_up(sizeof(block_header));
+    
+    // every block has to be able to become a tree node once released
+    constexpr size_t min_block_size = block_header_size + align_up(sizeof(free_block_node));
+    
+    inline allocator_metadata &get_metadata(
+        void *trusted_memory) noexcept
+    {
+        return *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    }
+    
+    inline block_header *get_first_block(
+        void *trusted_memory) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(trusted_memory) + metadata_size);
+    }
+    
+    inline void *get_blocks_end(
+        void *trusted_memory) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(trusted_memory) + metadata_size + get_metadata(trusted_memory).space_size;
+    }
+    
+    inline block_header *get_next_block(
+        block_header *block) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(block) + block->block_size);
+    }
+    
+    inline void *get_payload(
+        block_header *block) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(block) + block_header_size;
+    }
+    
+    inline block_header *get_block(
+        void *payload) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(payload) - block_header_size);
+    }
+    
+    inline free_block_node &get_node(
+        block_header *block) noexcept
+    {
+        return *reinterpret_cast<free_block_node *>(get_payload(block));
+    }
+    
+    // region red-black tree of free blocks
+    
+    inline size_t get_subtree_max_size(
+        block_header *block) noexcept
+    {
+        return block == nullptr
+            ? 0
+            : get_node(block).subtree_max_size;
+    }
+    
+    inline bool is_red(
+        block_header *block) noexcept
+    {
+        return block != nullptr && block->is_red;
+    }
+    
+    inline void update_subtree_max_size(
+        block_header *block) noexcept
+    {
+        free_block_node &node = get_node(block);
+        node.subtree_max_size = std::max({ block->block_size, get_subtree_max_size(node.left), get_subtree_max_size(node.right) });
+    }
+    
+    void update_subtree_max_sizes_up(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        for (; block != nullptr; block = get_node(block).parent)
+        {
+            update_subtree_max_size(block);
+        }
+        
+        metadata.largest_free_block_size.store(get_subtree_max_size(metadata.root), std::memory_order_release);
+    }
+    
+    void replace_child(
+        allocator_metadata &metadata,
+        block_header *parent,
+        block_header *child,
+        block_header *replacement) noexcept
+    {
+        if (parent == nullptr)
+        {
+            metadata.root = replacement;
+        }
+        else if (get_node(parent).left == child)
+        {
+            get_node(parent).left = replacement;
+        }
+        else
+        {
+            get_node(parent).right = replacement;
+        }
+        
+        if (replacement != nullptr)
+        {
+            get_node(replacement).parent = parent;
+        }
+    }
+    
+    // a rotation keeps the key set of the rotated subtree, so only the two rotated nodes get their max recomputed
+    void rotate_left(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        free_block_node &node = get_node(block);
+        block_header *pivot = node.right;
+        free_block_node &pivot_node = get_node(pivot);
+        
+        node.right = pivot_node.left;
+        if (node.right != nullptr)
+        {
+            get_node(node.right).parent = block;
+        }
+        
+        replace_child(metadata, node.parent, block, pivot);
+        pivot_node.left = block;
+        node.parent = pivot;
+        
+        update_subtree_max_size(block);
+        update_subtree_max_size(pivot);
+    }
+    
+    void rotate_right(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        free_block_node &node = get_node(block);
+        block_header *pivot = node.left;
+        free_block_node &pivot_node = get_node(pivot);
+        
+        node.left = pivot_node.right;
+        if (node.left != nullptr)
+        {
+            get_node(node.left).parent = block;
+        }
+        
+        replace_child(metadata, node.parent, block, pivot);
+        pivot_node.right = block;
+        node.parent = pivot;
+        
+        update_subtree_max_size(block);
+        update_subtree_max_size(pivot);
+    }
+    
+    void insert_free_block(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        block_header *parent = nullptr;
+        for (block_header *current = metadata.root; current != nullptr; )
+        {
+            parent = current;
+            current = block < current
+                ? get_node(current).left
+                : get_node(current).right;
+        }
+        
+        block->owner = nullptr;
+        block->state = block_state::free;
+        block->is_red = true;
+        get_node(block) = { nullptr, nullptr, parent, block->block_size };
+        
+        if (parent == nullptr)
+        {
+            metadata.root = block;
+        }
+        else if (block < parent)
+        {
+            get_node(parent).left = block;
+        }
+        else
+        {
+            get_node(parent).right = block;
+        }
+        
+        update_subtree_max_sizes_up(metadata, parent);
+        
+        while (is_red(get_node(block).parent))
+        {
+            parent = get_node(block).parent;
+            block_header *grandparent = get_node(parent).parent;
+            bool parent_is_left = get_node(grandparent).left == parent;
+            block_header *uncle = parent_is_left
+                ? get_node(grandparent).right
+                : get_node(grandparent).left;
+            
+            if (is_red(uncle))
+            {
+                parent->is_red = false;
+                uncle->is_red = false;
+                grandparent->is_red = true;
+                block = grandparent;
+                
+                continue;
+            }
+            
+            if (parent_is_left && get_node(parent).right == block)
+            {
+                rotate_left(metadata, parent);
+                std::swap(block, parent);
+            }
+            else if (!parent_is_left && get_node(parent).left == block)
+            {
+                rotate_right(metadata, parent);
+                std::swap(block, parent);
+            }
+            
+            parent->is_red = false;
+            grandparent->is_red = true;
+            parent_is_left
+                ? rotate_right(metadata, grandparent)
+                : rotate_left(metadata, grandparent);
+        }
+        
+        metadata.root->is_red = false;
+    }
+    
+    void remove_free_block(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        free_block_node &node = get_node(block);
+        block_header *child;
+        block_header *child_parent;
+        bool removed_is_red = block->is_red;
+        
+        if (node.left == nullptr || node.right == nullptr)
+        {
+            child = node.left == nullptr
+                ? node.right
+                : node.left;
+            child_parent = node.parent;
+            replace_child(metadata, node.parent, block, child);
+        }
+        else
+        {
+            block_header *successor = node.right;
+            while (get_node(successor).left != nullptr)
+            {
+                successor = get_node(successor).left;
+            }
+            
+            free_block_node &successor_node = get_node(successor);
+            removed_is_red = successor->is_red;
+            child = successor_node.right;
+            
+            if (successor_node.parent == block)
+            {
+                child_parent = successor;
+            }
+            else
+            {
+                child_parent = successor_node.parent;
+                replace_child(metadata, successor_node.parent, successor, child);
+                successor_node.right = node.right;
+                get_node(successor_node.right).parent = successor;
+            }
+            
+            replace_child(metadata, node.parent, block, successor);
+            successor_node.left = node.left;
+            get_node(successor_node.left).parent = successor;
+            successor->is_red = block->is_red;
+        }
+        
+        // the successor, if moved, lies on the path from child_parent to the root
+        update_subtree_max_sizes_up(metadata, child_parent);
+        
+        if (removed_is_red)
+        {
+            return;
+        }
+        
+        while (child != metadata.root && !is_red(child))
+        {
+            free_block_node &parent_node = get_node(child_parent);
+            
+            if (parent_node.left == child)
+            {
+                block_header *sibling = parent_node.right;
+                if (is_red(sibling))
+                {
+                    sibling->is_red = false;
+                    child_parent->is_red = true;
+                    rotate_left(metadata, child_parent);
+                    sibling = parent_node.right;
+                }
+                
+                if (!is_red(get_node(sibling).left) && !is_red(get_node(sibling).right))
+                {
+                    sibling->is_red = true;
+                    child = child_parent;
+                    child_parent = parent_node.parent;
+                    
+                    continue;
+                }
+                
+                if (!is_red(get_node(sibling).right))
+                {
+                    get_node(sibling).left->is_red = false;
+                    sibling->is_red = true;
+                    rotate_right(metadata, sibling);
+                    sibling = parent_node.right;
+                }
+                
+                sibling->is_red = child_parent->is_red;
+                child_parent->is_red = false;
+                get_node(sibling).right->is_red = false;
+                rotate_left(metadata, child_parent);
+            }
+            else
+            {
+                block_header *sibling = parent_node.left;
+                if (is_red(sibling))
+                {
+                    sibling->is_red = false;
+                    child_parent->is_red = true;
+                    rotate_right(metadata, child_parent);
+                    sibling = parent_node.left;
+                }
+                
+                if (!is_red(get_node(sibling).left) && !is_red(get_node(sibling).right))
+                {
+                    sibling->is_red = true;
+                    child = child_parent;
+                    child_parent = parent_node.parent;
+                    
+                    continue;
+                }
+                
+                if (!is_red(get_node(sibling).left))
+                {
+                    get_node(sibling).right->is_red = false;
+                    sibling->is_red = true;
+                    rotate_left(metadata, sibling);
+                    sibling = parent_node.left;
+                }
+                
+                sibling->is_red = child_parent->is_red;
+                child_parent->is_red = false;
+                get_node(sibling).left->is_red = false;
+                rotate_right(metadata, child_parent);
+            }
+            
+            child = metadata.root;
+        }
+        
+        if (child != nullptr)
+        {
+            child->is_red = false;
+        }
+    }
+    
+    // lowest address block that fits: O(log n), the subtree max prunes every subtree without a fitting block
+    block_header *find_first_fit(
+        block_header *block,
+        size_t block_size) noexcept
+    {
+        while (block != nullptr)
+        {
+            free_block_node &node = get_node(block);
+            if (get_subtree_max_size(node.left) >= block_size)
+            {
+                block = node.left;
+            }
+            else if (block->block_size >= block_size)
+            {
+                return block;
+            }
+            else
+            {
+                block = node.right;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    // the tree is ordered by address, not by size, so the best fit visits every subtree whose max fits
+    block_header *find_best_fit(
+        block_header *block,
+        size_t block_size,
+        block_header *best = nullptr) noexcept
+    {
+        while (block != nullptr && get_subtree_max_size(block) >= block_size)
+        {
+            if (block->block_size >= block_size && (best == nullptr || block->block_size < best->block_size))
+            {
+                best = block;
+                if (best->block_size == block_size)
+                {
+                    return best;
+                }
+            }
+            
+            best = find_best_fit(get_node(block).left, block_size, best);
+            block = get_node(block).right;
+        }
+        
+        return best;
+    }
+    
+    // follows the subtree max down to the lowest address block of the max size: O(log n)
+    block_header *find_worst_fit(
+        block_header *block) noexcept
+    {
+        size_t max_size = get_subtree_max_size(block);
+        
+        while (block != nullptr)
+        {
+            free_block_node &node = get_node(block);
+            if (get_subtree_max_size(node.left) == max_size)
+            {
+                block = node.left;
+            }
+            else if (block->block_size == max_size)
+            {
+                return block;
+            }
+            else
+            {
+                block = node.right;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    // endregion red-black tree of free blocks
+    
+}
+
 allocator_red_black_tree::~allocator_red_black_tree()
 {
-    throw not_implemented("allocator_red_black_tree::~allocator_red_black_tree()", "your code should be here...");
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    get_metadata(_trusted_memory).mutex.~mutex();
+    deallocate_with_guard(_trusted_memory);
 }
 
 allocator_red_black_tree::allocator_red_black_tree(
-    allocator_red_black_tree const &other)
+    allocator_red_black_tree const &other):
+    _trusted_memory(nullptr)
 {
-    throw not_implemented("allocator_red_black_tree::allocator_red_black_tree(allocator_red_black_tree const &)", "your code should be here...");
+    if (other._trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &other_metadata = get_metadata(other._trusted_memory);
+    size_t image_size = metadata_size + other_metadata.space_size;
+    
+    _trusted_memory = other_metadata.parent_allocator == nullptr
+        ? ::operator new(image_size)
+        : other_metadata.parent_allocator->allocate(1, image_size);
+    
+    {
+        std::lock_guard<std::mutex> lock(other_metadata.mutex);
+        std::memcpy(_trusted_memory, other._trusted_memory, image_size);
+    }
+    
+    rebase_image(_trusted_memory);
 }
 
 allocator_red_black_tree &allocator_red_black_tree::operator=(
     allocator_red_black_tree const &other)
 {
-    throw not_implemented("allocator_red_black_tree &allocator_red_black_tree::operator=(allocator_red_black_tree const &)", "your code should be here...");
+    if (this != &other)
+    {
+        allocator_red_black_tree copy(other);
+        std::swap(_trusted_memory, copy._trusted_memory);
+    }
+    
+    return *this;
 }
 
 allocator_red_black_tree::allocator_red_black_tree(
-    allocator_red_black_tree &&other) noexcept
+    allocator_red_black_tree &&other) noexcept:
+    _trusted_memory(other._trusted_memory)
 {
-    throw not_implemented("allocator_red_black_tree::allocator_red_black_tree(allocator_red_black_tree &&) noexcept", "your code should be here...");
+    other._trusted_memory = nullptr;
 }
 
 allocator_red_black_tree &allocator_red_black_tree::operator=(
     allocator_red_black_tree &&other) noexcept
 {
-    throw not_implemented("allocator_red_black_tree &allocator_red_black_tree::operator=(allocator_red_black_tree &&) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        std::swap(_trusted_memory, other._trusted_memory);
+    }
+    
+    return *this;
 }
 
 allocator_red_black_tree::allocator_red_black_tree(
@@ -37,44 +604,411 @@ allocator_red_black_tree::allocator_red_black_tree(
     logger *logger,
     allocator_with_fit_mode::fit_mode allocate_fit_mode)
 {
-    throw not_implemented("allocator_red_black_tree::allocator_red_black_tree(size_t, allocator *, logger *, allocator_with_fit_mode::fit_mode)", "your code should be here...");
+    space_size = space_size / block_alignment * block_alignment;
+    if (space_size < min_block_size)
+    {
+        throw std::logic_error("allocator_red_black_tree: space size can't hold a single block");
+    }
+    
+    _trusted_memory = parent_allocator == nullptr
+        ? ::operator new(metadata_size + space_size)
+        : parent_allocator->allocate(1, metadata_size + space_size);
+    
+    allocator_metadata &metadata = *new (_trusted_memory) allocator_metadata;
+    metadata.trusted_memory = _trusted_memory;
+    metadata.parent_allocator = parent_allocator;
+    metadata.target_logger = logger;
+    metadata.space_size = space_size;
+    metadata.fit_mode = allocate_fit_mode;
+    metadata.root = nullptr;
+    
+    block_header &block = *get_first_block(_trusted_memory);
+    block.block_size = space_size;
+    block.previous_block = nullptr;
+    block.fit_hits_count = 0;
+    insert_free_block(metadata, &block);
+    
+    debug_with_guard(get_typename() + "::allocator_red_black_tree: " + std::to_string(space_size) + " bytes of blocks space");
 }
 
 [[nodiscard]] void *allocator_red_black_tree::allocate(
     size_t value_size,
     size_t values_count)
 {
-    throw not_implemented("[[nodiscard]] void *allocator_red_black_tree::allocate(size_t, size_t)", "your code should be here...");
+    return allocate_at_least(value_size, values_count).pointer;
+}
+
+[[nodiscard]] allocator::allocation_result allocator_red_black_tree::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    
+    if (values_count != 0 && value_size > (metadata.space_size - block_header_size) / values_count)
+    {
+        error_with_guard(get_typename() + "::allocate: requested size exceeds the blocks space");
+        
+        throw std::bad_alloc();
+    }
+    
+    size_t requested_size = value_size * values_count;
+    size_t block_size = std::max(align_up(block_header_size + requested_size), min_block_size);
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    // the root max answers without a descent whether any block fits
+    if (get_subtree_max_size(metadata.root) < block_size)
+    {
+        error_with_guard(get_typename() + "::allocate: no free block of " + std::to_string(block_size) + " bytes");
+        
+        throw std::bad_alloc();
+    }
+    
+    block_header *block;
+    switch (metadata.fit_mode)
+    {
+        case allocator_with_fit_mode::fit_mode::first_fit:
+            block = find_first_fit(metadata.root, block_size);
+            break;
+        case allocator_with_fit_mode::fit_mode::the_best_fit:
+            block = find_best_fit(metadata.root, block_size);
+            break;
+        default:
+            block = find_worst_fit(metadata.root);
+            break;
+    }
+    
+    remove_free_block(metadata, block);
+    
+    if (block->block_size - block_size >= min_block_size)
+    {
+        auto *remainder = reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(block) + block_size);
+        remainder->block_size = block->block_size - block_size;
+        remainder->previous_block = block;
+        remainder->fit_hits_count = 0;
+        
+        block_header *next_block = get_next_block(remainder);
+        if (next_block != get_blocks_end(_trusted_memory))
+        {
+            next_block->previous_block = remainder;
+        }
+        
+        block->block_size = block_size;
+        insert_free_block(metadata, remainder);
+    }
+    
+    block->state = block_state::occupied;
+    block->owner = _trusted_memory;
+    if (block->fit_hits_count != UINT32_MAX)
+    {
+        ++block->fit_hits_count;
+    }
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::allocate: " + std::to_string(requested_size) + " bytes requested, " + std::to_string(block->block_size) + " bytes block allocated");
+    }
+    
+    return { get_payload(block), block->block_size - block_header_size };
 }
 
 void allocator_red_black_tree::deallocate(
     void *at)
 {
-    throw not_implemented("void allocator_red_black_tree::deallocate(void *)", "your code should be here...");
+    if (at == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    block_header *block = get_block(at);
+    void *blocks_end = get_blocks_end(_trusted_memory);
+    
+    if (block < get_first_block(_trusted_memory) || block >= blocks_end
+        || block->owner != _trusted_memory || block->state != block_state::occupied)
+    {
+        error_with_guard(get_typename() + "::deallocate: block does not belong to the allocator or is already released");
+        
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::deallocate: " + std::to_string(block->block_size) + " bytes block released");
+    }
+    
+    block_header *next_block = get_next_block(block);
+    if (next_block != blocks_end && next_block->state == block_state::free)
+    {
+        remove_free_block(metadata, next_block);
+        block->block_size += next_block->block_size;
+    }
+    
+    block_header *previous_block = block->previous_block;
+    if (previous_block != nullptr && previous_block->state == block_state::free)
+    {
+        // the previous block keeps its address and its place in the tree, only the maxes up its path grow
+        previous_block->block_size += block->block_size;
+        block = previous_block;
+        update_subtree_max_sizes_up(metadata, block);
+    }
+    else
+    {
+        insert_free_block(metadata, block);
+    }
+    
+    next_block = get_next_block(block);
+    if (next_block != blocks_end)
+    {
+        next_block->previous_block = block;
+    }
 }
 
 inline void allocator_red_black_tree::set_fit_mode(
     allocator_with_fit_mode::fit_mode mode)
 {
-    throw not_implemented("inline void allocator_red_black_tree::set_fit_mode(allocator_with_fit_mode::fit_mode)", "your code should be here...");
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    metadata.fit_mode = mode;
+}
+
+size_t allocator_red_black_tree::get_largest_free_block_size() const noexcept
+{
+    return get_metadata(_trusted_memory).largest_free_block_size.load(std::memory_order_acquire);
 }
 
 inline allocator *allocator_red_black_tree::get_allocator() const
 {
-    throw not_implemented("inline allocator *allocator_red_black_tree::get_allocator() const", "your code should be here...");
+    return get_metadata(_trusted_memory).parent_allocator;
 }
 
 std::vector<allocator_test_utils::block_info> allocator_red_black_tree::get_blocks_info() const noexcept
 {
-    throw not_implemented("std::vector<allocator_test_utils::block_info> allocator_red_black_tree::get_blocks_info() const noexcept", "your code should be here...");
+    std::vector<allocator_test_utils::block_info> blocks_info;
+    
+    try
+    {
+        for (auto const &block: get_blocks_layout())
+        {
+            blocks_info.push_back({ block.block_size, block.is_block_occupied });
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        blocks_info.clear();
+    }
+    
+    return blocks_info;
+}
+
+std::vector<allocator_test_utils::block_layout_info> allocator_red_black_tree::get_blocks_layout() const
+{
+    std::vector<allocator_test_utils::block_layout_info> layout;
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    void *blocks_end = get_blocks_end(_trusted_memory);
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    for (block_header *block = get_first_block(_trusted_memory); block != blocks_end; block = get_next_block(block))
+    {
+        layout.push_back({
+            static_cast<size_t>(reinterpret_cast<unsigned char *>(block) - reinterpret_cast<unsigned char *>(_trusted_memory)),
+            block->block_size,
+            block->state == block_state::occupied,
+            block->fit_hits_count });
+    }
+    
+    return layout;
+}
+
+void allocator_red_black_tree::snapshot_to(
+    int fd) const
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    write_image(fd, get_typename(), image_version, _trusted_memory, metadata_size + metadata.space_size);
+}
+
+void allocator_red_black_tree::restore_from(
+    int fd)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    size_t image_size = read_image_size(fd, get_typename(), image_version);
+    if (image_size < metadata_size + min_block_size)
+    {
+        error_with_guard(get_typename() + "::restore_from: image is too small");
+        
+        throw std::runtime_error("allocator image is too small");
+    }
+    
+    // the image lives in the same parent allocator as the current trusted memory
+    void *image = allocate_with_guard(1, image_size);
+    try
+    {
+        read_image(fd, image, image_size);
+        if (metadata_size + get_metadata(image).space_size != image_size)
+        {
+            throw std::runtime_error("allocator image size does not match its metadata");
+        }
+        
+        if (!is_image_valid(image, image_size))
+        {
+            throw std::runtime_error("allocator image is corrupted");
+        }
+    }
+    catch (...)
+    {
+        deallocate_with_guard(image);
+        
+        throw;
+    }
+    
+    allocator_metadata &image_metadata = get_metadata(image);
+    image_metadata.parent_allocator = metadata.parent_allocator;
+    image_metadata.target_logger = metadata.target_logger;
+    rebase_image(image);
+    
+    {
+        // operations already running on the current image finish before it is released
+        std::lock_guard<std::mutex> lock(metadata.mutex);
+        std::swap(_trusted_memory, image);
+    }
+    
+    get_metadata(image).mutex.~mutex();
+    deallocate_with_guard(image);
+    
+    debug_with_guard(get_typename() + "::restore_from: " + std::to_string(image_size) + " bytes image restored");
+}
+
+bool allocator_red_black_tree::is_image_valid(
+    void *trusted_memory,
+    size_t image_size)
+{
+    allocator_metadata &metadata = get_metadata(trusted_memory);
+    void const *old_base = metadata.trusted_memory;
+    auto get_block_at = [trusted_memory](size_t block_offset)
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(trusted_memory) + block_offset);
+    };
+    
+    if (metadata.fit_mode > allocator_with_fit_mode::fit_mode::the_worst_fit)
+    {
+        return false;
+    }
+    
+    // a zero or oversized block size would send every walk over the blocks astray
+    std::vector<size_t> free_block_offsets;
+    size_t previous_block_offset = image_size;
+    for (size_t block_offset = metadata_size; block_offset != image_size; block_offset += get_block_at(block_offset)->block_size)
+    {
+        block_header *block = get_block_at(block_offset);
+        if (block->block_size < min_block_size || block->block_size % block_alignment != 0 || block->block_size > image_size - block_offset
+            || get_image_offset(block->previous_block, old_base, image_size) != previous_block_offset)
+        {
+            return false;
+        }
+        
+        if (block->state == block_state::free && block->owner == nullptr)
+        {
+            free_block_offsets.push_back(block_offset);
+        }
+        else if (block->state != block_state::occupied || block->owner != old_base)
+        {
+            return false;
+        }
+        
+        previous_block_offset = block_offset;
+    }
+    
+    // every node has to be a free block reached from its own parent and lie inside the address range its ancestors allow,
+    // so the tree can't loop and holds each free block once
+    struct pending_node final
+    {
+        
+        block_header *link;
+        
+        block_header *parent;
+        
+        size_t lower_offset;
+        
+        size_t upper_offset;
+        
+    };
+    
+    std::vector<pending_node> pending_nodes { { metadata.root, nullptr, 0, image_size } };
+    size_t nodes_count = 0;
+    while (!pending_nodes.empty())
+    {
+        pending_node pending = pending_nodes.back();
+        pending_nodes.pop_back();
+        if (pending.link == nullptr)
+        {
+            continue;
+        }
+        
+        size_t block_offset = get_image_offset(pending.link, old_base, image_size);
+        if (++nodes_count > free_block_offsets.size()
+            || block_offset <= pending.lower_offset || block_offset >= pending.upper_offset
+            || !std::binary_search(free_block_offsets.begin(), free_block_offsets.end(), block_offset))
+        {
+            return false;
+        }
+        
+        free_block_node &node = get_node(get_block_at(block_offset));
+        if (node.parent != pending.parent)
+        {
+            return false;
+        }
+        
+        pending_nodes.push_back({ node.left, pending.link, pending.lower_offset, block_offset });
+        pending_nodes.push_back({ node.right, pending.link, block_offset, pending.upper_offset });
+    }
+    
+    return nodes_count == free_block_offsets.size();
+}
+
+void allocator_red_black_tree::rebase_image(
+    void *trusted_memory) noexcept
+{
+    allocator_metadata &metadata = *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    void const *old_base = metadata.trusted_memory;
+    size_t image_size = metadata_size + metadata.space_size;
+    auto rebase = [old_base, image_size, trusted_memory](auto *pointer)
+    {
+        return reinterpret_cast<decltype(pointer)>(relocate(pointer, old_base, image_size, trusted_memory));
+    };
+    
+    new (&metadata.mutex) std::mutex;
+    metadata.trusted_memory = trusted_memory;
+    metadata.root = rebase(metadata.root);
+    
+    void *blocks_end = get_blocks_end(trusted_memory);
+    for (block_header *block = get_first_block(trusted_memory); block != blocks_end; block = get_next_block(block))
+    {
+        block->previous_block = rebase(block->previous_block);
+        block->owner = rebase(block->owner);
+        if (block->state == block_state::free)
+        {
+            free_block_node &node = get_node(block);
+            node.left = rebase(node.left);
+            node.right = rebase(node.right);
+            node.parent = rebase(node.parent);
+        }
+    }
 }
 
 inline logger *allocator_red_black_tree::get_logger() const
 {
-    throw not_implemented("inline logger *allocator_red_black_tree::get_logger() const", "your code should be here...");
+    return _trusted_memory == nullptr
+        ? nullptr
+        : get_metadata(_trusted_memory).target_logger;
 }
 
 inline std::string allocator_red_black_tree::get_typename() const noexcept
 {
-    throw not_implemented("inline std::string allocator_red_black_tree::get_typename() const noexcept", "your code should be here...");
+    return "allocator_red_black_tree";
 }
\ No newline at end of file
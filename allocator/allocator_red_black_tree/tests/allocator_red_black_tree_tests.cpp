@@ -1,4 +1,248 @@
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <unistd.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../include/allocator_red_black_tree.h"
+
+namespace
+{
+    
+    size_t get_largest_free_block_size_by_layout(
+        allocator_red_black_tree const &subject)
+    {
+        size_t largest = 0;
+        
+        for (auto const &block: subject.get_blocks_layout())
+        {
+            if (!block.is_block_occupied)
+            {
+                largest = std::max(largest, block.block_size);
+            }
+        }
+        
+        return largest;
+    }
+    
+}
+
+TEST(allocatorRedBlackTreePositiveTests, test1)
+{
+    allocator_red_black_tree subject(4096, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto blocks = subject.get_blocks_info();
+    ASSERT_EQ(blocks.size(), 1);
+    ASSERT_EQ(blocks[0].block_size, 4096);
+    ASSERT_FALSE(blocks[0].is_block_occupied);
+    ASSERT_EQ(subject.get_largest_free_block_size(), 4096);
+    
+    void *first = subject.allocate(1, 100);
+    void *second = subject.allocate(1, 100);
+    void *third = subject.allocate(1, 100);
+    ASSERT_LT(first, second);
+    ASSERT_LT(second, third);
+    
+    subject.deallocate(second);
+    blocks = subject.get_blocks_info();
+    ASSERT_EQ(blocks.size(), 4);
+    ASSERT_FALSE(blocks[1].is_block_occupied);
+    
+    // the freed block merges with both neighbours back into one block
+    subject.deallocate(first);
+    subject.deallocate(third);
+    blocks = subject.get_blocks_info();
+    ASSERT_EQ(blocks.size(), 1);
+    ASSERT_EQ(subject.get_largest_free_block_size(), 4096);
+}
+
+TEST(allocatorRedBlackTreePositiveTests, test2)
+{
+    allocator_red_black_tree subject(4096, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    allocator_with_fit_mode &fit_mode_holder = subject;
+    
+    // holes of 256, 128 and 512 bytes separated by occupied blocks
+    void *spacers[4];
+    void *holes[3];
+    size_t const hole_sizes[] = { 256, 128, 512 };
+    for (size_t i = 0; i < 3; ++i)
+    {
+        spacers[i] = subject.allocate(1, 64);
+        holes[i] = subject.allocate(1, hole_sizes[i]);
+    }
+    spacers[3] = subject.allocate(1, 64);
+    
+    for (auto hole: holes)
+    {
+        subject.deallocate(hole);
+    }
+    
+    void *first_fit = subject.allocate(1, 100);
+    ASSERT_EQ(first_fit, holes[0]);
+    subject.deallocate(first_fit);
+    
+    fit_mode_holder.set_fit_mode(allocator_with_fit_mode::fit_mode::the_best_fit);
+    void *best_fit = subject.allocate(1, 100);
+    ASSERT_EQ(best_fit, holes[1]);
+    subject.deallocate(best_fit);
+    
+    // the trailing block is the largest one
+    fit_mode_holder.set_fit_mode(allocator_with_fit_mode::fit_mode::the_worst_fit);
+    void *worst_fit = subject.allocate(1, 100);
+    ASSERT_GT(worst_fit, spacers[3]);
+    subject.deallocate(worst_fit);
+    
+    for (auto spacer: spacers)
+    {
+        subject.deallocate(spacer);
+    }
+    
+    ASSERT_EQ(subject.get_blocks_info().size(), 1);
+}
+
+TEST(allocatorRedBlackTreePositiveTests, test3)
+{
+    allocator_red_black_tree subject(1 << 16, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    allocator_with_fit_mode &fit_mode_holder = subject;
+    
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<size_t> size_distribution(1, 700);
+    std::vector<void *> blocks;
+    
+    for (size_t step = 0; step < 5000; ++step)
+    {
+        fit_mode_holder.set_fit_mode(static_cast<allocator_with_fit_mode::fit_mode>(step % 3));
+        
+        if (!blocks.empty() && engine() % 2 == 0)
+        {
+            size_t index = engine() % blocks.size();
+            subject.deallocate(blocks[index]);
+            blocks[index] = blocks.back();
+            blocks.pop_back();
+        }
+        else
+        {
+            size_t size = size_distribution(engine);
+            if (size + 32 > subject.get_largest_free_block_size())
+            {
+                ASSERT_THROW((void)subject.allocate(1, subject.get_largest_free_block_size()), std::bad_alloc);
+                
+                continue;
+            }
+            
+            blocks.push_back(subject.allocate(1, size));
+        }
+        
+        ASSERT_EQ(subject.get_largest_free_block_size(), get_largest_free_block_size_by_layout(subject));
+        
+        auto layout = subject.get_blocks_layout();
+        for (size_t i = 1; i < layout.size(); ++i)
+        {
+            ASSERT_EQ(layout[i - 1].block_offset + layout[i - 1].block_size, layout[i].block_offset);
+            ASSERT_FALSE(!layout[i - 1].is_block_occupied && !layout[i].is_block_occupied);
+        }
+    }
+    
+    for (auto block: blocks)
+    {
+        subject.deallocate(block);
+    }
+    
+    ASSERT_EQ(subject.get_blocks_info().size(), 1);
+}
+
+TEST(allocatorRedBlackTreePositiveTests, test4)
+{
+    allocator_red_black_tree subject(2000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto first_block = subject.allocate(sizeof(int), 50);
+    auto second_block = subject.allocate(sizeof(char), 300);
+    auto third_block = subject.allocate(sizeof(int), 20);
+    auto occupied_blocks_state = subject.get_blocks_info();
+    subject.deallocate(second_block);
+    
+    auto expected_blocks_state = subject.get_blocks_info();
+    
+    // the copy walks its own relocated free lists and leaves the source arena untouched
+    allocator_red_black_tree copy(subject);
+    ASSERT_EQ(copy.get_blocks_info(), expected_blocks_state);
+    (void)copy.allocate(sizeof(char), 300);
+    ASSERT_EQ(copy.get_blocks_info(), occupied_blocks_state);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    FILE *image = tmpfile();
+    ASSERT_NE(image, nullptr);
+    subject.snapshot_to(fileno(image));
+    ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+    
+    allocator_red_black_tree restored(2000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    restored.restore_from(fileno(image));
+    fclose(image);
+    ASSERT_EQ(restored.get_blocks_info(), expected_blocks_state);
+    (void)restored.allocate(sizeof(char), 300);
+    ASSERT_EQ(restored.get_blocks_info(), occupied_blocks_state);
+    
+    copy = subject;
+    ASSERT_EQ(copy.get_blocks_info(), expected_blocks_state);
+    
+    subject.deallocate(first_block);
+    subject.deallocate(third_block);
+}
+
+TEST(allocatorRedBlackTreeNegativeTests, test1)
+{
+    allocator_red_black_tree subject(1024, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    ASSERT_THROW((void)subject.allocate(1, 2048), std::bad_alloc);
+    
+    void *block = subject.allocate(1, 900);
+    ASSERT_LT(subject.get_largest_free_block_size(), 100);
+    ASSERT_THROW((void)subject.allocate(1, 100), std::bad_alloc);
+    
+    subject.deallocate(block);
+    ASSERT_EQ(subject.get_largest_free_block_size(), 1024);
+    
+    ASSERT_THROW(allocator_red_black_tree(16), std::logic_error);
+}
+
+TEST(allocatorRedBlackTreeNegativeTests, test2)
+{
+    allocator_red_black_tree subject(2000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto block = subject.allocate(sizeof(int), 50);
+    auto layout = subject.get_blocks_layout();
+    auto expected_blocks_state = subject.get_blocks_info();
+    
+    FILE *image = tmpfile();
+    ASSERT_NE(image, nullptr);
+    subject.snapshot_to(fileno(image));
+    
+    // the image header goes before the trusted memory bytes, and the block offsets count from the latter
+    off_t image_header_size = lseek(fileno(image), 0, SEEK_END) - static_cast<off_t>(layout.back().block_offset + layout.back().block_size);
+    auto restore_patched = [&subject, image](off_t position, uint64_t value)
+    {
+        uint64_t original_value;
+        ASSERT_EQ(pread(fileno(image), &original_value, sizeof(original_value), position), sizeof(original_value));
+        ASSERT_EQ(pwrite(fileno(image), &value, sizeof(value), position), sizeof(value));
+        ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+        ASSERT_THROW(subject.restore_from(fileno(image)), std::runtime_error);
+        ASSERT_EQ(pwrite(fileno(image), &original_value, sizeof(original_value), position), sizeof(original_value));
+    };
+    
+    // the type tag, the layout version and a zero size of the trailing block, which would loop every walk over the blocks
+    restore_patched(sizeof(uint64_t), 0);
+    restore_patched(sizeof(uint64_t) * 2, 2);
+    restore_patched(image_header_size + static_cast<off_t>(layout.back().block_offset), 0);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+    subject.restore_from(fileno(image));
+    fclose(image);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    subject.deallocate(block);
+}
 
 int main(
     int argc,
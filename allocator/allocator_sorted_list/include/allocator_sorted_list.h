@@ -1,9 +1,13 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_SORTED_LIST_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_SORTED_LIST_H
 
+#include <atomic>
+
 #include <allocator_guardant.h>
 #include <allocator_test_utils.h>
+#include <allocator_with_coalescing_mode.h>
 #include <allocator_with_fit_mode.h>
+#include <allocator_with_snapshot.h>
 #include <logger_guardant.h>
 #include <typename_holder.h>
 
@@ -11,6 +15,8 @@ class allocator_sorted_list final:
     private allocator_guardant,
     public allocator_test_utils,
     public allocator_with_fit_mode,
+    public allocator_with_coalescing_mode,
+    public allocator_with_snapshot,
     private logger_guardant,
     private typename_holder
 {
@@ -18,6 +24,9 @@ class allocator_sorted_list final:
 private:
     
     void *_trusted_memory;
+    
+    // set for this object, not for its memory: a copy or a moved-to allocator starts detached
+    std::atomic<allocator_maintenance_thread *> _maintenance_thread;
 
 public:
     
@@ -41,7 +50,8 @@ public:
         size_t space_size,
         allocator *parent_allocator = nullptr,
         logger *logger = nullptr,
-        allocator_with_fit_mode::fit_mode allocate_fit_mode = allocator_with_fit_mode::fit_mode::first_fit);
+        allocator_with_fit_mode::fit_mode allocate_fit_mode = allocator_with_fit_mode::fit_mode::first_fit,
+        allocator_with_coalescing_mode::coalescing_mode deallocate_coalescing_mode = allocator_with_coalescing_mode::coalescing_mode::immediate);
 
 public:
     
@@ -49,6 +59,10 @@ public:
         size_t value_size,
         size_t values_count) override;
     
+    [[nodiscard]] allocator::allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count) override;
+    
     void deallocate(
         void *at) override;
 
@@ -57,6 +71,22 @@ public:
     inline void set_fit_mode(
         allocator_with_fit_mode::fit_mode mode) override;
 
+public:
+    
+    inline void set_coalescing_mode(
+        allocator_with_coalescing_mode::coalescing_mode mode) override;
+    
+    void coalesce() override;
+    
+    void trim() override;
+    
+    size_t get_header_writes_count() const noexcept override;
+
+private:
+    
+    void set_maintenance_thread(
+        allocator_maintenance_thread *maintenance_thread) noexcept override;
+
 private:
     
     inline allocator *get_allocator() const override;
@@ -64,6 +94,27 @@ private:
 public:
     
     std::vector<allocator_test_utils::block_info> get_blocks_info() const noexcept override;
+    
+    std::vector<allocator_test_utils::block_layout_info> get_blocks_layout() const override;
+
+public:
+    
+    void snapshot_to(
+        int fd) const override;
+    
+    void restore_from(
+        int fd) override;
+
+private:
+    
+    // makes a byte copy of a trusted memory image usable at its own address
+    static void rebase_image(
+        void *trusted_memory) noexcept;
+    
+    // checks the sizes and links of a freshly read image before rebase_image walks it
+    static bool is_image_valid(
+        void *trusted_memory,
+        size_t image_size);
 
 private:
     
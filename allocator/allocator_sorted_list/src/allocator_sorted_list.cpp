@@ -1,80 +1,800 @@
-#include <not_implemented.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <allocator_maintenance_thread.h>
 
 #include "../include/allocator_sorted_list.h"
 
+namespace
+{
+    
+    enum class block_state:
+        size_t
+    {
+        free,
+        // freed in deferred coalescing mode, waits for the sweep in the parked list
+        parked,
+        occupied
+    };
+    
+    struct block_header final
+    {
+        
+        // header included
+        size_t block_size;
+        
+        // next free block for a free block, next parked block for a parked one,
+        // trusted memory for an occupied one
+        void *link;
+        
+        size_t fit_hits_count;
+        
+        block_state state;
+        
+    };
+    
+    struct allocator_metadata final
+    {
+        
+        // occupied blocks are tagged with it
+        void *trusted_memory;
+        
+        allocator *parent_allocator;
+        
+        logger *target_logger;
+        
+        // blocks area only, metadata excluded
+        size_t space_size;
+        
+        allocator_with_fit_mode::fit_mode fit_mode;
+        
+        allocator_with_coalescing_mode::coalescing_mode coalescing_mode;
+        
+        std::mutex mutex;
+        
+        block_header *first_free_block;
+        
+        block_header *first_parked_block;
+        
+        size_t parked_blocks_count;
+        
+        // size tag writes of the constructor, splits and merges
+        size_t header_writes_count;
+        
+    };
+    
+    // bumped on every change of the metadata or block layout, snapshots of another layout are refused
+    constexpr uint32_t image_version = 1;
+    
+    constexpr size_t block_alignment = alignof(std::max_align_t);
+    
+    constexpr size_t align_up(
+        size_t value) noexcept
+    {
+        return (value + block_alignment - 1) / block_alignment * block_alignment;
+    }
+    
+    constexpr size_t metadata_size = align_up(sizeof(allocator_metadata));
+    
+    constexpr size_t block_header_size = align_up(sizeof(block_header));
+    
+    // a split never leaves a remainder which can't hold at least one aligned payload unit
+    constexpr size_t min_block_size = block_header_size + block_alignment;
+    
+    inline allocator_metadata &get_metadata(
+        void *trusted_memory) noexcept
+    {
+        return *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    }
+    
+    inline block_header *get_first_block(
+        void *trusted_memory) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(trusted_memory) + metadata_size);
+    }
+    
+    inline void *get_blocks_end(
+        void *trusted_memory) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(trusted_memory) + metadata_size + get_metadata(trusted_memory).space_size;
+    }
+    
+    inline block_header *get_next_block(
+        block_header *block) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(block) + block->block_size);
+    }
+    
+    inline void *get_payload(
+        block_header *block) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(block) + block_header_size;
+    }
+    
+    inline block_header *get_block(
+        void *payload) noexcept
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(payload) - block_header_size);
+    }
+    
+    // one address ordered pass: every run of adjacent free and parked blocks becomes one free block
+    // and the free list is relinked from scratch, the parked list gets empty
+    void merge_free_blocks(
+        void *trusted_memory) noexcept
+    {
+        allocator_metadata &metadata = get_metadata(trusted_memory);
+        void *blocks_end = get_blocks_end(trusted_memory);
+        block_header **free_list_tail = &metadata.first_free_block;
+        block_header *run = nullptr;
+        
+        for (block_header *block = get_first_block(trusted_memory); block != blocks_end; block = get_next_block(block))
+        {
+            if (block->state == block_state::occupied)
+            {
+                run = nullptr;
+                
+                continue;
+            }
+            
+            if (run != nullptr)
+            {
+                run->block_size += block->block_size;
+                ++metadata.header_writes_count;
+                
+                continue;
+            }
+            
+            run = block;
+            run->state = block_state::free;
+            *free_list_tail = run;
+            free_list_tail = reinterpret_cast<block_header **>(&run->link);
+        }
+        
+        *free_list_tail = nullptr;
+        metadata.first_parked_block = nullptr;
+        metadata.parked_blocks_count = 0;
+    }
+    
+    // returns the block preceding the found one in the free list through previous_block
+    block_header *find_free_block(
+        allocator_metadata const &metadata,
+        size_t block_size,
+        block_header *&previous_block) noexcept
+    {
+        block_header *found = nullptr;
+        block_header *previous = nullptr;
+        previous_block = nullptr;
+        
+        for (block_header *block = metadata.first_free_block; block != nullptr; previous = block, block = reinterpret_cast<block_header *>(block->link))
+        {
+            if (block->block_size < block_size)
+            {
+                continue;
+            }
+            
+            if (found == nullptr
+                || (metadata.fit_mode == allocator_with_fit_mode::fit_mode::the_best_fit && block->block_size < found->block_size)
+                || (metadata.fit_mode == allocator_with_fit_mode::fit_mode::the_worst_fit && block->block_size > found->block_size))
+            {
+                found = block;
+                previous_block = previous;
+                
+                if (metadata.fit_mode == allocator_with_fit_mode::fit_mode::first_fit
+                    || (metadata.fit_mode == allocator_with_fit_mode::fit_mode::the_best_fit && block->block_size == block_size))
+                {
+                    break;
+                }
+            }
+        }
+        
+        return found;
+    }
+    
+    // parked blocks are reused only by a request of their own size, so a miss here never splits anything
+    block_header *take_parked_block(
+        allocator_metadata &metadata,
+        size_t block_size) noexcept
+    {
+        for (block_header **link = &metadata.first_parked_block; *link != nullptr; link = reinterpret_cast<block_header **>(&(*link)->link))
+        {
+            block_header *block = *link;
+            if (block->block_size >= block_size && block->block_size < block_size + min_block_size)
+            {
+                *link = reinterpret_cast<block_header *>(block->link);
+                --metadata.parked_blocks_count;
+                
+                return block;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    // the freed block is linked into its place in the address ordered free list and merged with its free neighbours
+    void insert_free_block(
+        allocator_metadata &metadata,
+        block_header *block) noexcept
+    {
+        block_header *previous = nullptr;
+        block_header *next = metadata.first_free_block;
+        while (next != nullptr && next < block)
+        {
+            previous = next;
+            next = reinterpret_cast<block_header *>(next->link);
+        }
+        
+        block->state = block_state::free;
+        block->link = next;
+        
+        if (next != nullptr && get_next_block(block) == next)
+        {
+            block->block_size += next->block_size;
+            block->link = next->link;
+            ++metadata.header_writes_count;
+        }
+        
+        if (previous != nullptr && get_next_block(previous) == block)
+        {
+            previous->block_size += block->block_size;
+            previous->link = block->link;
+            ++metadata.header_writes_count;
+            
+            return;
+        }
+        
+        (previous == nullptr
+            ? metadata.first_free_block
+            : *reinterpret_cast<block_header **>(&previous->link)) = block;
+    }
+    
+}
+
 allocator_sorted_list::~allocator_sorted_list()
 {
-    throw not_implemented("allocator_sorted_list::~allocator_sorted_list()", "your code should be here...");
+    // a moved from allocator is still attached, so this goes before the memory check
+    allocator_maintenance_thread *maintenance_thread = _maintenance_thread.load(std::memory_order_acquire);
+    if (maintenance_thread != nullptr)
+    {
+        maintenance_thread->detach(this);
+    }
+    
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    get_metadata(_trusted_memory).mutex.~mutex();
+    deallocate_with_guard(_trusted_memory);
 }
 
 allocator_sorted_list::allocator_sorted_list(
-    allocator_sorted_list const &other)
+    allocator_sorted_list const &other):
+    _trusted_memory(nullptr),
+    _maintenance_thread(nullptr)
 {
-    throw not_implemented("allocator_sorted_list::allocator_sorted_list(allocator_sorted_list const &)", "your code should be here...");
+    if (other._trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &other_metadata = get_metadata(other._trusted_memory);
+    size_t image_size = metadata_size + other_metadata.space_size;
+    
+    _trusted_memory = other_metadata.parent_allocator == nullptr
+        ? ::operator new(image_size)
+        : other_metadata.parent_allocator->allocate(1, image_size);
+    
+    {
+        std::lock_guard<std::mutex> lock(other_metadata.mutex);
+        std::memcpy(_trusted_memory, other._trusted_memory, image_size);
+    }
+    
+    rebase_image(_trusted_memory);
 }
 
 allocator_sorted_list &allocator_sorted_list::operator=(
     allocator_sorted_list const &other)
 {
-    throw not_implemented("allocator_sorted_list &allocator_sorted_list::operator=(allocator_sorted_list const &)", "your code should be here...");
+    if (this != &other)
+    {
+        allocator_sorted_list copy(other);
+        std::swap(_trusted_memory, copy._trusted_memory);
+    }
+    
+    return *this;
 }
 
 allocator_sorted_list::allocator_sorted_list(
-    allocator_sorted_list &&other) noexcept
+    allocator_sorted_list &&other) noexcept:
+    _trusted_memory(other._trusted_memory),
+    _maintenance_thread(nullptr)
 {
-    throw not_implemented("allocator_sorted_list::allocator_sorted_list(allocator_sorted_list &&) noexcept", "your code should be here...");
+    other._trusted_memory = nullptr;
 }
 
 allocator_sorted_list &allocator_sorted_list::operator=(
     allocator_sorted_list &&other) noexcept
 {
-    throw not_implemented("allocator_sorted_list &allocator_sorted_list::operator=(allocator_sorted_list &&) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        std::swap(_trusted_memory, other._trusted_memory);
+    }
+    
+    return *this;
 }
 
 allocator_sorted_list::allocator_sorted_list(
     size_t space_size,
     allocator *parent_allocator,
     logger *logger,
-    allocator_with_fit_mode::fit_mode allocate_fit_mode)
+    allocator_with_fit_mode::fit_mode allocate_fit_mode,
+    allocator_with_coalescing_mode::coalescing_mode deallocate_coalescing_mode):
+    _maintenance_thread(nullptr)
 {
-    throw not_implemented("allocator_sorted_list::allocator_sorted_list(size_t, allocator *, logger *, allocator_with_fit_mode::fit_mode)", "your code should be here...");
+    space_size = space_size / block_alignment * block_alignment;
+    if (space_size < min_block_size)
+    {
+        throw std::logic_error("allocator_sorted_list: space size can't hold a single block");
+    }
+    
+    _trusted_memory = parent_allocator == nullptr
+        ? ::operator new(metadata_size + space_size)
+        : parent_allocator->allocate(1, metadata_size + space_size);
+    
+    allocator_metadata &metadata = *new (_trusted_memory) allocator_metadata;
+    metadata.trusted_memory = _trusted_memory;
+    metadata.parent_allocator = parent_allocator;
+    metadata.target_logger = logger;
+    metadata.space_size = space_size;
+    metadata.fit_mode = allocate_fit_mode;
+    metadata.coalescing_mode = deallocate_coalescing_mode;
+    metadata.first_free_block = get_first_block(_trusted_memory);
+    metadata.first_parked_block = nullptr;
+    metadata.parked_blocks_count = 0;
+    metadata.header_writes_count = 1;
+    
+    block_header &block = *metadata.first_free_block;
+    block.block_size = space_size;
+    block.link = nullptr;
+    block.fit_hits_count = 0;
+    block.state = block_state::free;
+    
+    debug_with_guard(get_typename() + "::allocator_sorted_list: " + std::to_string(space_size) + " bytes of blocks space");
 }
 
 [[nodiscard]] void *allocator_sorted_list::allocate(
     size_t value_size,
     size_t values_count)
 {
-    throw not_implemented("[[nodiscard]] void *allocator_sorted_list::allocate(size_t, size_t)", "your code should be here...");
+    return allocate_at_least(value_size, values_count).pointer;
+}
+
+[[nodiscard]] allocator::allocation_result allocator_sorted_list::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    
+    if (values_count != 0 && value_size > (metadata.space_size - block_header_size) / values_count)
+    {
+        error_with_guard(get_typename() + "::allocate: requested size exceeds the blocks space");
+        
+        throw std::bad_alloc();
+    }
+    
+    size_t requested_size = value_size * values_count;
+    size_t block_size = std::max(align_up(block_header_size + requested_size), min_block_size);
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    block_header *block = metadata.coalescing_mode == allocator_with_coalescing_mode::coalescing_mode::deferred
+        ? take_parked_block(metadata, block_size)
+        : nullptr;
+    
+    if (block == nullptr)
+    {
+        block_header *previous_block;
+        block = find_free_block(metadata, block_size, previous_block);
+        
+        if (block == nullptr && metadata.parked_blocks_count != 0)
+        {
+            merge_free_blocks(_trusted_memory);
+            block = find_free_block(metadata, block_size, previous_block);
+        }
+        
+        if (block == nullptr)
+        {
+            error_with_guard(get_typename() + "::allocate: no free block of " + std::to_string(block_size) + " bytes");
+            
+            throw std::bad_alloc();
+        }
+        
+        void *next_free_block = block->link;
+        if (block->block_size - block_size >= min_block_size)
+        {
+            auto *remainder = reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(block) + block_size);
+            remainder->block_size = block->block_size - block_size;
+            remainder->link = next_free_block;
+            remainder->fit_hits_count = 0;
+            remainder->state = block_state::free;
+            
+            block->block_size = block_size;
+            next_free_block = remainder;
+            metadata.header_writes_count += 2;
+        }
+        
+        (previous_block == nullptr
+            ? metadata.first_free_block
+            : *reinterpret_cast<block_header **>(&previous_block->link)) = reinterpret_cast<block_header *>(next_free_block);
+    }
+    
+    block->state = block_state::occupied;
+    block->link = _trusted_memory;
+    ++block->fit_hits_count;
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::allocate: " + std::to_string(requested_size) + " bytes requested, " + std::to_string(block->block_size) + " bytes block allocated");
+    }
+    
+    return { get_payload(block), block->block_size - block_header_size };
 }
 
 void allocator_sorted_list::deallocate(
     void *at)
 {
-    throw not_implemented("void allocator_sorted_list::deallocate(void *)", "your code should be here...");
+    if (at == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    block_header *block = get_block(at);
+    
+    if (block < get_first_block(_trusted_memory) || block >= get_blocks_end(_trusted_memory)
+        || block->link != _trusted_memory || block->state != block_state::occupied)
+    {
+        error_with_guard(get_typename() + "::deallocate: block does not belong to the allocator or is already released");
+        
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::deallocate: " + std::to_string(block->block_size) + " bytes block released");
+    }
+    
+    if (metadata.coalescing_mode == allocator_with_coalescing_mode::coalescing_mode::immediate)
+    {
+        insert_free_block(metadata, block);
+        
+        return;
+    }
+    
+    block->state = block_state::parked;
+    block->link = metadata.first_parked_block;
+    metadata.first_parked_block = block;
+    
+    if (++metadata.parked_blocks_count > allocator_with_coalescing_mode::deferred_blocks_threshold)
+    {
+        // an attached thread is woken once per crossing and sweeps off the request thread;
+        // until it gets there allocate still sweeps inline when the quick lists can't serve a request
+        allocator_maintenance_thread *maintenance_thread = _maintenance_thread.load(std::memory_order_acquire);
+        if (maintenance_thread == nullptr)
+        {
+            merge_free_blocks(_trusted_memory);
+        }
+        else if (metadata.parked_blocks_count == allocator_with_coalescing_mode::deferred_blocks_threshold + 1)
+        {
+            maintenance_thread->request_maintenance();
+        }
+    }
 }
 
 inline void allocator_sorted_list::set_fit_mode(
     allocator_with_fit_mode::fit_mode mode)
 {
-    throw not_implemented("inline void allocator_sorted_list::set_fit_mode(allocator_with_fit_mode::fit_mode)", "your code should be here...");
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    metadata.fit_mode = mode;
+}
+
+inline void allocator_sorted_list::set_coalescing_mode(
+    allocator_with_coalescing_mode::coalescing_mode mode)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    // immediate mode relies on every non occupied block being merged already
+    if (mode == allocator_with_coalescing_mode::coalescing_mode::immediate && metadata.parked_blocks_count != 0)
+    {
+        merge_free_blocks(_trusted_memory);
+    }
+    
+    metadata.coalescing_mode = mode;
+}
+
+void allocator_sorted_list::coalesce()
+{
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    merge_free_blocks(_trusted_memory);
+}
+
+void allocator_sorted_list::trim()
+{
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    void *blocks_end = get_blocks_end(_trusted_memory);
+    size_t released_size = 0;
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    // the header keeps the list link, so only the payload of a free or parked block is released
+    for (block_header *block = get_first_block(_trusted_memory); block != blocks_end; block = get_next_block(block))
+    {
+        if (block->state != block_state::occupied)
+        {
+            released_size += release_pages(get_payload(block), block->block_size - block_header_size);
+        }
+    }
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::trim: " + std::to_string(released_size) + " bytes released");
+    }
+}
+
+size_t allocator_sorted_list::get_header_writes_count() const noexcept
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    return metadata.header_writes_count;
+}
+
+void allocator_sorted_list::set_maintenance_thread(
+    allocator_maintenance_thread *maintenance_thread) noexcept
+{
+    _maintenance_thread.store(maintenance_thread, std::memory_order_release);
 }
 
 inline allocator *allocator_sorted_list::get_allocator() const
 {
-    throw not_implemented("inline allocator *allocator_sorted_list::get_allocator() const", "your code should be here...");
+    return get_metadata(_trusted_memory).parent_allocator;
 }
 
 std::vector<allocator_test_utils::block_info> allocator_sorted_list::get_blocks_info() const noexcept
 {
-    throw not_implemented("std::vector<allocator_test_utils::block_info> allocator_sorted_list::get_blocks_info() const noexcept", "your code should be here...");
+    std::vector<allocator_test_utils::block_info> blocks_info;
+    
+    try
+    {
+        for (auto const &block: get_blocks_layout())
+        {
+            blocks_info.push_back({ block.block_size, block.is_block_occupied });
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        blocks_info.clear();
+    }
+    
+    return blocks_info;
+}
+
+std::vector<allocator_test_utils::block_layout_info> allocator_sorted_list::get_blocks_layout() const
+{
+    std::vector<allocator_test_utils::block_layout_info> layout;
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    void *blocks_end = get_blocks_end(_trusted_memory);
+    
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    for (block_header *block = get_first_block(_trusted_memory); block != blocks_end; block = get_next_block(block))
+    {
+        layout.push_back({
+            static_cast<size_t>(reinterpret_cast<unsigned char *>(block) - reinterpret_cast<unsigned char *>(_trusted_memory)),
+            block->block_size,
+            block->state == block_state::occupied,
+            block->fit_hits_count });
+    }
+    
+    return layout;
+}
+
+void allocator_sorted_list::snapshot_to(
+    int fd) const
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    std::lock_guard<std::mutex> lock(metadata.mutex);
+    
+    write_image(fd, get_typename(), image_version, _trusted_memory, metadata_size + metadata.space_size);
+}
+
+void allocator_sorted_list::restore_from(
+    int fd)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    size_t image_size = read_image_size(fd, get_typename(), image_version);
+    if (image_size < metadata_size + min_block_size)
+    {
+        error_with_guard(get_typename() + "::restore_from: image is too small");
+        
+        throw std::runtime_error("allocator image is too small");
+    }
+    
+    // the image lives in the same parent allocator as the current trusted memory
+    void *image = allocate_with_guard(1, image_size);
+    try
+    {
+        read_image(fd, image, image_size);
+        if (metadata_size + get_metadata(image).space_size != image_size)
+        {
+            throw std::runtime_error("allocator image size does not match its metadata");
+        }
+        
+        if (!is_image_valid(image, image_size))
+        {
+            throw std::runtime_error("allocator image is corrupted");
+        }
+    }
+    catch (...)
+    {
+        deallocate_with_guard(image);
+        
+        throw;
+    }
+    
+    allocator_metadata &image_metadata = get_metadata(image);
+    image_metadata.parent_allocator = metadata.parent_allocator;
+    image_metadata.target_logger = metadata.target_logger;
+    rebase_image(image);
+    
+    {
+        // operations already running on the current image finish before it is released
+        std::lock_guard<std::mutex> lock(metadata.mutex);
+        std::swap(_trusted_memory, image);
+    }
+    
+    get_metadata(image).mutex.~mutex();
+    deallocate_with_guard(image);
+    
+    debug_with_guard(get_typename() + "::restore_from: " + std::to_string(image_size) + " bytes image restored");
+}
+
+bool allocator_sorted_list::is_image_valid(
+    void *trusted_memory,
+    size_t image_size)
+{
+    allocator_metadata &metadata = get_metadata(trusted_memory);
+    void const *old_base = metadata.trusted_memory;
+    auto get_block_at = [trusted_memory](size_t block_offset)
+    {
+        return reinterpret_cast<block_header *>(reinterpret_cast<unsigned char *>(trusted_memory) + block_offset);
+    };
+    
+    if (metadata.fit_mode > allocator_with_fit_mode::fit_mode::the_worst_fit
+        || metadata.coalescing_mode > allocator_with_coalescing_mode::coalescing_mode::deferred)
+    {
+        return false;
+    }
+    
+    // a zero or oversized block size would send every walk over the blocks astray
+    std::vector<size_t> released_block_offsets;
+    for (size_t block_offset = metadata_size; block_offset != image_size; block_offset += get_block_at(block_offset)->block_size)
+    {
+        block_header *block = get_block_at(block_offset);
+        if (block->block_size < min_block_size || block->block_size % block_alignment != 0 || block->block_size > image_size - block_offset)
+        {
+            return false;
+        }
+        
+        if (block->state == block_state::occupied)
+        {
+            if (block->link != old_base)
+            {
+                return false;
+            }
+        }
+        else if (block->state == block_state::free || block->state == block_state::parked)
+        {
+            released_block_offsets.push_back(block_offset);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    
+    // the free list is strictly address ordered, so it can't loop
+    size_t listed_blocks_count = 0;
+    size_t previous_block_offset = 0;
+    for (void *link = metadata.first_free_block; link != nullptr; ++listed_blocks_count)
+    {
+        size_t block_offset = get_image_offset(link, old_base, image_size);
+        if (block_offset <= previous_block_offset
+            || !std::binary_search(released_block_offsets.begin(), released_block_offsets.end(), block_offset)
+            || get_block_at(block_offset)->state != block_state::free)
+        {
+            return false;
+        }
+        
+        previous_block_offset = block_offset;
+        link = get_block_at(block_offset)->link;
+    }
+    
+    // the parked list is bounded by its recorded length instead
+    size_t parked_blocks_count = 0;
+    for (void *link = metadata.first_parked_block; link != nullptr; ++parked_blocks_count)
+    {
+        size_t block_offset = get_image_offset(link, old_base, image_size);
+        if (parked_blocks_count == metadata.parked_blocks_count
+            || !std::binary_search(released_block_offsets.begin(), released_block_offsets.end(), block_offset)
+            || get_block_at(block_offset)->state != block_state::parked)
+        {
+            return false;
+        }
+        
+        link = get_block_at(block_offset)->link;
+    }
+    
+    return parked_blocks_count == metadata.parked_blocks_count
+        && listed_blocks_count + parked_blocks_count == released_block_offsets.size();
+}
+
+void allocator_sorted_list::rebase_image(
+    void *trusted_memory) noexcept
+{
+    allocator_metadata &metadata = *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    void const *old_base = metadata.trusted_memory;
+    size_t image_size = metadata_size + metadata.space_size;
+    auto rebase = [old_base, image_size, trusted_memory](auto *pointer)
+    {
+        return reinterpret_cast<decltype(pointer)>(relocate(pointer, old_base, image_size, trusted_memory));
+    };
+    
+    new (&metadata.mutex) std::mutex;
+    metadata.trusted_memory = trusted_memory;
+    metadata.first_free_block = rebase(metadata.first_free_block);
+    metadata.first_parked_block = rebase(metadata.first_parked_block);
+    
+    // the link of an occupied block is the trusted memory itself, so it is rebased the same way
+    void *blocks_end = get_blocks_end(trusted_memory);
+    for (block_header *block = get_first_block(trusted_memory); block != blocks_end; block = get_next_block(block))
+    {
+        block->link = rebase(block->link);
+    }
 }
 
 inline logger *allocator_sorted_list::get_logger() const
 {
-    throw not_implemented("inline logger *allocator_sorted_list::get_logger() const", "your code should be here...");
+    return _trusted_memory == nullptr
+        ? nullptr
+        : get_metadata(_trusted_memory).target_logger;
 }
 
 inline std::string allocator_sorted_list::get_typename() const noexcept
 {
-    throw not_implemented("inline std::string allocator_sorted_list::get_typename() const noexcept", "your code should be here...");
+    return "allocator_sorted_list";
 }
\ No newline at end of file
@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
 #include <logger.h>
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <list>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <allocator_maintenance_thread.h>
 
 #include "../include/allocator_sorted_list.h"
 
@@ -30,6 +38,55 @@ logger *create_logger(
     return built_logger;
 }
 
+// stalls the maintenance pass in its coalesce until released; attached before the allocator under test,
+// so a test can deallocate while the pass that would sweep the allocator is held
+class maintenance_pass_gate final:
+    public allocator_with_coalescing_mode
+{
+
+public:
+    
+    std::atomic<bool> is_entered { false };
+    
+    std::atomic<bool> is_holding { true };
+
+public:
+    
+    void set_coalescing_mode(
+        coalescing_mode) override
+    {
+
+    }
+    
+    void coalesce() override
+    {
+        is_entered = true;
+        while (is_holding)
+        {
+            std::this_thread::yield();
+        }
+    }
+    
+    void trim() override
+    {
+
+    }
+    
+    size_t get_header_writes_count() const noexcept override
+    {
+        return 0;
+    }
+
+private:
+    
+    void set_maintenance_thread(
+        allocator_maintenance_thread *) noexcept override
+    {
+
+    }
+    
+};
+
 TEST(allocatorSortedListPositiveTests, test1)
 {
     //TODO: logger
@@ -140,7 +197,10 @@ TEST(allocatorSortedListPositiveTests, test4)
 {
     //TODO: logger
     
-    allocator *alloc = new allocator_sorted_list(1000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    // the requests alone take 3600 bytes, so the space has to be larger than that
+    allocator *alloc = new allocator_sorted_list(4000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    auto *utils = dynamic_cast<allocator_test_utils *>(alloc);
+    size_t const space_size = utils->get_blocks_info()[0].block_size;
     
     auto first_block = reinterpret_cast<unsigned char *>(alloc->allocate(sizeof(unsigned char), 250));
     auto second_block = reinterpret_cast<unsigned char *>(alloc->allocate(sizeof(char), 150));
@@ -153,27 +213,55 @@ TEST(allocatorSortedListPositiveTests, test4)
     the_same_subject->set_fit_mode(allocator_with_fit_mode::fit_mode::the_best_fit);
     auto five_block = reinterpret_cast<unsigned char *>(alloc->allocate(sizeof(unsigned char *), 50));
     
+    // the only free block is the trailing one, so every block is cut from its front
+    unsigned char *blocks[] = { first_block, second_block, third_block, four_block, five_block };
+    auto blocks_state = utils->get_blocks_info();
+    size_t occupied_size = 0;
+    
+    ASSERT_EQ(blocks_state.size(), 6);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        ASSERT_TRUE(blocks_state[i].is_block_occupied);
+        if (i != 0)
+        {
+            ASSERT_EQ(blocks[i - 1] + blocks_state[i - 1].block_size, blocks[i]);
+        }
+        
+        occupied_size += blocks_state[i].block_size;
+    }
+    
+    ASSERT_EQ(blocks_state[5], (allocator_test_utils::block_info { .block_size = space_size - occupied_size, .is_block_occupied = false }));
+    
     alloc->deallocate(first_block);
     alloc->deallocate(second_block);
     alloc->deallocate(third_block);
     alloc->deallocate(four_block);
     alloc->deallocate(five_block);
     
-    //TODO: проверка
+    blocks_state = utils->get_blocks_info();
+    ASSERT_EQ(blocks_state.size(), 1);
+    ASSERT_EQ(blocks_state[0], (allocator_test_utils::block_info { .block_size = space_size, .is_block_occupied = false }));
     
     delete alloc;
 }
 
 TEST(allocatorSortedListPositiveTests, test5)
 {
-    allocator *alloc = new allocator_sorted_list(3000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    // the requests alone take 3500 bytes, so the space has to be larger than that
+    allocator *alloc = new allocator_sorted_list(4000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
     
     auto first_block = reinterpret_cast<int *>(alloc->allocate(sizeof(int), 250));
     auto second_block = reinterpret_cast<char *>(alloc->allocate(sizeof(char), 500));
     auto third_block = reinterpret_cast<double *>(alloc->allocate(sizeof(double *), 250));
+    auto expected_blocks_state = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info();
+    auto *expected_first_block = first_block;
     alloc->deallocate(first_block);
     first_block = reinterpret_cast<int *>(alloc->allocate(sizeof(int), 245));
     
+    // the tail the smaller request leaves in the hole can't become a block, so the request takes the hole as a whole
+    ASSERT_EQ(first_block, expected_first_block);
+    ASSERT_EQ(dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info(), expected_blocks_state);
+    
     //TODO: logger
     allocator *allocator = new allocator_sorted_list(5000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
     auto *the_same_subject = dynamic_cast<allocator_with_fit_mode *>(alloc);
@@ -242,6 +330,243 @@ TEST(allocatorSortedListPositiveTests, test5)
     delete alloc;
 }
 
+TEST(allocatorSortedListPositiveTests, test6)
+{
+    allocator *alloc = new allocator_sorted_list(3000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit,
+        allocator_with_coalescing_mode::coalescing_mode::deferred);
+    
+    for (auto i = 0; i < 100; i++)
+    {
+        auto first_block = alloc->allocate(sizeof(int), 25);
+        auto second_block = alloc->allocate(sizeof(int), 25);
+        alloc->deallocate(first_block);
+        alloc->deallocate(second_block);
+    }
+    
+    auto *the_same_subject = dynamic_cast<allocator_with_coalescing_mode *>(alloc);
+    the_same_subject->coalesce();
+    
+    auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 1);
+    ASSERT_EQ(actual_blocks_state[0].is_block_occupied, false);
+    
+    the_same_subject->set_coalescing_mode(allocator_with_coalescing_mode::coalescing_mode::immediate);
+    auto first_block = alloc->allocate(sizeof(int), 25);
+    alloc->deallocate(first_block);
+    
+    actual_blocks_state = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 1);
+    
+    delete alloc;
+}
+
+TEST(allocatorSortedListPositiveTests, test7)
+{
+    allocator *alloc = new allocator_sorted_list(3000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto first_block = reinterpret_cast<int *>(alloc->allocate(sizeof(int), 250));
+    auto second_block = reinterpret_cast<char *>(alloc->allocate(sizeof(char), 500));
+    alloc->deallocate(first_block);
+    
+    auto expected_blocks_state = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info();
+    
+    allocator_sorted_list copy(*dynamic_cast<allocator_sorted_list *>(alloc));
+    auto actual_blocks_state = copy.get_blocks_info();
+    ASSERT_EQ(actual_blocks_state, expected_blocks_state);
+    
+    FILE *image = tmpfile();
+    ASSERT_NE(image, nullptr);
+    dynamic_cast<allocator_with_snapshot *>(alloc)->snapshot_to(fileno(image));
+    ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+    
+    allocator_sorted_list restored(3000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    restored.restore_from(fileno(image));
+    fclose(image);
+    
+    actual_blocks_state = restored.get_blocks_info();
+    ASSERT_EQ(actual_blocks_state, expected_blocks_state);
+    
+    alloc->deallocate(second_block);
+    
+    delete alloc;
+}
+
+TEST(allocatorSortedListPositiveTests, test8)
+{
+    allocator *alloc = new allocator_sorted_list(3000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto first_block = reinterpret_cast<char *>(alloc->allocate(sizeof(char), 500));
+    auto second_block = reinterpret_cast<char *>(alloc->allocate(sizeof(char), 500));
+    auto third_block = reinterpret_cast<char *>(alloc->allocate(sizeof(char), 500));
+    alloc->deallocate(second_block);
+    
+    auto *utils = dynamic_cast<allocator_test_utils *>(alloc);
+    auto blocks_info = utils->get_blocks_info();
+    auto layout = utils->get_blocks_layout();
+    
+    ASSERT_EQ(layout.size(), blocks_info.size());
+    for (size_t i = 0; i < layout.size(); ++i)
+    {
+        ASSERT_EQ(layout[i].block_size, blocks_info[i].block_size);
+        ASSERT_EQ(layout[i].is_block_occupied, blocks_info[i].is_block_occupied);
+        if (i != 0)
+        {
+            ASSERT_GT(layout[i].block_offset, layout[i - 1].block_offset);
+        }
+    }
+    ASSERT_EQ(layout[0].fit_hits_count, 1);
+    
+    for (auto format: { allocator_test_utils::layout_format::csv, allocator_test_utils::layout_format::binary })
+    {
+        std::stringstream stream;
+        allocator_test_utils::export_layout(layout, stream, format);
+        ASSERT_EQ(allocator_test_utils::import_layout(stream), layout);
+    }
+    
+    auto statistics = allocator_test_utils::get_fragmentation_statistics(layout, 1000);
+    ASSERT_EQ(statistics.free_blocks_count, 2);
+    // the trailing block left after the three allocations is larger than the hole and still serves the request
+    ASSERT_FALSE(layout.back().is_block_occupied);
+    ASSERT_EQ(statistics.largest_free_block_size, layout.back().block_size);
+    ASSERT_EQ(statistics.unusable_free_size, layout[1].block_size);
+    
+    alloc->deallocate(first_block);
+    alloc->deallocate(third_block);
+    
+    delete alloc;
+}
+
+TEST(allocatorSortedListPositiveTests, test9)
+{
+    allocator_sorted_list subject(1 << 20, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit,
+        allocator_with_coalescing_mode::coalescing_mode::deferred);
+    allocator_with_coalescing_mode &maintained = subject;
+    
+    void *blocks[8];
+    for (auto &block: blocks)
+    {
+        block = subject.allocate(1, 1 << 16);
+        std::memset(block, 0xAB, 1 << 16);
+    }
+    
+    for (size_t i = 0; i < 8; i += 2)
+    {
+        subject.deallocate(blocks[i]);
+    }
+    
+    auto expected_blocks_state = subject.get_blocks_info();
+    
+    // the released pages hold no bookkeeping: the layout survives and the blocks are usable again
+    maintained.trim();
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    ASSERT_EQ(reinterpret_cast<unsigned char *>(blocks[1])[0], 0xAB);
+    
+    maintained.coalesce();
+    maintained.trim();
+    for (size_t i = 0; i < 8; i += 2)
+    {
+        blocks[i] = subject.allocate(1, 1 << 16);
+        std::memset(blocks[i], 0xCD, 1 << 16);
+    }
+    
+    for (auto block: blocks)
+    {
+        subject.deallocate(block);
+    }
+    
+    maintained.coalesce();
+    ASSERT_EQ(subject.get_blocks_info().size(), 1);
+}
+
+TEST(allocatorSortedListPositiveTests, test10)
+{
+    allocator_sorted_list subject(4000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit,
+        allocator_with_coalescing_mode::coalescing_mode::deferred);
+    
+    auto first_block = reinterpret_cast<int *>(subject.allocate(sizeof(int), 250));
+    auto second_block = reinterpret_cast<char *>(subject.allocate(sizeof(char), 500));
+    auto third_block = reinterpret_cast<double *>(subject.allocate(sizeof(double *), 250));
+    auto occupied_blocks_state = subject.get_blocks_info();
+    size_t const first_block_size = occupied_blocks_state[0].block_size;
+    size_t const second_block_size = occupied_blocks_state[1].block_size;
+    size_t header_writes_count = subject.get_header_writes_count();
+    
+    // parked blocks keep their size tags and stay apart from each other until the sweep
+    subject.deallocate(first_block);
+    subject.deallocate(second_block);
+    auto blocks_state = subject.get_blocks_info();
+    ASSERT_EQ(blocks_state.size(), 4);
+    ASSERT_EQ(blocks_state[0], (allocator_test_utils::block_info { .block_size = first_block_size, .is_block_occupied = false }));
+    ASSERT_EQ(blocks_state[1], (allocator_test_utils::block_info { .block_size = second_block_size, .is_block_occupied = false }));
+    ASSERT_EQ(subject.get_header_writes_count(), header_writes_count);
+    
+    // a request of the parked block size class takes it back as is
+    auto *expected_first_block = first_block;
+    first_block = reinterpret_cast<int *>(subject.allocate(sizeof(int), 245));
+    ASSERT_EQ(first_block, expected_first_block);
+    ASSERT_EQ(subject.get_header_writes_count(), header_writes_count);
+    
+    subject.deallocate(first_block);
+    subject.coalesce();
+    blocks_state = subject.get_blocks_info();
+    ASSERT_EQ(blocks_state.size(), 3);
+    ASSERT_EQ(blocks_state[0], (allocator_test_utils::block_info { .block_size = first_block_size + second_block_size, .is_block_occupied = false }));
+    ASSERT_EQ(blocks_state[1], occupied_blocks_state[2]);
+    ASSERT_EQ(subject.get_header_writes_count(), header_writes_count + 1);
+    
+    subject.deallocate(third_block);
+}
+
+TEST(allocatorSortedListPositiveTests, test11)
+{
+    maintenance_pass_gate pass_gate;
+    allocator_maintenance_thread maintenance_thread(std::chrono::hours(1));
+    size_t const blocks_count = allocator_with_coalescing_mode::deferred_blocks_threshold + 2;
+    auto *subject = new allocator_sorted_list(1 << 14, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit,
+        allocator_with_coalescing_mode::coalescing_mode::deferred);
+    
+    std::vector<void *> blocks(blocks_count);
+    for (auto &block: blocks)
+    {
+        block = subject->allocate(sizeof(int), 4);
+    }
+    
+    maintenance_thread.attach(&pass_gate);
+    maintenance_thread.attach(subject);
+    maintenance_thread.request_maintenance();
+    while (!pass_gate.is_entered)
+    {
+        std::this_thread::yield();
+    }
+    
+    // past the threshold deallocate only wakes the thread, the adjacent parked blocks stay apart
+    for (size_t i = 0; i < blocks_count - 1; ++i)
+    {
+        subject->deallocate(blocks[i]);
+    }
+    size_t const held_blocks_count = subject->get_blocks_info().size();
+    
+    // released before asserting, a held pass would never let the thread join
+    pass_gate.is_holding = false;
+    ASSERT_EQ(held_blocks_count, blocks_count + 1);
+    while (maintenance_thread.get_passes_count() < 2)
+    {
+        std::this_thread::yield();
+    }
+    
+    auto blocks_state = subject->get_blocks_info();
+    ASSERT_EQ(blocks_state.size(), 3);
+    ASSERT_FALSE(blocks_state[0].is_block_occupied);
+    ASSERT_TRUE(blocks_state[1].is_block_occupied);
+    
+    // the destructor detaches, so the next pass maintains the gate only
+    delete subject;
+    maintenance_thread.request_maintenance();
+    while (maintenance_thread.get_passes_count() < 3)
+    {
+        std::this_thread::yield();
+    }
+}
 
 //TODO: Тесты на особенность аллокатора?
 
@@ -262,6 +587,44 @@ TEST(allocatorSortedListNegativeTests, test1)
     delete logger;
 }
 
+TEST(allocatorSortedListNegativeTests, test2)
+{
+    allocator_sorted_list subject(2000, nullptr, nullptr, allocator_with_fit_mode::fit_mode::first_fit);
+    
+    auto block = subject.allocate(sizeof(int), 50);
+    auto layout = subject.get_blocks_layout();
+    auto expected_blocks_state = subject.get_blocks_info();
+    
+    FILE *image = tmpfile();
+    ASSERT_NE(image, nullptr);
+    subject.snapshot_to(fileno(image));
+    
+    // the image header goes before the trusted memory bytes, and the block offsets count from the latter
+    off_t image_header_size = lseek(fileno(image), 0, SEEK_END) - static_cast<off_t>(layout.back().block_offset + layout.back().block_size);
+    auto restore_patched = [&subject, image](off_t position, uint64_t value)
+    {
+        uint64_t original_value;
+        ASSERT_EQ(pread(fileno(image), &original_value, sizeof(original_value), position), sizeof(original_value));
+        ASSERT_EQ(pwrite(fileno(image), &value, sizeof(value), position), sizeof(value));
+        ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+        ASSERT_THROW(subject.restore_from(fileno(image)), std::runtime_error);
+        ASSERT_EQ(pwrite(fileno(image), &original_value, sizeof(original_value), position), sizeof(original_value));
+    };
+    
+    // the type tag, the layout version and a zero size of the trailing block, which would loop every walk over the blocks
+    restore_patched(sizeof(uint64_t), 0);
+    restore_patched(sizeof(uint64_t) * 2, 2);
+    restore_patched(image_header_size + static_cast<off_t>(layout.back().block_offset), 0);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    ASSERT_EQ(lseek(fileno(image), 0, SEEK_SET), 0);
+    subject.restore_from(fileno(image));
+    fclose(image);
+    ASSERT_EQ(subject.get_blocks_info(), expected_blocks_state);
+    
+    subject.deallocate(block);
+}
+
 int main(
     int argc,
     char **argv)
@@ -0,0 +1,88 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_STACK_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_STACK_H
+
+#include <allocator.h>
+#include <allocator_guardant.h>
+#include <allocator_test_utils.h>
+#include <logger_guardant.h>
+#include <typename_holder.h>
+
+// blocks must be released in reverse order of allocation; every block ends with a footer
+// holding its size, so releasing the top block just moves the top pointer back.
+// chunks are requested from the parent allocator on demand and returned as soon as they get empty.
+// the allocator is not synchronized, wrap it into allocator_synchronized to share it between threads
+class allocator_stack final:
+    public allocator,
+    private allocator_guardant,
+    public allocator_test_utils,
+    private logger_guardant,
+    private typename_holder
+{
+
+private:
+    
+    void *_trusted_memory;
+
+public:
+    
+    ~allocator_stack() override;
+    
+    allocator_stack(
+        allocator_stack const &other) = delete;
+    
+    allocator_stack &operator=(
+        allocator_stack const &other) = delete;
+    
+    allocator_stack(
+        allocator_stack &&other) noexcept;
+    
+    allocator_stack &operator=(
+        allocator_stack &&other) noexcept;
+
+public:
+    
+    explicit allocator_stack(
+        size_t chunk_size,
+        allocator *parent_allocator = nullptr,
+        logger *logger = nullptr);
+
+public:
+    
+    [[nodiscard]] void *allocate(
+        size_t value_size,
+        size_t values_count) override;
+    
+    [[nodiscard]] allocator::allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count) override;
+    
+    // with a logger attached a block other than the top one is reported and left untouched,
+    // without it the stack is rolled back to the given block releasing everything above it
+    void deallocate(
+        void *at) override;
+
+private:
+    
+    inline allocator *get_allocator() const override;
+
+public:
+    
+    std::vector<allocator_test_utils::block_info> get_blocks_info() const noexcept override;
+    
+    std::vector<allocator_test_utils::block_layout_info> get_blocks_layout() const override;
+
+private:
+    
+    inline logger *get_logger() const override;
+
+private:
+    
+    inline std::string get_typename() const noexcept override;
+
+private:
+    
+    void release_chunks() noexcept;
+    
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_STACK_H
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+
+#include "../include/allocator_stack.h"
+
+namespace
+{
+    
+    struct allocator_metadata final
+    {
+        
+        allocator *parent_allocator;
+        
+        logger *target_logger;
+        
+        size_t chunk_size;
+        
+        void *top_chunk;
+        
+    };
+    
+    // first chunk begins with allocator_metadata, the rest of them begin with chunk_header right away
+    struct chunk_header final
+    {
+        
+        void *previous_chunk;
+        
+        unsigned char *bottom;
+        
+        unsigned char *top;
+        
+        unsigned char *end;
+        
+    };
+    
+    struct block_footer final
+    {
+        
+        // footer included
+        size_t block_size;
+        
+    };
+    
+    constexpr size_t block_alignment = alignof(std::max_align_t);
+    
+    constexpr size_t align_up(
+        size_t value) noexcept
+    {
+        return (value + block_alignment - 1) / block_alignment * block_alignment;
+    }
+    
+    inline unsigned char *align_up(
+        unsigned char *pointer) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(align_up(reinterpret_cast<uintptr_t>(pointer)));
+    }
+    
+    constexpr size_t metadata_size = align_up(sizeof(allocator_metadata));
+    
+    constexpr size_t chunk_header_size = align_up(sizeof(chunk_header));
+    
+    inline allocator_metadata &get_metadata(
+        void *trusted_memory) noexcept
+    {
+        return *reinterpret_cast<allocator_metadata *>(trusted_memory);
+    }
+    
+    inline chunk_header &get_chunk_header(
+        void *chunk,
+        void *trusted_memory) noexcept
+    {
+        return *reinterpret_cast<chunk_header *>(reinterpret_cast<unsigned char *>(chunk) + (chunk == trusted_memory
+            ? metadata_size
+            : 0));
+    }
+    
+    inline block_footer &get_footer(
+        unsigned char *block_end) noexcept
+    {
+        return *reinterpret_cast<block_footer *>(block_end - sizeof(block_footer));
+    }
+    
+    // parent allocator does not have to align blocks as strictly as we do, so one extra alignment step is reserved
+    inline void initialize_chunk(
+        chunk_header &header,
+        void *chunk,
+        size_t chunk_size,
+        void *previous_chunk) noexcept
+    {
+        header.previous_chunk = previous_chunk;
+        header.bottom = align_up(reinterpret_cast<unsigned char *>(&header) + chunk_header_size);
+        header.top = header.bottom;
+        header.end = reinterpret_cast<unsigned char *>(chunk) + chunk_size;
+    }
+    
+    // chunks are walked from the bottom of the stack to its top
+    std::vector<void *> get_chunks_bottom_up(
+        void *trusted_memory)
+    {
+        std::vector<void *> chunks;
+        for (void *chunk = get_metadata(trusted_memory).top_chunk; chunk != nullptr; chunk = get_chunk_header(chunk, trusted_memory).previous_chunk)
+        {
+            chunks.push_back(chunk);
+        }
+        
+        std::reverse(chunks.begin(), chunks.end());
+        
+        return chunks;
+    }
+    
+}
+
+allocator_stack::~allocator_stack()
+{
+    release_chunks();
+}
+
+allocator_stack::allocator_stack(
+    allocator_stack &&other) noexcept:
+    _trusted_memory(other._trusted_memory)
+{
+    other._trusted_memory = nullptr;
+}
+
+allocator_stack &allocator_stack::operator=(
+    allocator_stack &&other) noexcept
+{
+    if (this != &other)
+    {
+        release_chunks();
+        _trusted_memory = other._trusted_memory;
+        other._trusted_memory = nullptr;
+    }
+    
+    return *this;
+}
+
+allocator_stack::allocator_stack(
+    size_t chunk_size,
+    allocator *parent_allocator,
+    logger *logger)
+{
+    size_t first_chunk_size = metadata_size + chunk_header_size + block_alignment + chunk_size;
+    
+    _trusted_memory = parent_allocator == nullptr
+        ? ::operator new(first_chunk_size)
+        : parent_allocator->allocate(1, first_chunk_size);
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    metadata.parent_allocator = parent_allocator;
+    metadata.target_logger = logger;
+    metadata.chunk_size = chunk_size;
+    metadata.top_chunk = _trusted_memory;
+    
+    initialize_chunk(get_chunk_header(_trusted_memory, _trusted_memory), _trusted_memory, first_chunk_size, nullptr);
+    
+    debug_with_guard(get_typename() + "::allocator_stack: " + std::to_string(chunk_size) + " bytes chunks");
+}
+
+[[nodiscard]] void *allocator_stack::allocate(
+    size_t value_size,
+    size_t values_count)
+{
+    return allocate_at_least(value_size, values_count).pointer;
+}
+
+[[nodiscard]] allocator::allocation_result allocator_stack::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    
+    size_t const max_block_size = SIZE_MAX - chunk_header_size - 2 * block_alignment - sizeof(block_footer);
+    if (values_count != 0 && value_size > max_block_size / values_count)
+    {
+        error_with_guard(get_typename() + "::allocate: requested size overflows size_t");
+        
+        throw std::bad_alloc();
+    }
+    
+    size_t requested_size = value_size * values_count;
+    size_t block_size = align_up(requested_size + sizeof(block_footer));
+    
+    chunk_header *header = &get_chunk_header(metadata.top_chunk, _trusted_memory);
+    
+    if (static_cast<size_t>(header->end - header->top) < block_size)
+    {
+        size_t chunk_size = chunk_header_size + block_alignment + std::max(metadata.chunk_size, block_size);
+        
+        void *chunk;
+        try
+        {
+            chunk = allocate_with_guard(1, chunk_size);
+        }
+        catch (std::bad_alloc const &)
+        {
+            error_with_guard(get_typename() + "::allocate: can't get a chunk of " + std::to_string(chunk_size) + " bytes from the parent allocator");
+            
+            throw;
+        }
+        
+        header = &get_chunk_header(chunk, _trusted_memory);
+        initialize_chunk(*header, chunk, chunk_size, metadata.top_chunk);
+        metadata.top_chunk = chunk;
+        
+        debug_with_guard(get_typename() + "::allocate: new chunk of " + std::to_string(chunk_size) + " bytes");
+    }
+    
+    unsigned char *block = header->top;
+    header->top += block_size;
+    get_footer(header->top).block_size = block_size;
+    
+    if (metadata.target_logger != nullptr)
+    {
+        debug_with_guard(get_typename() + "::allocate: " + std::to_string(requested_size) + " bytes requested, " + std::to_string(block_size) + " bytes allocated");
+    }
+    
+    return { block, block_size - sizeof(block_footer) };
+}
+
+void allocator_stack::deallocate(
+    void *at)
+{
+    if (at == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    unsigned char *block = reinterpret_cast<unsigned char *>(at);
+    chunk_header *header = &get_chunk_header(metadata.top_chunk, _trusted_memory);
+    
+    if (metadata.target_logger != nullptr)
+    {
+        if (header->top == header->bottom || header->top - get_footer(header->top).block_size != block)
+        {
+            error_with_guard(get_typename() + "::deallocate: block is not on the top of the stack, deallocation is ignored");
+            
+            return;
+        }
+        
+        debug_with_guard(get_typename() + "::deallocate: " + std::to_string(get_footer(header->top).block_size) + " bytes released");
+    }
+    
+    while (block < header->bottom || block >= header->top)
+    {
+        void *previous_chunk = header->previous_chunk;
+        if (previous_chunk == nullptr)
+        {
+            error_with_guard(get_typename() + "::deallocate: block does not belong to the allocator");
+            
+            return;
+        }
+        
+        deallocate_with_guard(metadata.top_chunk);
+        metadata.top_chunk = previous_chunk;
+        header = &get_chunk_header(previous_chunk, _trusted_memory);
+    }
+    
+    header->top = block;
+    
+    if (header->top == header->bottom && header->previous_chunk != nullptr)
+    {
+        void *previous_chunk = header->previous_chunk;
+        deallocate_with_guard(metadata.top_chunk);
+        metadata.top_chunk = previous_chunk;
+    }
+}
+
+inline allocator *allocator_stack::get_allocator() const
+{
+    return get_metadata(_trusted_memory).parent_allocator;
+}
+
+std::vector<allocator_test_utils::block_info> allocator_stack::get_blocks_info() const noexcept
+{
+    std::vector<allocator_test_utils::block_info> blocks_info;
+    
+    try
+    {
+        for (auto const &block: get_blocks_layout())
+        {
+            blocks_info.push_back({ block.block_size, block.is_block_occupied });
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        blocks_info.clear();
+    }
+    
+    return blocks_info;
+}
+
+std::vector<allocator_test_utils::block_layout_info> allocator_stack::get_blocks_layout() const
+{
+    std::vector<allocator_test_utils::block_layout_info> layout;
+    size_t chunk_offset = 0;
+    
+    for (void *chunk: get_chunks_bottom_up(_trusted_memory))
+    {
+        chunk_header &header = get_chunk_header(chunk, _trusted_memory);
+        
+        size_t blocks_count = 0;
+        for (unsigned char *block_end = header.top; block_end != header.bottom; block_end -= get_footer(block_end).block_size)
+        {
+            size_t block_size = get_footer(block_end).block_size;
+            layout.push_back({ chunk_offset + static_cast<size_t>(block_end - block_size - header.bottom), block_size, true, 0 });
+            ++blocks_count;
+        }
+        std::reverse(layout.end() - blocks_count, layout.end());
+        
+        if (header.top != header.end)
+        {
+            layout.push_back({ chunk_offset + static_cast<size_t>(header.top - header.bottom), static_cast<size_t>(header.end - header.top), false, 0 });
+        }
+        
+        chunk_offset += header.end - header.bottom;
+    }
+    
+    return layout;
+}
+
+inline logger *allocator_stack::get_logger() const
+{
+    return _trusted_memory == nullptr
+        ? nullptr
+        : get_metadata(_trusted_memory).target_logger;
+}
+
+inline std::string allocator_stack::get_typename() const noexcept
+{
+    return "allocator_stack";
+}
+
+void allocator_stack::release_chunks() noexcept
+{
+    if (_trusted_memory == nullptr)
+    {
+        return;
+    }
+    
+    allocator_metadata &metadata = get_metadata(_trusted_memory);
+    while (metadata.top_chunk != _trusted_memory)
+    {
+        void *previous_chunk = get_chunk_header(metadata.top_chunk, _trusted_memory).previous_chunk;
+        deallocate_with_guard(metadata.top_chunk);
+        metadata.top_chunk = previous_chunk;
+    }
+    
+    deallocate_with_guard(_trusted_memory);
+    _trusted_memory = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <logger.h>
+#include <logger_builder.h>
+#include <client_logger_builder.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "../include/allocator_stack.h"
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+    
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+    
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+    
+    logger *built_logger = builder->build();
+    
+    delete builder;
+    
+    return built_logger;
+}
+
+TEST(allocatorStackPositiveTests, test1)
+{
+    allocator *alloc = new allocator_stack(4096);
+    
+    auto first_block = reinterpret_cast<int *>(alloc->allocate(sizeof(int), 10));
+    auto second_block = reinterpret_cast<char *>(alloc->allocate(sizeof(char), 3));
+    auto third_block = reinterpret_cast<double *>(alloc->allocate(sizeof(double), 5));
+    
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(third_block) % alignof(std::max_align_t), 0);
+    ASSERT_LT(reinterpret_cast<char *>(first_block), second_block);
+    ASSERT_LT(second_block, reinterpret_cast<char *>(third_block));
+    
+    auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 4);
+    ASSERT_TRUE(actual_blocks_state[0].is_block_occupied);
+    ASSERT_TRUE(actual_blocks_state[1].is_block_occupied);
+    ASSERT_TRUE(actual_blocks_state[2].is_block_occupied);
+    ASSERT_FALSE(actual_blocks_state[3].is_block_occupied);
+    ASSERT_GE(actual_blocks_state[0].block_size, sizeof(int) * 10);
+    
+    alloc->deallocate(third_block);
+    alloc->deallocate(second_block);
+    
+    auto reused_block = reinterpret_cast<char *>(alloc->allocate(sizeof(char), 3));
+    ASSERT_EQ(reused_block, second_block);
+    
+    alloc->deallocate(reused_block);
+    alloc->deallocate(first_block);
+    
+    actual_blocks_state = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 1);
+    ASSERT_FALSE(actual_blocks_state[0].is_block_occupied);
+    ASSERT_GE(actual_blocks_state[0].block_size, 4096);
+    
+    delete alloc;
+}
+
+TEST(allocatorStackPositiveTests, test2)
+{
+    allocator *alloc = new allocator_stack(256);
+    
+    std::vector<void *> blocks;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        blocks.push_back(alloc->allocate(sizeof(char), 100));
+    }
+    blocks.push_back(alloc->allocate(sizeof(char), 1000));
+    
+    auto layout = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_layout();
+    ASSERT_EQ(std::count_if(layout.begin(), layout.end(), [](allocator_test_utils::block_layout_info const &block) { return block.is_block_occupied; }), 101);
+    for (size_t i = 1; i < layout.size(); ++i)
+    {
+        ASSERT_EQ(layout[i].block_offset, layout[i - 1].block_offset + layout[i - 1].block_size);
+    }
+    
+    for (auto block = blocks.rbegin(); block != blocks.rend(); ++block)
+    {
+        alloc->deallocate(*block);
+    }
+    
+    ASSERT_EQ(dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info().size(), 1);
+    
+    delete alloc;
+}
+
+TEST(allocatorStackPositiveTests, test3)
+{
+    allocator *parent = new allocator_stack(1024);
+    allocator *alloc = new allocator_stack(128, parent);
+    
+    auto first_block = alloc->allocate(sizeof(char), 100);
+    auto second_block = alloc->allocate(sizeof(char), 100);
+    auto third_block = alloc->allocate(sizeof(char), 100);
+    
+    ASSERT_GT(dynamic_cast<allocator_test_utils *>(parent)->get_blocks_info().size(), 2);
+    
+    // without a logger attached the stack is rolled back to the given block
+    alloc->deallocate(first_block);
+    
+    auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 1);
+    ASSERT_FALSE(actual_blocks_state[0].is_block_occupied);
+    
+    delete alloc;
+    
+    actual_blocks_state = dynamic_cast<allocator_test_utils *>(parent)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 1);
+    ASSERT_FALSE(actual_blocks_state[0].is_block_occupied);
+    
+    delete parent;
+}
+
+TEST(allocatorStackNegativeTests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "allocator_stack_tests_logs_negative_test_1.txt",
+                logger::severity::information
+            }
+        }, false);
+    allocator *alloc = new allocator_stack(4096, nullptr, logger);
+    
+    auto first_block = alloc->allocate(sizeof(char), 100);
+    auto second_block = alloc->allocate(sizeof(char), 100);
+    
+    alloc->deallocate(first_block);
+    
+    auto actual_blocks_state = dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info();
+    ASSERT_EQ(actual_blocks_state.size(), 3);
+    ASSERT_TRUE(actual_blocks_state[0].is_block_occupied);
+    ASSERT_TRUE(actual_blocks_state[1].is_block_occupied);
+    
+    alloc->deallocate(second_block);
+    alloc->deallocate(first_block);
+    
+    ASSERT_EQ(dynamic_cast<allocator_test_utils *>(alloc)->get_blocks_info().size(), 1);
+    
+    delete alloc;
+    delete logger;
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
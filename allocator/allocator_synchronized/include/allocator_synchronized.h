@@ -0,0 +1,75 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_SYNCHRONIZED_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_SYNCHRONIZED_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <allocator.h>
+
+// serializes every call to a non thread-safe allocator behind one mutex and accounts the time spent waiting for it
+class allocator_synchronized final:
+    public allocator
+{
+
+private:
+    
+    allocator *_target_allocator;
+    
+    std::mutex _mutex;
+    
+    std::atomic<uint64_t> _lock_acquisitions;
+    
+    std::atomic<uint64_t> _contended_lock_acquisitions;
+    
+    std::atomic<uint64_t> _lock_wait_nanoseconds;
+
+public:
+    
+    explicit allocator_synchronized(
+        allocator *target_allocator);
+    
+    ~allocator_synchronized() override = default;
+    
+    allocator_synchronized(
+        allocator_synchronized const &other) = delete;
+    
+    allocator_synchronized &operator=(
+        allocator_synchronized const &other) = delete;
+    
+    allocator_synchronized(
+        allocator_synchronized &&other) = delete;
+    
+    allocator_synchronized &operator=(
+        allocator_synchronized &&other) = delete;
+
+public:
+    
+    [[nodiscard]] void *allocate(
+        size_t value_size,
+        size_t values_count) override;
+    
+    [[nodiscard]] allocator::allocation_result allocate_at_least(
+        size_t value_size,
+        size_t values_count) override;
+    
+    void deallocate(
+        void *at) override;
+
+public:
+    
+    uint64_t get_lock_acquisitions() const noexcept;
+    
+    uint64_t get_contended_lock_acquisitions() const noexcept;
+    
+    uint64_t get_lock_wait_nanoseconds() const noexcept;
+    
+    void reset_statistics() noexcept;
+
+private:
+    
+    // the clock is only read when the mutex is already taken, so uncontended calls pay a single try_lock
+    std::unique_lock<std::mutex> acquire();
+    
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ALLOCATOR_ALLOCATOR_SYNCHRONIZED_H
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <chrono>
+
+#include "../include/allocator_synchronized.h"
+
+allocator_synchronized::allocator_synchronized(
+    allocator *target_allocator):
+    _target_allocator(target_allocator),
+    _lock_acquisitions(0),
+    _contended_lock_acquisitions(0),
+    _lock_wait_nanoseconds(0)
+{
+
+}
+
+[[nodiscard]] void *allocator_synchronized::allocate(
+    size_t value_size,
+    size_t values_count)
+{
+    auto lock = acquire();
+    
+    return _target_allocator->allocate(value_size, values_count);
+}
+
+[[nodiscard]] allocator::allocation_result allocator_synchronized::allocate_at_least(
+    size_t value_size,
+    size_t values_count)
+{
+    auto lock = acquire();
+    
+    return _target_allocator->allocate_at_least(value_size, values_count);
+}
+
+void allocator_synchronized::deallocate(
+    void *at)
+{
+    auto lock = acquire();
+    
+    _target_allocator->deallocate(at);
+}
+
+uint64_t allocator_synchronized::get_lock_acquisitions() const noexcept
+{
+    return _lock_acquisitions.load(std::memory_order_relaxed);
+}
+
+uint64_t allocator_synchronized::get_contended_lock_acquisitions() const noexcept
+{
+    return _contended_lock_acquisitions.load(std::memory_order_relaxed);
+}
+
+uint64_t allocator_synchronized::get_lock_wait_nanoseconds() const noexcept
+{
+    return _lock_wait_nanoseconds.load(std::memory_order_relaxed);
+}
+
+void allocator_synchronized::reset_statistics() noexcept
+{
+    _lock_acquisitions.store(0, std::memory_order_relaxed);
+    _contended_lock_acquisitions.store(0, std::memory_order_relaxed);
+    _lock_wait_nanoseconds.store(0, std::memory_order_relaxed);
+}
+
+std::unique_lock<std::mutex> allocator_synchronized::acquire()
+{
+    _lock_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    
+    std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+        return lock;
+    }
+    
+    auto started_at = std::chrono::steady_clock::now();
+    lock.lock();
+    auto finished_at = std::chrono::steady_clock::now();
+    
+    _contended_lock_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    _lock_wait_nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(finished_at - started_at).count(), std::memory_order_relaxed);
+    
+    return lock;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <allocator_global_heap.h>
+#include <allocator_synchronized.h>
+
+TEST(allocatorSynchronizedTests, test1)
+{
+    allocator_global_heap target_allocator(nullptr, false);
+    allocator_synchronized subject(&target_allocator);
+    
+    int const threads_count = 4;
+    int const iterations_count = 10000;
+    
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < threads_count; ++i)
+    {
+        threads.emplace_back([&subject, iterations_count]()
+        {
+            for (auto j = 0; j < iterations_count; ++j)
+            {
+                auto *block = reinterpret_cast<int *>(subject.allocate(sizeof(int), 4));
+                block[0] = block[3] = j;
+                subject.deallocate(block);
+            }
+        });
+    }
+    
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+    
+    ASSERT_EQ(subject.get_lock_acquisitions(), 2 * threads_count * iterations_count);
+    ASSERT_LE(subject.get_contended_lock_acquisitions(), subject.get_lock_acquisitions());
+    
+    subject.reset_statistics();
+    ASSERT_EQ(subject.get_lock_acquisitions(), 0);
+    ASSERT_EQ(subject.get_lock_wait_nanoseconds(), 0);
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
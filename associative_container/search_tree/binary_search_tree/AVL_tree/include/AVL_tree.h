@@ -5,17 +5,23 @@
 
 template<
     typename tkey,
-    typename tvalue>
+    typename tvalue,
+    typename tkey_comparer = default_keys_comparer<tkey>,
+    typename taugmentation = no_augmentation>
 class AVL_tree final:
-    public binary_search_tree<tkey, tvalue>
+    public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>
 {
 
 private:
     
     struct node final:
-        binary_search_tree<tkey, tvalue>::node
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node
     {
         
+        using binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node::node;
+        
+        size_t subtree_height = 1;
+        
         // TODO: think about it!
         
     };
@@ -23,7 +29,7 @@ private:
 public:
     
     struct iterator_data final:
-        public binary_search_tree<tkey, tvalue>::iterator_data
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data
     {
     
     public:
@@ -38,50 +44,60 @@ public:
             tvalue const &value,
             size_t subtree_height);
         
+        explicit iterator_data(
+            unsigned int depth,
+            node const &viewed) noexcept;
+        
     };
 
 private:
     
     class insertion_template_method final:
-        public binary_search_tree<tkey, tvalue>::insertion_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method
     {
     
     public:
         
         explicit insertion_template_method(
-            AVL_tree<tkey, tvalue> *tree,
-            typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy);
+            AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy);
     
     private:
         
-        // TODO: think about it!
+        void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept override;
         
     };
     
     class obtaining_template_method final:
-        public binary_search_tree<tkey, tvalue>::obtaining_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method
     {
     
     public:
         
         explicit obtaining_template_method(
-            AVL_tree<tkey, tvalue> *tree);
+            AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
         
         // TODO: think about it!
         
     };
     
     class disposal_template_method final:
-        public binary_search_tree<tkey, tvalue>::disposal_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method
     {
     
     public:
         
         explicit disposal_template_method(
-            AVL_tree<tkey, tvalue> *tree,
-            typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy);
+            AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy);
+    
+    private:
         
-        // TODO: think about it!
+        void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+            bool,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *) noexcept override;
         
     };
 
@@ -90,124 +106,739 @@ public:
     explicit AVL_tree(
         allocator *allocator = nullptr,
         logger *logger = nullptr,
-        typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
-        typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception);
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception,
+        tkey_comparer keys_comparer = tkey_comparer());
+    
+    template<
+        typename tforward_iterator,
+        typename = typename std::iterator_traits<tforward_iterator>::iterator_category>
+    explicit AVL_tree(
+        tforward_iterator first,
+        tforward_iterator last,
+        allocator *allocator = nullptr,
+        logger *logger = nullptr,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception,
+        tkey_comparer keys_comparer = tkey_comparer());
 
 public:
     
     ~AVL_tree() noexcept final;
     
     AVL_tree(
-        AVL_tree<tkey, tvalue> const &other);
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
-    AVL_tree<tkey, tvalue> &operator=(
-        AVL_tree<tkey, tvalue> const &other);
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
     AVL_tree(
-        AVL_tree<tkey, tvalue> &&other) noexcept;
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
+    
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
+
+public:
+    
+    // region split and join definition
+    
+    // moves the entries with keys less than key into left and the rest into right in O(log n);
+    // the previous content of both parts is disposed, this tree ends up empty unless it is one of them
+    void split(
+        tkey const &key,
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &right);
+    
+    // replaces the content with the entries of left, the given entry and the entries of right in O(log n);
+    // all keys of left have to be less than key and all keys of right greater, both parts end up empty
+    void join(
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+        tkey const &key,
+        tvalue const &value,
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &right);
+    
+    // two splits and a join: O(log n) plus freeing the disposed nodes; returns how many entries were disposed
+    size_t dispose_between(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive);
+    
+    // endregion split and join definition
+
+public:
+    
+    // region set operations definition
+    
+    // the set operations take O(m log(n / m + 1)) work for trees of m <= n entries and are split across up to threads_limit
+    // threads for large trees (0 means one per hardware thread, 1 keeps them on the calling thread);
+    // on equal keys the entries of this tree are kept, other ends up empty
+    
+    void unite(
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+        size_t threads_limit = 0);
+    
+    void intersect(
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+        size_t threads_limit = 0);
+    
+    void subtract(
+        AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+        size_t threads_limit = 0);
     
-    AVL_tree<tkey, tvalue> &operator=(
-        AVL_tree<tkey, tvalue> &&other) noexcept;
+    // endregion set operations definition
+
+public:
+    
+    // walks the whole tree in O(n): every stored height is exact, sibling heights differ by at most one
+    // and the children link back to their parents
+    bool check_invariants() const noexcept;
+
+private:
+    
+    size_t get_node_size() const noexcept override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *construct_node(
+        void *at,
+        tkey const &key,
+        tvalue const &value) const override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *construct_iterator_data(
+        void *at,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *viewed,
+        unsigned int depth) const noexcept override;
+    
+    void initialize_balanced_node(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+        size_t subtree_height,
+        size_t,
+        size_t) const override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *join_subtrees(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const override;
+    
+    // descends the right spine of the taller left subtree to a node of about the right subtree height
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *join_right(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *join_left(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const;
+    
+    static size_t get_subtree_height(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept;
+    
+    // recomputes the heights from target up to the root, rotating every subtree whose heights went two apart
+    void rebalance_upwards(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept;
+    
+    static bool check_subtree(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root,
+        size_t &subtree_height) noexcept;
+    
+    static typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *link(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) noexcept;
     
 };
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue>::iterator_data::iterator_data(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data::iterator_data(
     unsigned int depth,
     tkey const &key,
     tvalue const &value,
     size_t subtree_height):
-    binary_search_tree<tkey, tvalue>::iterator_data(depth, key, value)
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data(depth, key, value),
+    subtree_height(subtree_height)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data::iterator_data(
+    unsigned int depth,
+    typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const &viewed) noexcept:
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data(depth, viewed),
+    subtree_height(viewed.subtree_height)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue>::iterator_data::iterator_data(unsigned int, tkey const &, tvalue const &, size_t)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(
-    AVL_tree<tkey, tvalue> *tree,
-    typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy):
-    binary_search_tree<tkey, tvalue>::insertion_template_method(tree, insertion_strategy)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::insertion_template_method(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(tree, insertion_strategy)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(AVL_tree<tkey, tvalue> *, typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(
-    AVL_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method::obtaining_template_method(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(AVL_tree<tkey, tvalue> *)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(
-    AVL_tree<tkey, tvalue> *tree,
-    typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::disposal_template_method(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(tree, disposal_strategy)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(AVL_tree<tkey, tvalue> *, typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue>::AVL_tree(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept
+{
+    static_cast<AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree)->rebalance_upwards(inserted->parent);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+    bool,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *) noexcept
+{
+    static_cast<AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree)->rebalance_upwards(parent);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::AVL_tree(
+    allocator *allocator,
+    logger *logger,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy,
+    tkey_comparer keys_comparer):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>(
+        new typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(this, insertion_strategy),
+        new typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(this),
+        new typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(this, disposal_strategy),
+        keys_comparer,
+        allocator,
+        logger)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tforward_iterator,
+    typename>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::AVL_tree(
+    tforward_iterator first,
+    tforward_iterator last,
     allocator *allocator,
     logger *logger,
-    typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy,
-    typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy)
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy,
+    tkey_comparer keys_comparer):
+    AVL_tree(allocator, logger, insertion_strategy, disposal_strategy, keys_comparer)
+{
+    this->assign_sorted(first, last);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::~AVL_tree() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue>::AVL_tree(allocator *, logger *, typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy, typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue>::~AVL_tree() noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::AVL_tree(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other):
+    AVL_tree(other.get_allocator(), other.get_logger())
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue>::~AVL_tree() noexcept", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue>::AVL_tree(
-    AVL_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue>::AVL_tree(AVL_tree<tkey, tvalue> const &)", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(other);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue> &AVL_tree<tkey, tvalue>::operator=(
-    AVL_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::AVL_tree(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept:
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>(std::move(other))
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue> &AVL_tree<tkey, tvalue>::operator=(AVL_tree<tkey, tvalue> const &)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue>::AVL_tree(
-    AVL_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue>::AVL_tree(AVL_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(std::move(other));
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-AVL_tree<tkey, tvalue> &AVL_tree<tkey, tvalue>::operator=(
-    AVL_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_node_size() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> AVL_tree<tkey, tvalue> &AVL_tree<tkey, tvalue>::operator=(AVL_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    return sizeof(typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::node);
 }
 
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::construct_node(
+    void *at,
+    tkey const &key,
+    tvalue const &value) const
+{
+    return new (at) typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::node(key, value);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::construct_iterator_data(
+    void *at,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *viewed,
+    unsigned int depth) const noexcept
+{
+    static_assert(sizeof(typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data) <= binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data_capacity, "the AVL iterator_data has to fit in an iterator");
+    
+    return new (at) typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data(depth, *static_cast<typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *>(viewed));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::initialize_balanced_node(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+    size_t subtree_height,
+    size_t,
+    size_t) const
+{
+    static_cast<typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(target)->subtree_height = subtree_height;
+}
+
+
+// region split and join implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::split(
+    tkey const &key,
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &right)
+{
+    this->split_into(key, left, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::join(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+    tkey const &key,
+    tvalue const &value,
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &right)
+{
+    this->join_from(left, key, value, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::dispose_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive)
+{
+    size_t disposed_count = this->dispose_range(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive);
+    
+    return disposed_count;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_subtrees(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const
+{
+    if (get_subtree_height(left) > get_subtree_height(right) + 1)
+    {
+        return join_right(left, pivot, right);
+    }
+    
+    if (get_subtree_height(right) > get_subtree_height(left) + 1)
+    {
+        return join_left(left, pivot, right);
+    }
+    
+    return link(pivot, left, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_right(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const
+{
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *outer = left->left_subtree;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inner = left->right_subtree;
+    
+    if (get_subtree_height(inner) <= get_subtree_height(right) + 1)
+    {
+        link(pivot, inner, right);
+        link(left, outer, pivot);
+        
+        if (get_subtree_height(pivot) <= get_subtree_height(outer) + 1)
+        {
+            return left;
+        }
+        
+        // pivot went two levels above outer: its left subtree is the taller one, so a big rotation rebalances
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *middle = pivot->left_subtree;
+        this->big_left_rotation(left, false);
+        link(middle->left_subtree, middle->left_subtree->left_subtree, middle->left_subtree->right_subtree);
+        link(middle->right_subtree, middle->right_subtree->left_subtree, middle->right_subtree->right_subtree);
+        
+        return link(middle, middle->left_subtree, middle->right_subtree);
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *joined = join_right(inner, pivot, right);
+    link(left, outer, joined);
+    
+    if (get_subtree_height(joined) <= get_subtree_height(outer) + 1)
+    {
+        return left;
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *former_root = left;
+    this->small_left_rotation(left, false);
+    link(former_root, former_root->left_subtree, former_root->right_subtree);
+    
+    return link(left, left->left_subtree, left->right_subtree);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_left(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const
+{
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *outer = right->right_subtree;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inner = right->left_subtree;
+    
+    if (get_subtree_height(inner) <= get_subtree_height(left) + 1)
+    {
+        link(pivot, left, inner);
+        link(right, pivot, outer);
+        
+        if (get_subtree_height(pivot) <= get_subtree_height(outer) + 1)
+        {
+            return right;
+        }
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *middle = pivot->right_subtree;
+        this->big_right_rotation(right, false);
+        link(middle->left_subtree, middle->left_subtree->left_subtree, middle->left_subtree->right_subtree);
+        link(middle->right_subtree, middle->right_subtree->left_subtree, middle->right_subtree->right_subtree);
+        
+        return link(middle, middle->left_subtree, middle->right_subtree);
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *joined = join_left(left, pivot, inner);
+    link(right, joined, outer);
+    
+    if (get_subtree_height(joined) <= get_subtree_height(outer) + 1)
+    {
+        return right;
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *former_root = right;
+    this->small_right_rotation(right, false);
+    link(former_root, former_root->left_subtree, former_root->right_subtree);
+    
+    return link(right, right->left_subtree, right->right_subtree);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_subtree_height(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept
+{
+    return subtree_root == nullptr
+        ? 0
+        : static_cast<typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *>(subtree_root)->subtree_height;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::rebalance_upwards(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept
+{
+    while (target != nullptr)
+    {
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root = this->get_link_to(target);
+        
+        if (get_subtree_height(target->left_subtree) > get_subtree_height(target->right_subtree) + 1)
+        {
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left = target->left_subtree;
+            
+            if (get_subtree_height(left->right_subtree) > get_subtree_height(left->left_subtree))
+            {
+                this->big_right_rotation(subtree_root, false);
+                link(left, left->left_subtree, left->right_subtree);
+            }
+            else
+            {
+                this->small_right_rotation(subtree_root, false);
+            }
+        }
+        else if (get_subtree_height(target->right_subtree) > get_subtree_height(target->left_subtree) + 1)
+        {
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right = target->right_subtree;
+            
+            if (get_subtree_height(right->left_subtree) > get_subtree_height(right->right_subtree))
+            {
+                this->big_left_rotation(subtree_root, false);
+                link(right, right->left_subtree, right->right_subtree);
+            }
+            else
+            {
+                this->small_left_rotation(subtree_root, false);
+            }
+        }
+        
+        // target went below the node rotated above it, if any; the heights are fixed bottom up
+        link(target, target->left_subtree, target->right_subtree);
+        if (subtree_root != target)
+        {
+            link(subtree_root, subtree_root->left_subtree, subtree_root->right_subtree);
+        }
+        
+        target = subtree_root->parent;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::link(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) noexcept
+{
+    parent->left_subtree = left;
+    parent->right_subtree = right;
+    
+    for (typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree: { left, right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = parent;
+        }
+    }
+    
+    static_cast<typename AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(parent)->subtree_height = std::max(get_subtree_height(left), get_subtree_height(right)) + 1;
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::update_augmentation(parent);
+    
+    return parent;
+}
+
+// endregion split and join implementation
+
+// region set operations implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::unite(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+    size_t threads_limit)
+{
+    this->combine_from(other, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_operation::unite, threads_limit);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::intersect(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+    size_t threads_limit)
+{
+    this->combine_from(other, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_operation::intersect, threads_limit);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::subtract(
+    AVL_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+    size_t threads_limit)
+{
+    this->combine_from(other, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_operation::subtract, threads_limit);
+}
+
+// endregion set operations implementation
+
+// region invariants implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::check_invariants() const noexcept
+{
+    size_t height;
+    
+    return (this->get_root() == nullptr || this->get_root()->parent == nullptr) && check_subtree(this->get_root(), height);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool AVL_tree<tkey, tvalue, tkey_comparer, taugmentation>::check_subtree(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root,
+    size_t &subtree_height) noexcept
+{
+    if (subtree_root == nullptr)
+    {
+        subtree_height = 0;
+        
+        return true;
+    }
+    
+    size_t left_height;
+    size_t right_height;
+    
+    if ((subtree_root->left_subtree != nullptr && subtree_root->left_subtree->parent != subtree_root) ||
+        (subtree_root->right_subtree != nullptr && subtree_root->right_subtree->parent != subtree_root) ||
+        !check_subtree(subtree_root->left_subtree, left_height) ||
+        !check_subtree(subtree_root->right_subtree, right_height) ||
+        left_height > right_height + 1 ||
+        right_height > left_height + 1)
+    {
+        return false;
+    }
+    
+    subtree_height = std::max(left_height, right_height) + 1;
+    
+    return get_subtree_height(subtree_root) == subtree_height;
+}
+
+// endregion invariants implementation
+
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_AVL_TREE_H
\ No newline at end of file
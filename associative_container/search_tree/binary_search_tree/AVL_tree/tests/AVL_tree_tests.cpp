@@ -2,6 +2,7 @@
 #include <AVL_tree.h>
 #include <logger_builder.h>
 #include <client_logger_builder.h>
+#include <search_tree_checks.h>
 #include <iostream>
 
 logger *create_logger(
@@ -420,7 +421,7 @@ TEST(AVLTreePositiveTests, test7)
         {
             AVL_tree<int, std::string>::iterator_data(2, 2, "l", 1),
             AVL_tree<int, std::string>::iterator_data(1, 4, "j", 2),
-            AVL_tree<int, std::string>::iterator_data(1, 5, "b", 1),
+            AVL_tree<int, std::string>::iterator_data(2, 5, "b", 1),
             AVL_tree<int, std::string>::iterator_data(0, 6, "a", 3),
             AVL_tree<int, std::string>::iterator_data(1, 8, "c", 2),
             AVL_tree<int, std::string>::iterator_data(2, 15, "x", 1)
@@ -613,6 +614,180 @@ TEST(AVLTreePositiveTests, test11)
     delete logger;
 }
 
+TEST(AVLTreePositiveTests, test12)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test12 started");
+    
+    check_bulk_load_and_updates<AVL_tree>(logger);
+    
+    logger->trace("AVLTreePositiveTests.test12 finished");
+    
+    delete logger;
+}
+
+TEST(AVLTreePositiveTests, test13)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test13 started");
+    
+    check_ascending_updates<AVL_tree>(logger);
+    
+    logger->trace("AVLTreePositiveTests.test13 finished");
+    
+    delete logger;
+}
+
+TEST(AVLTreePositiveTests, test14)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test14 started");
+    
+    check_insert_many<AVL_tree>(logger);
+    
+    logger->trace("AVLTreePositiveTests.test14 finished");
+    
+    delete logger;
+}
+
+TEST(AVLTreePositiveTests, test15)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test15 started");
+    
+    check_dispose_many<AVL_tree>(logger);
+    
+    logger->trace("AVLTreePositiveTests.test15 finished");
+    
+    delete logger;
+}
+
+TEST(AVLTreePositiveTests, test16)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test16 started");
+    
+    // every part of a split and every join keeps its balance factors within one
+    check_split_and_join<AVL_tree>(logger);
+    
+    logger->trace("AVLTreePositiveTests.test16 finished");
+    
+    delete logger;
+}
+
+TEST(AVLTreePositiveTests, test17)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test17 started");
+    
+    check_set_operations<AVL_tree>(logger);
+    
+    logger->trace("AVLTreePositiveTests.test17 finished");
+    
+    delete logger;
+}
+
+TEST(AVLTreePositiveTests, test18)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test18 started");
+    
+    check_rank_and_select<AVL_tree>(logger);
+    
+    logger->trace("AVLTreePositiveTests.test18 finished");
+    
+    delete logger;
+}
+
+TEST(AVLTreePositiveTests, test19)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test19 started");
+    
+    check_range_aggregates<AVL_tree>(logger);
+    
+    logger->trace("AVLTreePositiveTests.test19 finished");
+    
+    delete logger;
+}
+
+TEST(AVLTreePositiveTests, test20)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("AVLTreePositiveTests.test20 started");
+    
+    AVL_tree<int, std::string> tree(nullptr, logger);
+    
+    check_range_queries(tree);
+    
+    logger->trace("AVLTreePositiveTests.test20 finished");
+    
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
@@ -1,26 +1,235 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <stack>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <logger.h>
 #include <logger_guardant.h>
 #include <allocator.h>
 #include <allocator_guardant.h>
+#include <allocator_pool.h>
 #include <not_implemented.h>
 #include <search_tree.h>
 
+// node augmentations keep a summary of every subtree in its root: the node type derives from the augmentation
+// and the tree calls recompute (which must not throw) on a node whenever its subtrees change, bottom-up
+struct no_augmentation
+{
+
+public:
+    
+    template<
+        typename tkey,
+        typename tvalue>
+    void recompute(
+        tkey const &,
+        tvalue const &,
+        no_augmentation const *,
+        no_augmentation const *) noexcept
+    {
+    
+    }
+    
+};
+
+// counts the entries of every subtree, which rank, select and count_between descend by
+struct subtree_size_augmentation
+{
+
+public:
+    
+    size_t subtree_size = 1;
+
+public:
+    
+    template<
+        typename tkey,
+        typename tvalue>
+    void recompute(
+        tkey const &,
+        tvalue const &,
+        subtree_size_augmentation const *left_subtree,
+        subtree_size_augmentation const *right_subtree) noexcept
+    {
+        subtree_size = 1 +
+            (left_subtree == nullptr
+                ? 0
+                : left_subtree->subtree_size) +
+            (right_subtree == nullptr
+                ? 0
+                : right_subtree->subtree_size);
+    }
+    
+};
+
+// folds tmonoid over every subtree in key order, which aggregate_between combines in O(log n);
+// tmonoid provides value_type, identity(), of(key, value) and an associative combine(left, right), all of them noexcept.
+// Subtree sizes are kept as well, so the order statistics stay available
+template<
+    typename tmonoid>
+struct monoid_augmentation:
+    public subtree_size_augmentation
+{
+
+public:
+    
+    typedef typename tmonoid::value_type aggregate_type;
+    
+    aggregate_type subtree_aggregate = tmonoid::identity();
+
+public:
+    
+    template<
+        typename tkey,
+        typename tvalue>
+    void recompute(
+        tkey const &key,
+        tvalue const &value,
+        monoid_augmentation const *left_subtree,
+        monoid_augmentation const *right_subtree) noexcept
+    {
+        // recompute runs inside the rotations and joins, where an exception would leave the tree half relinked
+        static_assert(noexcept(tmonoid::identity()) &&
+            noexcept(tmonoid::of(key, value)) &&
+            noexcept(tmonoid::combine(std::declval<aggregate_type const &>(), std::declval<aggregate_type const &>())) &&
+            std::is_nothrow_move_assignable<aggregate_type>::value &&
+            std::is_nothrow_copy_constructible<aggregate_type>::value,
+            "identity, of and combine of a monoid augmentation have to be noexcept, as well as copying its aggregate");
+        
+        subtree_size_augmentation::recompute(key, value, left_subtree, right_subtree);
+        
+        subtree_aggregate = tmonoid::combine(
+            tmonoid::combine(
+                left_subtree == nullptr
+                    ? tmonoid::identity()
+                    : left_subtree->subtree_aggregate,
+                tmonoid::of(key, value)),
+            right_subtree == nullptr
+                ? tmonoid::identity()
+                : right_subtree->subtree_aggregate);
+    }
+    
+    static aggregate_type identity() noexcept
+    {
+        return tmonoid::identity();
+    }
+    
+    template<
+        typename tkey,
+        typename tvalue>
+    static aggregate_type of(
+        tkey const &key,
+        tvalue const &value) noexcept
+    {
+        return tmonoid::of(key, value);
+    }
+    
+    static aggregate_type combine(
+        aggregate_type const &left,
+        aggregate_type const &right) noexcept
+    {
+        return tmonoid::combine(left, right);
+    }
+    
+};
+
+template<
+    typename tvalue>
+struct values_sum
+{
+
+public:
+    
+    typedef tvalue value_type;
+
+public:
+    
+    static tvalue identity() noexcept(std::is_nothrow_default_constructible<tvalue>::value)
+    {
+        return tvalue();
+    }
+    
+    template<
+        typename tkey>
+    static tvalue of(
+        tkey const &,
+        tvalue const &value) noexcept(std::is_nothrow_copy_constructible<tvalue>::value)
+    {
+        return value;
+    }
+    
+    static tvalue combine(
+        tvalue const &left,
+        tvalue const &right) noexcept(noexcept(tvalue(left + right)))
+    {
+        return left + right;
+    }
+    
+};
+
 template<
-    typename tkey,
     typename tvalue>
+struct values_max
+{
+
+public:
+    
+    typedef tvalue value_type;
+
+public:
+    
+    static tvalue identity() noexcept(std::is_nothrow_copy_constructible<tvalue>::value)
+    {
+        return std::numeric_limits<tvalue>::lowest();
+    }
+    
+    template<
+        typename tkey>
+    static tvalue of(
+        tkey const &,
+        tvalue const &value) noexcept(std::is_nothrow_copy_constructible<tvalue>::value)
+    {
+        return value;
+    }
+    
+    static tvalue combine(
+        tvalue const &left,
+        tvalue const &right) noexcept(noexcept(left < right) && std::is_nothrow_copy_constructible<tvalue>::value)
+    {
+        return left < right
+            ? right
+            : left;
+    }
+    
+};
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer = default_keys_comparer<tkey>,
+    typename taugmentation = no_augmentation>
 class binary_search_tree:
-    public search_tree<tkey, tvalue>
+    public search_tree<tkey, tvalue, tkey_comparer>
 {
 
 protected:
     
-    struct node
+    struct node:
+        public taugmentation
     {
     
     public:
@@ -32,6 +241,9 @@ protected:
         node *left_subtree;
         
         node *right_subtree;
+        
+        // kept up to date by insertion, disposal and the rotations, so traversals need no stack
+        node *parent;
     
     public:
         
@@ -49,16 +261,23 @@ public:
     
     // region iterators definition
     
+    // an entry together with its depth; the one an iterator is dereferenced to views the node, so reading an entry
+    // copies neither its key nor its value, and stays valid until that iterator is dereferenced again or destroyed.
+    // Constructed from a key and a value it owns a copy of them instead, e.g. to hold an expected traversal
     struct iterator_data
     {
     
+    private:
+        
+        std::shared_ptr<std::pair<tkey, tvalue> const> _entry;
+    
     public:
         
         unsigned int depth;
         
-        tkey key;
+        tkey const &key;
         
-        tvalue value;
+        tvalue const &value;
     
     public:
     
@@ -67,15 +286,23 @@ public:
             tkey const &key,
             tvalue const &value);
         
+        explicit iterator_data(
+            unsigned int depth,
+            node const &viewed) noexcept;
+        
     };
     
+    // iterators construct the iterator_data of the tree they walk in this much room of their own
+    static constexpr size_t iterator_data_capacity = sizeof(iterator_data) + sizeof(std::max_align_t);
+    
     class prefix_iterator final
     {
     
     public:
         
         explicit prefix_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -90,7 +317,28 @@ public:
         prefix_iterator const operator++(
             int not_used);
         
-        iterator_data *operator*() const;
+        iterator_data *operator*() const noexcept;
+        
+        iterator_data *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -100,7 +348,8 @@ public:
     public:
         
         explicit prefix_const_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -115,7 +364,28 @@ public:
         prefix_const_iterator const operator++(
             int not_used);
         
-        iterator_data const *operator*() const;
+        iterator_data const *operator*() const noexcept;
+        
+        iterator_data const *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue const &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -125,7 +395,8 @@ public:
     public:
         
         explicit prefix_reverse_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -140,7 +411,28 @@ public:
         prefix_reverse_iterator const operator++(
             int not_used);
         
-        iterator_data *operator*() const;
+        iterator_data *operator*() const noexcept;
+        
+        iterator_data *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -150,7 +442,8 @@ public:
     public:
         
         explicit prefix_const_reverse_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -165,17 +458,41 @@ public:
         prefix_const_reverse_iterator const operator++(
             int not_used);
         
-        iterator_data const *operator*() const;
+        iterator_data const *operator*() const noexcept;
+        
+        iterator_data const *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue const &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
     class infix_iterator final
     {
+        
+        friend class binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>;
     
     public:
         
         explicit infix_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -190,17 +507,41 @@ public:
         infix_iterator const operator++(
             int not_used);
         
-        iterator_data *operator*() const;
+        iterator_data *operator*() const noexcept;
+        
+        iterator_data *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
     class infix_const_iterator final
     {
+        
+        friend class binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>;
     
     public:
         
         explicit infix_const_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -215,7 +556,28 @@ public:
         infix_const_iterator const operator++(
             int not_used);
         
-        iterator_data const *operator*() const;
+        iterator_data const *operator*() const noexcept;
+        
+        iterator_data const *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue const &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -225,7 +587,8 @@ public:
     public:
         
         explicit infix_reverse_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -240,7 +603,28 @@ public:
         infix_reverse_iterator const operator++(
             int not_used);
         
-        iterator_data *operator*() const;
+        iterator_data *operator*() const noexcept;
+        
+        iterator_data *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -250,7 +634,8 @@ public:
     public:
         
         explicit infix_const_reverse_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -265,7 +650,28 @@ public:
         infix_const_reverse_iterator const operator++(
             int not_used);
         
-        iterator_data const *operator*() const;
+        iterator_data const *operator*() const noexcept;
+        
+        iterator_data const *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue const &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -275,7 +681,8 @@ public:
     public:
         
         explicit postfix_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -290,7 +697,28 @@ public:
         postfix_iterator const operator++(
             int not_used);
         
-        iterator_data *operator*() const;
+        iterator_data *operator*() const noexcept;
+        
+        iterator_data *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -300,7 +728,8 @@ public:
     public:
         
         explicit postfix_const_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -315,7 +744,28 @@ public:
         postfix_const_iterator const operator++(
             int not_used);
         
-        iterator_data const *operator*() const;
+        iterator_data const *operator*() const noexcept;
+        
+        iterator_data const *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue const &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -325,7 +775,8 @@ public:
     public:
         
         explicit postfix_reverse_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -340,7 +791,28 @@ public:
         postfix_reverse_iterator const operator++(
             int not_used);
         
-        iterator_data *operator*() const;
+        iterator_data *operator*() const noexcept;
+        
+        iterator_data *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
@@ -350,7 +822,8 @@ public:
     public:
         
         explicit postfix_const_reverse_iterator(
-            typename binary_search_tree<tkey, tvalue>::node *subtree_root);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root);
     
     public:
         
@@ -365,13 +838,34 @@ public:
         postfix_const_reverse_iterator const operator++(
             int not_used);
         
-        iterator_data const *operator*() const;
+        iterator_data const *operator*() const noexcept;
+        
+        iterator_data const *operator->() const noexcept;
+    
+    public:
+        
+        // depth of the current node below the root
+        unsigned int depth() const noexcept;
+        
+        tkey const &key() const noexcept;
+        
+        tvalue const &value() const noexcept;
+    
+    private:
+        
+        unsigned int _depth;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *_current_node;
+        
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *_tree;
+        
+        alignas(std::max_align_t) mutable unsigned char _data[iterator_data_capacity];
         
     };
     
     // endregion iterators definition
 
-protected:
+public:
     
     // region target operations strategies definition
     
@@ -388,6 +882,8 @@ protected:
     };
     
     // endregion target operations strategies definition
+
+protected:
     
     // region target operations associated exception types
     
@@ -456,14 +952,20 @@ protected:
         public logger_guardant
     {
     
-    private:
+    protected:
     
-        binary_search_tree<tkey, tvalue> *_tree;
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *_tree;
         
     public:
     
         explicit template_method_basics(
-            binary_search_tree<tkey, tvalue> *tree);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
+        
+    public:
+        
+        // a moved tree takes its template methods along
+        void rebind(
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree) noexcept;
         
     protected:
         
@@ -482,13 +984,13 @@ protected:
     
     private:
         
-        binary_search_tree<tkey, tvalue> *_tree;
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy _insertion_strategy;
     
     public:
         
         explicit insertion_template_method(
-            binary_search_tree<tkey, tvalue> *tree,
-            typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy);
         
     public:
         
@@ -501,14 +1003,25 @@ protected:
             tvalue &&value);
     
         void set_insertion_strategy(
-            typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy) noexcept;
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy) noexcept;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy get_insertion_strategy() const noexcept;
     
     protected:
         
-        // TODO: think about it!
+        // called once the new node is linked in as a leaf: refreshes the augmentations up to the root,
+        // balanced trees restore their invariants on the way up as well
+        virtual void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept;
     
     private:
         
+        template<
+            typename tvalue_reference>
+        void insert_entry(
+            tkey const &key,
+            tvalue_reference &&value);
+        
         [[nodiscard]] allocator *get_allocator() const noexcept final;
         
     };
@@ -517,23 +1030,16 @@ protected:
         public template_method_basics
     {
     
-    private:
-        
-        binary_search_tree<tkey, tvalue> *_tree;
-    
     public:
         
         explicit obtaining_template_method(
-            binary_search_tree<tkey, tvalue> *tree);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
     
     public:
         
-        tvalue const &obtain(
+        // self-adjusting trees restructure around the node they look up, so they override the whole lookup
+        virtual tvalue const &obtain(
             tkey const &key);
-    
-    protected:
-        
-        // TODO: think about it!
         
     };
     
@@ -544,13 +1050,13 @@ protected:
     
     private:
         
-        binary_search_tree<tkey, tvalue> *_tree;
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy _disposal_strategy;
     
     public:
         
         explicit disposal_template_method(
-            binary_search_tree<tkey, tvalue> *tree,
-            typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy);
+            binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy);
         
     public:
         
@@ -558,11 +1064,23 @@ protected:
             tkey const &key);
         
         void set_disposal_strategy(
-            typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy) noexcept;
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy) noexcept;
+        
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy get_disposal_strategy() const noexcept;
     
     protected:
         
-        // TODO: think about it!
+        // called with the node holding the key; returns the node with at most one subtree to unlink instead, the entry
+        // of which target takes over: target itself or, when target has both subtrees, by default its in-order predecessor
+        virtual typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *select_node_to_unlink(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept;
+        
+        // called once disposed, holding at most one subtree, has been replaced by it under parent on the given side;
+        // disposed is not freed yet, so the fields trees add to their nodes can still be read from it
+        virtual void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+            bool from_left_subtree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *disposed) noexcept;
     
     private:
         
@@ -581,39 +1099,59 @@ private:
     obtaining_template_method *_obtaining_template;
     
     disposal_template_method *_disposal_template;
+    
+    // shared between the trees that exchange nodes through split and join
+    mutable std::shared_ptr<allocator_pool> _nodes_pool;
+
+private:
+    
+    // a moved-from tree keeps no template methods, so it may only be destroyed or assigned to
+    void rebind_template_methods() noexcept;
 
 protected:
     
     explicit binary_search_tree(
-        typename binary_search_tree<tkey, tvalue>::insertion_template_method *insertion_template,
-        typename binary_search_tree<tkey, tvalue>::obtaining_template_method *obtaining_template,
-        typename binary_search_tree<tkey, tvalue>::disposal_template_method *disposal_template,
-        std::function<int(tkey const &, tkey const &)>,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method *insertion_template,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method *obtaining_template,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method *disposal_template,
+        tkey_comparer,
         allocator *allocator,
         logger *logger);
 
 public:
     
     explicit binary_search_tree(
-        std::function<int(tkey const &, tkey const &)> comparer = std::less<tkey>(),
+        tkey_comparer comparer = tkey_comparer(),
         allocator *allocator = nullptr,
         logger *logger = nullptr,
-        typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
-        typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception);
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception);
+    
+    template<
+        typename tforward_iterator,
+        typename = typename std::iterator_traits<tforward_iterator>::iterator_category>
+    explicit binary_search_tree(
+        tforward_iterator first,
+        tforward_iterator last,
+        tkey_comparer comparer = tkey_comparer(),
+        allocator *allocator = nullptr,
+        logger *logger = nullptr,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception);
 
 public:
     
     binary_search_tree(
-        binary_search_tree<tkey, tvalue> const &other);
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
     binary_search_tree(
-        binary_search_tree<tkey, tvalue> &&other) noexcept;
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
     
-    binary_search_tree<tkey, tvalue> &operator=(
-        binary_search_tree<tkey, tvalue> const &other);
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
-    binary_search_tree<tkey, tvalue> &operator=(
-        binary_search_tree<tkey, tvalue> &&other) noexcept;
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
     
     ~binary_search_tree() override;
 
@@ -642,10 +1180,10 @@ public:
 public:
     
     void set_insertion_strategy(
-        typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy) noexcept;
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy) noexcept;
     
     void set_removal_strategy(
-        typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy) noexcept;
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy) noexcept;
 
 public:
     
@@ -701,63 +1239,503 @@ public:
     
     // endregion iterators requests definition
 
+public:
+    
+    // region range queries definition
+    
+    // the bounds are found in a single descent, so the first entry of a range is reached in O(log n)
+    
+    infix_iterator lower_bound(
+        tkey const &key) const;
+    
+    infix_iterator upper_bound(
+        tkey const &key) const;
+    
+    infix_const_iterator clower_bound(
+        tkey const &key) const;
+    
+    infix_const_iterator cupper_bound(
+        tkey const &key) const;
+    
+    // calls visitor(key, value) for the entries of the range in key order without copying them;
+    // the scan stops as soon as the visitor returns false
+    template<
+        typename tvisitor>
+    void for_each_between(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive,
+        tvisitor &&visitor) const;
+    
+    // endregion range queries definition
+
+public:
+    
+    // region order statistics definition
+    
+    // require subtree_size_augmentation (or an augmentation derived from it) as taugmentation;
+    // each query is a single descent, so O(log n) on the balanced trees
+    
+    // count of the entries with keys less than key
+    size_t rank(
+        tkey const &key) const;
+    
+    // the entry with the index-th smallest key (counting from 0) or the end iterator if there are not that many entries
+    infix_const_iterator select(
+        size_t index) const;
+    
+    size_t count_between(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive) const;
+    
+    // endregion order statistics definition
+
+public:
+    
+    // region range aggregates definition
+    
+    // requires a monoid_augmentation as taugmentation (the template parameter only defers that check to the call):
+    // the monoid folded over the entries of the range in key order, from O(log n) subtree aggregates
+    // along the two bound paths, without visiting the entries themselves
+    template<
+        typename tmonoid_augmentation = taugmentation>
+    typename tmonoid_augmentation::aggregate_type aggregate_between(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive) const;
+    
+    // endregion range aggregates definition
+
+public:
+    
+    // region bulk loading definition
+    
+    // replaces the content with key_value_pairs given in strictly ascending key order: a perfectly balanced
+    // tree is built in O(n) without comparisons beyond the order check and without rotations;
+    // throws std::logic_error (leaving the tree unchanged) if the input is not strictly ascending
+    template<
+        typename tforward_iterator>
+    void assign_sorted(
+        tforward_iterator first,
+        tforward_iterator last);
+    
+    // same for input in any order: the pairs are sorted first, so the whole load is O(n log n)
+    template<
+        typename tinput_iterator>
+    void assign(
+        tinput_iterator first,
+        tinput_iterator last);
+    
+    // endregion bulk loading definition
+
+public:
+    
+    // region batched updates definition
+    
+    // the sorted batch is split at its median entry, which splits the tree as well; both halves are inserted recursively
+    // and joined back around it, so K entries go into N in O(K log K + K log(N / K + 1)) with a balanced join_subtrees.
+    // Later duplicates inside the batch win, as with sequential inserts. Existent keys follow the insertion strategy;
+    // with throw_an_exception (also thrown for a duplicate inside the batch) nothing is changed before the throw
+    template<
+        typename tinput_iterator>
+    void insert_many(
+        tinput_iterator first,
+        tinput_iterator last);
+    
+    // same recursion for a batch of keys, joining the halves without the median; repeated keys are disposed once.
+    // Nonexistent keys follow the disposal strategy, returns how many entries were disposed
+    template<
+        typename tinput_iterator>
+    size_t dispose_many(
+        tinput_iterator first,
+        tinput_iterator last);
+    
+    // endregion batched updates definition
+
+protected:
+    
+    // first node whose key is not less than (inclusive) or greater than (not inclusive) the given one
+    node *find_bound(
+        tkey const &key,
+        bool inclusive) const;
+
 protected:
     
     // region subtree rotations definition
     
     void small_left_rotation(
-        typename binary_search_tree<tkey, tvalue>::node *&subtree_root,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
         bool validate = true) const;
     
     void small_right_rotation(
-        typename binary_search_tree<tkey, tvalue>::node *&subtree_root,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
         bool validate = true) const;
     
     void big_left_rotation(
-        typename binary_search_tree<tkey, tvalue>::node *&subtree_root,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
         bool validate = true) const;
     
     void big_right_rotation(
-        typename binary_search_tree<tkey, tvalue>::node *&subtree_root,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
         bool validate = true) const;
     
     void double_left_rotation(
-        typename binary_search_tree<tkey, tvalue>::node *&subtree_root,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
         bool at_grandparent_first,
         bool validate = true) const;
     
     void double_right_rotation(
-        typename binary_search_tree<tkey, tvalue>::node *&subtree_root,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
         bool at_grandparent_first,
         bool validate = true) const;
     
+    // recomputes the augmentation of the node from its own entry and its subtrees' augmentations
+    static void update_augmentation(
+        node *target) noexcept;
+    
+    // same for target and all of its ancestors; rotations keep the ancestors' augmentations valid, as they keep the order
+    static void update_augmentations_upwards(
+        node *target) noexcept;
+    
+    // the parent's subtree pointer referring to target or the root pointer, to rotate target's subtree in place
+    node *&get_link_to(
+        node *target) noexcept;
+    
     // endregion subtree rotations definition
+
+protected:
+    
+    // region stackless traversal definition
+    
+    // every step climbs or descends along parent and child links only; a whole traversal touches each edge
+    // at most twice, so operator++ is O(1) amortized. Mirrored traversals swap left and right subtrees.
+    // When depth is given, it follows the returned node by counting the same climbs and descents.
+    
+    // a prefix traversal starts at the subtree root in either direction
+    static node *prefix_first(
+        node *subtree_root) noexcept;
+    
+    static node *prefix_next(
+        node *current,
+        bool mirrored,
+        unsigned int *depth = nullptr) noexcept;
+    
+    static node *infix_first(
+        node *subtree_root,
+        bool mirrored,
+        unsigned int *depth = nullptr) noexcept;
+    
+    static node *infix_next(
+        node *current,
+        bool mirrored,
+        unsigned int *depth = nullptr) noexcept;
+    
+    static node *postfix_first(
+        node *subtree_root,
+        bool mirrored,
+        unsigned int *depth = nullptr) noexcept;
+    
+    static node *postfix_next(
+        node *current,
+        bool mirrored,
+        unsigned int *depth = nullptr) noexcept;
+    
+    static unsigned int depth_of(
+        node const *target) noexcept;
+    
+    static void step_depth(
+        unsigned int *depth,
+        int delta) noexcept;
+    
+    // endregion stackless traversal definition
+
+protected:
+    
+    // region nodes allocation definition
+    
+    static constexpr size_t nodes_per_slab = 64;
+    
+    // trees with extended nodes (AVL height, RB colour, ...) report the size of their node type here
+    virtual size_t get_node_size() const noexcept;
+    
+    // nodes are taken from a pool of get_node_size() blocks over the tree allocator, so inserts and disposals
+    // recycle nodes locally and the tree allocator is asked for memory once per nodes_per_slab nodes
+    [[nodiscard]] allocator *get_nodes_allocator() const;
+    
+    // endregion nodes allocation definition
+
+protected:
+    
+    // region nodes construction definition
+    
+    // trees with extended nodes construct their own node type in the get_node_size() bytes at the given address
+    virtual node *construct_node(
+        void *at,
+        tkey const &key,
+        tvalue const &value) const;
+    
+    // trees with their own iterator_data (AVL height, RB colour, ...) construct it at the given address,
+    // in at most iterator_data_capacity bytes, as a view of the node
+    virtual iterator_data *construct_iterator_data(
+        void *at,
+        node const *viewed,
+        unsigned int depth) const noexcept;
+    
+    // called for every node of a subtree built by assign_sorted, bottom up; the tree built has
+    // complete_levels_count completely filled levels and at most one more, partially filled, level below them
+    virtual void initialize_balanced_node(
+        node *target,
+        size_t subtree_height,
+        size_t depth,
+        size_t complete_levels_count) const;
+    
+    node *create_node(
+        tkey const &key,
+        tvalue const &value) const;
+    
+    void destroy_subtree(
+        node *subtree_root) const noexcept;
+    
+    template<
+        typename tforward_iterator>
+    node *build_balanced(
+        tforward_iterator &current,
+        size_t count,
+        size_t depth,
+        size_t complete_levels_count,
+        node *&previous,
+        size_t &subtree_height) const;
+    
+    // relinks nodes given in key order into a perfectly balanced subtree without allocations
+    node *link_balanced(
+        node *const *nodes,
+        size_t count,
+        size_t depth,
+        size_t complete_levels_count,
+        size_t &subtree_height) const;
+    
+    static size_t get_complete_levels_count(
+        size_t nodes_count) noexcept;
+    
+    // endregion nodes construction definition
+
+protected:
+    
+    // region split and join definition
+    
+    node *get_root() const noexcept;
+    
+    // takes the whole content out of the tree, leaving it empty; the nodes still belong to this tree's nodes pool
+    node *detach_root() noexcept;
+    
+    // disposes the current content and makes the subtree, whose nodes belong to the pool of nodes_owner, the new one
+    void attach_root(
+        node *subtree_root,
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &nodes_owner);
+    
+    bool shares_nodes_pool_with(
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other) const noexcept;
+    
+    // copies a subtree of another tree's nodes into this tree's pool as a balanced subtree, O(n)
+    node *relocate_subtree(
+        node const *subtree_root) const;
+    
+    // hangs left and right under pivot, given that all keys of left < pivot key < all keys of right;
+    // balanced trees override it with a join restoring their balance in O(difference of the subtrees heights)
+    virtual node *join_subtrees(
+        node *left,
+        node *pivot,
+        node *right) const;
+    
+    // makes a subtree put together by the joins the whole content; the red-black tree turns its root black here,
+    // as its joins may leave a red subtree root
+    virtual void settle_root(
+        node *subtree_root) noexcept;
+    
+    node *join_adjacent_subtrees(
+        node *left,
+        node *right) const;
+    
+    // keys less than key (and key itself if key_goes_left) end up in left, the rest in right;
+    // O(log n) with a balanced join_subtrees, as the costs of the joins along the search path telescope.
+    // The splits are virtual for the trees that have to carry the heights of the parts along to keep that bound
+    virtual void split_subtree(
+        node *subtree_root,
+        tkey const &key,
+        bool key_goes_left,
+        node *&left,
+        node *&right) const;
+    
+    virtual node *split_last(
+        node *subtree_root,
+        node *&last) const;
+    
+    void split_into(
+        tkey const &key,
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &right);
+    
+    void join_from(
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+        tkey const &key,
+        tvalue const &value,
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &right);
+    
+    size_t dispose_range(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive);
+    
+    // endregion split and join definition
+
+protected:
+    
+    // region set operations definition
+    
+    enum class set_operation
+    {
+        unite,
+        intersect,
+        subtract
+    };
+    
+    // subtrees whose left spines are shorter are combined on the calling thread
+    static constexpr size_t parallel_set_operation_min_spine_length = 12;
+    
+    // combines the content of other into this tree by join based divide and conquer: other's root key splits this tree,
+    // both halves are combined recursively (forked to another thread near the top of the recursion) and joined back,
+    // which takes O(m log(n / m + 1)) work with a balanced join_subtrees;
+    // on equal keys this tree's entries are kept, other ends up empty.
+    // At most threads_limit threads (0 means one per hardware thread) work at once, a fork without a spare thread
+    // runs on the forking one. Only the relocation of other's nodes for a union allocates, and a failure there leaves
+    // both trees as they were; past it a throwing keys comparer is the only way out, which leaves both trees unusable
+    void combine_from(
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+        set_operation operation,
+        size_t threads_limit);
+    
+    // the discarded subtrees are chained through the parent pointers of their roots, so nothing is allocated on the way
+    node *combine_subtrees(
+        node *own,
+        node *other,
+        set_operation operation,
+        size_t parallel_depth,
+        std::atomic<size_t> &spare_threads,
+        node *&discarded_own,
+        node *&discarded_other) const;
+    
+    static void discard(
+        node *subtree_root,
+        node *&discarded) noexcept;
+    
+    static void append_discarded(
+        node *&discarded,
+        node *more_discarded) noexcept;
+    
+    void destroy_discarded(
+        node *discarded) const noexcept;
+    
+    // the node with key, if any, is cut out of the subtree; the rest is split into left and right parts
+    virtual node *split_around(
+        node *subtree_root,
+        tkey const &key,
+        node *&left,
+        node *&right) const;
+    
+    static size_t get_parallel_depth(
+        size_t threads_count) noexcept;
+    
+    static size_t get_left_spine_length(
+        node const *subtree_root) noexcept;
+    
+    // endregion set operations definition
+
+protected:
+    
+    // region order statistics helpers definition
+    
+    static size_t get_subtree_size(
+        node const *subtree_root) noexcept;
+    
+    // count of the entries with keys less than (or, if inclusive, equal to) key
+    size_t count_less(
+        tkey const &key,
+        bool inclusive) const;
+    
+    // endregion order statistics helpers definition
+
+protected:
+    
+    // region batched updates helpers definition
+    
+    // sets present[i] for each of the sorted keys[first, last) found in the subtree, changing nothing:
+    // the keys are partitioned by every visited node, so only O(K log(N / K + 1)) nodes are visited
+    void mark_present(
+        node const *subtree_root,
+        std::vector<tkey const *> const &keys,
+        size_t first,
+        size_t last,
+        std::vector<bool> &present) const;
+    
+    // the nodes of the batch with keys equal to the ones in the subtree replace them, the replaced nodes are collected
+    node *insert_subtrees(
+        node *subtree_root,
+        node *const *batch,
+        size_t count,
+        std::vector<node *> &replaced) const;
+    
+    node *dispose_subtrees(
+        node *subtree_root,
+        tkey const *keys,
+        size_t count,
+        std::vector<node *> &disposed) const;
+    
+    // endregion batched updates helpers definition
     
 };
 
-// region binary_search_tree<tkey, tvalue>::node methods implementation
+// region binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node methods implementation
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::node::node(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node::node(
     tkey const &key,
-    tvalue const &value)
+    tvalue const &value):
+    key(key),
+    value(value),
+    left_subtree(nullptr),
+    right_subtree(nullptr),
+    parent(nullptr)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::node::node(tkey const &, tvalue const &)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::node::node(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node::node(
     tkey const &key,
-    tvalue &&value)
+    tvalue &&value):
+    key(key),
+    value(std::move(value)),
+    left_subtree(nullptr),
+    right_subtree(nullptr),
+    parent(nullptr)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::node::node(tkey const &, tvalue &&)", "your code should be here...");
+
 }
 
-// endregion binary_search_tree<tkey, tvalue>::node methods implementation
+// endregion binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node methods implementation
 
 // region iterators implementation
 
@@ -765,16 +1743,34 @@ binary_search_tree<tkey, tvalue>::node::node(
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::iterator_data::iterator_data(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data::iterator_data(
     unsigned int depth,
     tkey const &key,
     tvalue const &value):
+    _entry(std::make_shared<std::pair<tkey, tvalue> const>(key, value)),
     depth(depth),
-    key(key),
-    value(value)
+    key(_entry->first),
+    value(_entry->second)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data::iterator_data(
+    unsigned int depth,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const &viewed) noexcept:
+    depth(depth),
+    key(viewed.key),
+    value(viewed.value)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::iterator_data::iterator_data(unsigned int, tkey const &, tvalue const &)", "your code should be here...");
+
 }
 
 // endregion iterator data implementation
@@ -783,1294 +1779,4400 @@ binary_search_tree<tkey, tvalue>::iterator_data::iterator_data(
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::prefix_iterator::prefix_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::prefix_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(prefix_first(subtree_root)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::prefix_iterator::prefix_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::prefix_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::prefix_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::prefix_iterator::operator==(typename binary_search_tree<tkey, tvalue>::prefix_iterator const &) const noexcept", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::prefix_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::prefix_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::prefix_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::prefix_iterator const &) const noexcept", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_iterator &binary_search_tree<tkey, tvalue>::prefix_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::prefix_iterator &binary_search_tree<tkey, tvalue>::prefix_iterator::operator++()", "your code should be here...");
+    _current_node = prefix_next(_current_node, false, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_iterator const binary_search_tree<tkey, tvalue>::prefix_iterator::operator++(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::operator++(
     int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::prefix_iterator const binary_search_tree<tkey, tvalue>::prefix_iterator::operator++(int)", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::prefix_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::prefix_iterator::operator*() const", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
-// endregion prefix_iterator implementation
-
-// region prefix_const_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::prefix_const_iterator::prefix_const_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::prefix_const_iterator::prefix_const_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::prefix_const_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator==(typename binary_search_tree<tkey, tvalue>::prefix_const_iterator const &) const noexcept", "your code should be here...");
+    return _depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::prefix_const_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::prefix_const_iterator const &) const noexcept", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_const_iterator &binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::prefix_const_iterator &binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator++()", "your code should be here...");
+    return _current_node->value;
 }
 
+// endregion prefix_iterator implementation
+
+// region prefix_const_iterator implementation
+
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_const_iterator const binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::prefix_const_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(prefix_first(subtree_root)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::prefix_const_iterator const binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator++(int)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::prefix_const_iterator::operator*() const", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
-// endregion prefix_const_iterator implementation
-
-// region prefix_reverse_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::prefix_reverse_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::prefix_reverse_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator==(typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator const &) const noexcept", "your code should be here...");
+    _current_node = prefix_next(_current_node, false, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::operator++(
+    int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator const &) const noexcept", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator &binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator &binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator++()", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator const binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator const binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator++(int)", "your code should be here...");
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::prefix_reverse_iterator::operator*() const", "your code should be here...");
+    return _depth;
 }
 
-// endregion prefix_reverse_iterator implementation
-
-// region prefix_const_reverse_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator==(typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator const &) const noexcept", "your code should be here...");
+    return _current_node->value;
 }
 
+// endregion prefix_const_iterator implementation
+
+// region prefix_reverse_iterator implementation
+
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::prefix_reverse_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(prefix_first(subtree_root)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator const &) const noexcept", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator &binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator &binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator++()", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator const binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator const binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator++(int)", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator::operator*() const", "your code should be here...");
+    _current_node = prefix_next(_current_node, true, &_depth);
+    
+    return *this;
 }
 
-// endregion prefix_const_reverse_iterator implementation
-
-// region infix_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::infix_iterator::infix_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::operator++(
+    int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::infix_iterator::infix_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::infix_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::infix_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::infix_iterator::operator==(typename binary_search_tree<tkey, tvalue>::infix_iterator const &) const noexcept", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::infix_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::infix_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::infix_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::infix_iterator const &) const noexcept", "your code should be here...");
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_iterator &binary_search_tree<tkey, tvalue>::infix_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::infix_iterator &binary_search_tree<tkey, tvalue>::infix_iterator::operator++()", "your code should be here...");
+    return _depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_iterator const binary_search_tree<tkey, tvalue>::infix_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::infix_iterator const binary_search_tree<tkey, tvalue>::infix_iterator::operator++(int)", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::infix_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::infix_iterator::operator*() const", "your code should be here...");
+    return _current_node->value;
 }
 
-// endregion infix_iterator implementation
+// endregion prefix_reverse_iterator implementation
 
-// region infix_const_iterator implementation
+// region prefix_const_reverse_iterator implementation
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::infix_const_iterator::infix_const_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(prefix_first(subtree_root)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::infix_const_iterator::infix_const_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::infix_const_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::infix_const_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::infix_const_iterator::operator==(typename binary_search_tree<tkey, tvalue>::infix_const_iterator const &) const noexcept", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::infix_const_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::infix_const_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::infix_const_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::infix_const_iterator const &) const noexcept", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_const_iterator &binary_search_tree<tkey, tvalue>::infix_const_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::infix_const_iterator &binary_search_tree<tkey, tvalue>::infix_const_iterator::operator++()", "your code should be here...");
+    _current_node = prefix_next(_current_node, true, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_const_iterator const binary_search_tree<tkey, tvalue>::infix_const_iterator::operator++(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::operator++(
     int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::infix_const_iterator const binary_search_tree<tkey, tvalue>::infix_const_iterator::operator++(int)", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::infix_const_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::infix_const_iterator::operator*() const", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
-// endregion infix_const_iterator implementation
-
-// region infix_reverse_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::infix_reverse_iterator::infix_reverse_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::infix_reverse_iterator::infix_reverse_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator==(typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator const &) const noexcept", "your code should be here...");
+    return _depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator const &) const noexcept", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator &binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator &binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator++()", "your code should be here...");
+    return _current_node->value;
 }
 
+// endregion prefix_const_reverse_iterator implementation
+
+// region infix_iterator implementation
+
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator const binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::infix_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(infix_first(subtree_root, false, &_depth)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator const binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator++(int)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::infix_reverse_iterator::operator*() const", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
-// endregion infix_reverse_iterator implementation
-
-// region infix_const_reverse_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::infix_const_reverse_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::infix_const_reverse_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator==(typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator const &) const noexcept", "your code should be here...");
+    _current_node = infix_next(_current_node, false, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::operator++(
+    int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator const &) const noexcept", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator &binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator &binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator++()", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator const binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator const binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator++(int)", "your code should be here...");
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator::operator*() const", "your code should be here...");
+    return _depth;
 }
 
-// endregion infix_const_reverse_iterator implementation
-
-// region postfix_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::postfix_iterator::postfix_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::postfix_iterator::postfix_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::postfix_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::postfix_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::postfix_iterator::operator==(typename binary_search_tree<tkey, tvalue>::postfix_iterator const &) const noexcept", "your code should be here...");
+    return _current_node->value;
 }
 
+// endregion infix_iterator implementation
+
+// region infix_const_iterator implementation
+
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::postfix_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::postfix_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::infix_const_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(infix_first(subtree_root, false, &_depth)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::postfix_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::postfix_iterator const &) const noexcept", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_iterator &binary_search_tree<tkey, tvalue>::postfix_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::postfix_iterator &binary_search_tree<tkey, tvalue>::postfix_iterator::operator++()", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_iterator const binary_search_tree<tkey, tvalue>::postfix_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::postfix_iterator const binary_search_tree<tkey, tvalue>::postfix_iterator::operator++(int)", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::postfix_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::postfix_iterator::operator*() const", "your code should be here...");
+    _current_node = infix_next(_current_node, false, &_depth);
+    
+    return *this;
 }
 
-// endregion postfix_iterator implementation
-
-// region postfix_const_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::postfix_const_iterator::postfix_const_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::operator++(
+    int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::postfix_const_iterator::postfix_const_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::postfix_const_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator==(typename binary_search_tree<tkey, tvalue>::postfix_const_iterator const &) const noexcept", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::postfix_const_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::postfix_const_iterator const &) const noexcept", "your code should be here...");
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_const_iterator &binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::postfix_const_iterator &binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator++()", "your code should be here...");
+    return _depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_const_iterator const binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::postfix_const_iterator const binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator++(int)", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::postfix_const_iterator::operator*() const", "your code should be here...");
+    return _current_node->value;
 }
 
-// endregion postfix_const_iterator implementation
+// endregion infix_const_iterator implementation
 
-// region postfix_reverse_iterator implementation
+// region infix_reverse_iterator implementation
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::postfix_reverse_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::infix_reverse_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(infix_first(subtree_root, true, &_depth)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::postfix_reverse_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator==(typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator const &) const noexcept", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator const &) const noexcept", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator &binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator &binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator++()", "your code should be here...");
+    _current_node = infix_next(_current_node, true, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator const binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator++(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::operator++(
     int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator const binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator++(int)", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data *binary_search_tree<tkey, tvalue>::postfix_reverse_iterator::operator*() const", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
-// endregion postfix_reverse_iterator implementation
-
-// region postfix_const_reverse_iterator implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(
-    typename binary_search_tree<tkey, tvalue>::node *subtree_root)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(typename binary_search_tree<tkey, tvalue>::node *)", "your code should be here...");
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator==(
-    typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator==(typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator const &) const noexcept", "your code should be here...");
+    return _depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-bool binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator!=(
-    typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator const &other) const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> bool binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator!=(typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator const &) const noexcept", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator &binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator++()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator &binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator++()", "your code should be here...");
+    return _current_node->value;
 }
 
+// endregion infix_reverse_iterator implementation
+
+// region infix_const_reverse_iterator implementation
+
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator const binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator++(
-    int not_used)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::infix_const_reverse_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(infix_first(subtree_root, true, &_depth)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator const binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator++(int)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator*() const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> typename binary_search_tree<tkey, tvalue>::iterator_data const *binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator::operator*() const", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
-// endregion postfix_const_reverse_iterator implementation
-
-// endregion iterators implementation
-
-// region target operations associated exception types implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_exception::insertion_of_existent_key_attempt_exception(
-    tkey const &key):
-    std::logic_error("Attempt to insert already existing key inside the tree.")
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator const &other) const noexcept
 {
-
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-tkey const &binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_exception::get_key() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::operator++()
 {
-    return _key;
+    _current_node = infix_next(_current_node, true, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::obtaining_of_nonexistent_key_attempt_exception::obtaining_of_nonexistent_key_attempt_exception(
-    tkey const &key):
-    std::logic_error("Attempt to obtain a value by non-existing key from the tree.")
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::operator++(
+    int not_used)
 {
-
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-tkey const &binary_search_tree<tkey, tvalue>::obtaining_of_nonexistent_key_attempt_exception::get_key() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::operator*() const noexcept
 {
-    return _key;
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_exception::disposal_of_nonexistent_key_attempt_exception(
-    tkey const &key):
-    std::logic_error("Attempt to dispose a value by non-existing key from the tree.")
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::operator->() const noexcept
 {
-
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-tkey const &binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_exception::get_key() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::depth() const noexcept
 {
-    return _key;
+    return _depth;
 }
 
-// endregion target operations associated exception types implementation
-
-// region template methods implementation
-
-// region binary_search_tree<tkey, tvalue>::template_method_basics implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::template_method_basics::template_method_basics(
-    binary_search_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue>binary_search_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(binary_search_tree<tkey, tvalue> *)", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-[[nodiscard]] inline logger *binary_search_tree<tkey, tvalue>::template_method_basics::get_logger() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> [[nodiscard]] inline logger *binary_search_tree<tkey, tvalue>::template_method_basics::get_logger() const noexcept", "your code should be here...");
+    return _current_node->value;
 }
 
-// endregion binary_search_tree<tkey, tvalue>::template_method_basics implementation
+// endregion infix_const_reverse_iterator implementation
 
-// region search_tree<tkey, tvalue>::insertion_template_method implementation
+// region postfix_iterator implementation
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(
-    binary_search_tree<tkey, tvalue> *tree,
-    typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy):
-    binary_search_tree<tkey, tvalue>::template_method_basics::template_method_basics(tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::postfix_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(postfix_first(subtree_root, false, &_depth)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue>binary_search_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(binary_search_tree<tkey, tvalue> *, typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_strategy)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::insertion_template_method::insert(
-    tkey const &key,
-    tvalue const &value)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::insertion_template_method::insert(tkey const &,tvalue const &)", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::insertion_template_method::insert(
-    tkey const &key,
-    tvalue &&value)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::insertion_template_method::insert(tkey const &, tvalue &&)", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::insertion_template_method::set_insertion_strategy(
-    typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::insertion_template_method::set_insertion_strategy(typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_strategy)", "your code should be here...");
+    _current_node = postfix_next(_current_node, false, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-allocator *binary_search_tree<tkey, tvalue>::insertion_template_method::get_allocator() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::operator++(
+    int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> allocator *binary_search_tree<tkey, tvalue>::insertion_template_method::get_allocator() const noexcept", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
-// endregion search_tree<tkey, tvalue>::insertion_template_method implementation
-
-// region search_tree<tkey, tvalue>::obtaining_template_method implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(
-    binary_search_tree<tkey, tvalue> *tree):
-    binary_search_tree<tkey, tvalue>::template_method_basics::template_method_basics(tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(binary_search_tree<tkey, tvalue> *tree)", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-tvalue const &binary_search_tree<tkey, tvalue>::obtaining_template_method::obtain(
-    tkey const &key)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> tvalue const &binary_search_tree<tkey, tvalue>::obtaining_template_method::obtain(tkey const &)", "your code should be here...");
+    return **this;
 }
 
-// endregion search_tree<tkey, tvalue>::obtaining_template_method implementation
-
-// region search_tree<tkey, tvalue>::disposal_template_method implementation
-
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(
-    binary_search_tree<tkey, tvalue> *tree,
-    typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy):
-    binary_search_tree<tkey, tvalue>::template_method_basics(tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(binary_search_tree<tkey, tvalue> *, typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_strategy)", "your code should be here...");
+    return _depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-tvalue binary_search_tree<tkey, tvalue>::disposal_template_method::dispose(
-    tkey const &key)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::key() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> tvalue binary_search_tree<tkey, tvalue>::disposal_template_method::dispose(tkey const &)", "your code should be here...");
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::disposal_template_method::set_disposal_strategy(
-    typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator::value() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::disposal_template_method::set_disposal_strategy(typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_strategy)", "your code should be here...");
+    return _current_node->value;
 }
 
+// endregion postfix_iterator implementation
+
+// region postfix_const_iterator implementation
+
 template<
     typename tkey,
-    typename tvalue>
-[[nodiscard]] inline allocator *binary_search_tree<tkey, tvalue>::disposal_template_method::get_allocator() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::postfix_const_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(postfix_first(subtree_root, false, &_depth)),
+    _tree(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> [[nodiscard]] inline allocator *binary_search_tree<tkey, tvalue>::disposal_template_method::get_allocator() const noexcept", "your code should be here...");
-}
 
-// endregion search_tree<tkey, tvalue>::disposal_template_method implementation
-
-// endregion template methods
-
-// region construction, assignment, destruction implementation
+}
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::binary_search_tree(
-    typename binary_search_tree<tkey, tvalue>::insertion_template_method *insertion_template,
-    typename binary_search_tree<tkey, tvalue>::obtaining_template_method *obtaining_template,
-    typename binary_search_tree<tkey, tvalue>::disposal_template_method *disposal_template,
-    std::function<int(tkey const &, tkey const &)> comparer,
-    allocator *allocator,
-    logger *logger):
-    search_tree<tkey, tvalue>(comparer, logger, allocator),
-    _insertion_template(insertion_template),
-    _obtaining_template(obtaining_template),
-    _disposal_template(disposal_template)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::binary_search_tree(typename binary_search_tree<tkey, tvalue>::insertion_template_method *, typename binary_search_tree<tkey, tvalue>::obtaining_template_method *, typename binary_search_tree<tkey, tvalue>::disposal_template_method *, std::function<int(tkey const &, tkey const &)>, allocator *, logger *)", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::binary_search_tree(
-    std::function<int(tkey const &, tkey const &)> keys_comparer,
-    allocator *allocator,
-    logger *logger,
-    typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy,
-    typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy):
-    binary_search_tree(
-        new binary_search_tree<tkey, tvalue>::insertion_template_method(this, insertion_strategy),
-        new binary_search_tree<tkey, tvalue>::obtaining_template_method(this),
-        new binary_search_tree<tkey, tvalue>::disposal_template_method(this, disposal_strategy),
-        keys_comparer,
-        allocator,
-        logger)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::binary_search_tree(std::function<int(tkey const &, tkey const &)>, allocator *, logger *, typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy, typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy)", "your code should be here...");
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::binary_search_tree(
-    binary_search_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::binary_search_tree(binary_search_tree<tkey, tvalue> const &)", "your code should be here...");
+    _current_node = postfix_next(_current_node, false, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::binary_search_tree(
-    binary_search_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::operator++(
+    int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::binary_search_tree(binary_search_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue> &binary_search_tree<tkey, tvalue>::operator=(
-    binary_search_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::operator*() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue> &binary_search_tree<tkey, tvalue>::operator=(binary_search_tree<tkey, tvalue> const &)", "your code should be here...");
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue> &binary_search_tree<tkey, tvalue>::operator=(
-    binary_search_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::operator->() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue> &binary_search_tree<tkey, tvalue>::operator=(binary_search_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-binary_search_tree<tkey, tvalue>::~binary_search_tree()
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::depth() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> binary_search_tree<tkey, tvalue>::~binary_search_tree()", "your code should be here...");
+    return _depth;
 }
 
-// endregion construction, assignment, destruction implementation
-
-// region associative_container<tkey, tvalue> contract implementation
-
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::insert(
-    tkey const &key,
-    tvalue const &value)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::key() const noexcept
 {
-    _insertion_template->insert(key, value);
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::insert(
-    tkey const &key,
-    tvalue &&value)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator::value() const noexcept
 {
-    _insertion_template->insert(key, std::move(value));
+    return _current_node->value;
 }
 
+// endregion postfix_const_iterator implementation
+
+// region postfix_reverse_iterator implementation
+
 template<
     typename tkey,
-    typename tvalue>
-tvalue const &binary_search_tree<tkey, tvalue>::obtain(
-    tkey const &key)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::postfix_reverse_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(postfix_first(subtree_root, true, &_depth)),
+    _tree(tree)
 {
-    return _obtaining_template->obtain(key);
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-std::vector<typename associative_container<tkey, tvalue>::key_value_pair> binary_search_tree<tkey, tvalue>::obtain_between(
-    tkey const &lower_bound,
-    tkey const &upper_bound,
-    bool lower_bound_inclusive,
-    bool upper_bound_inclusive)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> std::vector<typename associative_container<tkey, tvalue>::key_value_pair> binary_search_tree<tkey, tvalue>::obtain_between(tkey const &, tkey const &, bool, bool)", "your code should be here...");
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-tvalue binary_search_tree<tkey, tvalue>::dispose(
-    tkey const &key)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator const &other) const noexcept
 {
-    return _disposal_template->dispose(key);
+    return !(*this == other);
 }
 
-// endregion associative_containers contract implementations
-
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::set_insertion_strategy(
-    typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::operator++()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::set_insertion_strategy(typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_strategy) noexcept", "your code should be here...");
+    _current_node = postfix_next(_current_node, true, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::set_removal_strategy(
-    typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::operator++(
+    int not_used)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::set_removal_strategy(typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_strategy) noexcept", "your code should be here...");
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
-// region iterators requesting implementation
-
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_iterator binary_search_tree<tkey, tvalue>::begin_prefix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::operator*() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::prefix_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_iterator binary_search_tree<tkey, tvalue>::end_prefix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::operator->() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::prefix_iterator(nullptr);
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_const_iterator binary_search_tree<tkey, tvalue>::cbegin_prefix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::depth() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::prefix_const_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_const_iterator binary_search_tree<tkey, tvalue>::cend_prefix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::key() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::prefix_const_iterator(nullptr);
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator binary_search_tree<tkey, tvalue>::rbegin_prefix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator::value() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::prefix_reverse_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _current_node->value;
 }
 
+// endregion postfix_reverse_iterator implementation
+
+// region postfix_const_reverse_iterator implementation
+
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_reverse_iterator binary_search_tree<tkey, tvalue>::rend_prefix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root):
+    _depth(depth_of(subtree_root)),
+    _current_node(postfix_first(subtree_root, true, &_depth)),
+    _tree(tree)
 {
-    return binary_search_tree<tkey, tvalue>::prefix_reverse_iterator(nullptr);
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator binary_search_tree<tkey, tvalue>::crbegin_prefix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::operator==(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator const &other) const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _current_node == other._current_node;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator binary_search_tree<tkey, tvalue>::crend_prefix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::operator!=(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator const &other) const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::prefix_const_reverse_iterator(nullptr);
+    return !(*this == other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_iterator binary_search_tree<tkey, tvalue>::begin_infix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::operator++()
 {
-    return binary_search_tree<tkey, tvalue>::infix_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    _current_node = postfix_next(_current_node, true, &_depth);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_iterator binary_search_tree<tkey, tvalue>::end_infix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator const binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::operator++(
+    int not_used)
 {
-    return binary_search_tree<tkey, tvalue>::infix_iterator(nullptr);
+    auto previous_state = *this;
+    
+    ++*this;
+    
+    return previous_state;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_const_iterator binary_search_tree<tkey, tvalue>::cbegin_infix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::operator*() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::infix_const_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _tree->construct_iterator_data(_data, _current_node, depth());
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_const_iterator binary_search_tree<tkey, tvalue>::cend_infix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data const *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::operator->() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::infix_const_iterator(nullptr);
+    return **this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator binary_search_tree<tkey, tvalue>::rbegin_infix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::depth() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::infix_reverse_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_reverse_iterator binary_search_tree<tkey, tvalue>::rend_infix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::key() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::infix_reverse_iterator(nullptr);
+    return _current_node->key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator binary_search_tree<tkey, tvalue>::crbegin_infix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator::value() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _current_node->value;
 }
 
+// endregion postfix_const_reverse_iterator implementation
+
+// endregion iterators implementation
+
+// region target operations associated exception types implementation
+
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator binary_search_tree<tkey, tvalue>::crend_infix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_exception::insertion_of_existent_key_attempt_exception(
+    tkey const &key):
+    std::logic_error("Attempt to insert already existing key inside the tree."),
+    _key(key)
 {
-    return binary_search_tree<tkey, tvalue>::infix_const_reverse_iterator(nullptr);
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_iterator binary_search_tree<tkey, tvalue>::begin_postfix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_exception::get_key() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::postfix_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_iterator binary_search_tree<tkey, tvalue>::end_postfix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_of_nonexistent_key_attempt_exception::obtaining_of_nonexistent_key_attempt_exception(
+    tkey const &key):
+    std::logic_error("Attempt to obtain a value by non-existing key from the tree."),
+    _key(key)
 {
-    return binary_search_tree<tkey, tvalue>::postfix_iterator(nullptr);
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_const_iterator binary_search_tree<tkey, tvalue>::cbegin_postfix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_of_nonexistent_key_attempt_exception::get_key() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::postfix_const_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_const_iterator binary_search_tree<tkey, tvalue>::cend_postfix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_exception::disposal_of_nonexistent_key_attempt_exception(
+    tkey const &key):
+    std::logic_error("Attempt to dispose a value by non-existing key from the tree."),
+    _key(key)
 {
-    return binary_search_tree<tkey, tvalue>::postfix_const_iterator(nullptr);
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator binary_search_tree<tkey, tvalue>::rbegin_postfix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tkey const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_exception::get_key() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::postfix_reverse_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _key;
 }
 
+// endregion target operations associated exception types implementation
+
+// region template methods implementation
+
+// region binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::template_method_basics implementation
+
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_reverse_iterator binary_search_tree<tkey, tvalue>::rend_postfix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::template_method_basics::template_method_basics(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    _tree(tree)
 {
-    return binary_search_tree<tkey, tvalue>::postfix_reverse_iterator(nullptr);
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator binary_search_tree<tkey, tvalue>::crbegin_postfix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+[[nodiscard]] inline logger *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::template_method_basics::get_logger() const noexcept
 {
-    return binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator(dynamic_cast<typename binary_search_tree<tkey, tvalue>::node *>(_root));
+    return _tree->get_logger();
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator binary_search_tree<tkey, tvalue>::crend_postfix() const noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::template_method_basics::rebind(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree) noexcept
 {
-    return binary_search_tree<tkey, tvalue>::postfix_const_reverse_iterator(nullptr);
+    _tree = tree;
 }
 
+// endregion binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::template_method_basics implementation
 
-// endregion iterators request implementation
+// region search_tree<tkey, tvalue, tkey_comparer>::insertion_template_method implementation
 
-// region subtree rotations implementation
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::insertion_template_method(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::template_method_basics::template_method_basics(tree),
+    _insertion_strategy(insertion_strategy)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::insert(
+    tkey const &key,
+    tvalue const &value)
+{
+    insert_entry(key, value);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::insert(
+    tkey const &key,
+    tvalue &&value)
+{
+    insert_entry(key, std::move(value));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tvalue_reference>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::insert_entry(
+    tkey const &key,
+    tvalue_reference &&value)
+{
+    node *parent = nullptr;
+    node **link = &this->_tree->_root;
+    
+    while (*link != nullptr)
+    {
+        int comparison = this->_tree->_keys_comparer(key, (*link)->key);
+        
+        if (comparison == 0)
+        {
+            if (_insertion_strategy == insertion_of_existent_key_attempt_strategy::throw_an_exception)
+            {
+                throw insertion_of_existent_key_attempt_exception(key);
+            }
+            
+            (*link)->value = std::forward<tvalue_reference>(value);
+            update_augmentations_upwards(*link);
+            
+            return;
+        }
+        
+        parent = *link;
+        link = comparison < 0
+            ? &parent->left_subtree
+            : &parent->right_subtree;
+    }
+    
+    *link = this->_tree->create_node(key, value);
+    (*link)->parent = parent;
+    
+    balance(*link);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::set_insertion_strategy(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy) noexcept
+{
+    _insertion_strategy = insertion_strategy;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::get_insertion_strategy() const noexcept
+{
+    return _insertion_strategy;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+allocator *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::get_allocator() const noexcept
+{
+    return this->_tree->get_allocator();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept
+{
+    update_augmentations_upwards(inserted->parent);
+}
+
+// endregion search_tree<tkey, tvalue, tkey_comparer>::insertion_template_method implementation
+
+// region search_tree<tkey, tvalue, tkey_comparer>::obtaining_template_method implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method::obtaining_template_method(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::template_method_basics::template_method_basics(tree)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method::obtain(
+    tkey const &key)
+{
+    node *current = this->_tree->_root;
+    
+    while (current != nullptr)
+    {
+        int comparison = this->_tree->_keys_comparer(key, current->key);
+        
+        if (comparison == 0)
+        {
+            return current->value;
+        }
+        
+        current = comparison < 0
+            ? current->left_subtree
+            : current->right_subtree;
+    }
+    
+    throw obtaining_of_nonexistent_key_attempt_exception(key);
+}
+
+// endregion search_tree<tkey, tvalue, tkey_comparer>::obtaining_template_method implementation
+
+// region search_tree<tkey, tvalue, tkey_comparer>::disposal_template_method implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::disposal_template_method(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::template_method_basics(tree),
+    _disposal_strategy(disposal_strategy)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::dispose(
+    tkey const &key)
+{
+    node *target = this->_tree->_root;
+    
+    while (target != nullptr)
+    {
+        int comparison = this->_tree->_keys_comparer(key, target->key);
+        
+        if (comparison == 0)
+        {
+            break;
+        }
+        
+        target = comparison < 0
+            ? target->left_subtree
+            : target->right_subtree;
+    }
+    
+    if (target == nullptr)
+    {
+        if (_disposal_strategy == disposal_of_nonexistent_key_attempt_strategy::throw_an_exception)
+        {
+            throw disposal_of_nonexistent_key_attempt_exception(key);
+        }
+        
+        return tvalue();
+    }
+    
+    node *unlinked = select_node_to_unlink(target);
+    tvalue disposed_value = std::move(target->value);
+    
+    if (unlinked != target)
+    {
+        target->key = std::move(unlinked->key);
+        target->value = std::move(unlinked->value);
+        target = unlinked;
+    }
+    
+    node *parent = target->parent;
+    node *subtree = target->left_subtree == nullptr
+        ? target->right_subtree
+        : target->left_subtree;
+    bool from_left_subtree = parent != nullptr && parent->left_subtree == target;
+    
+    this->_tree->get_link_to(target) = subtree;
+    if (subtree != nullptr)
+    {
+        subtree->parent = parent;
+    }
+    
+    balance(parent, from_left_subtree, target);
+    
+    target->left_subtree = target->right_subtree = nullptr;
+    this->_tree->destroy_subtree(target);
+    
+    return disposed_value;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::set_disposal_strategy(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy) noexcept
+{
+    _disposal_strategy = disposal_strategy;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::get_disposal_strategy() const noexcept
+{
+    return _disposal_strategy;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+[[nodiscard]] inline allocator *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::get_allocator() const noexcept
+{
+    return this->_tree->get_allocator();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::select_node_to_unlink(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept
+{
+    if (target->left_subtree == nullptr || target->right_subtree == nullptr)
+    {
+        return target;
+    }
+    
+    node *predecessor = target->left_subtree;
+    while (predecessor->right_subtree != nullptr)
+    {
+        predecessor = predecessor->right_subtree;
+    }
+    
+    return predecessor;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+    bool,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *) noexcept
+{
+    update_augmentations_upwards(parent);
+}
+
+// endregion search_tree<tkey, tvalue, tkey_comparer>::disposal_template_method implementation
+
+// endregion template methods
+
+// region construction, assignment, destruction implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::binary_search_tree(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method *insertion_template,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method *obtaining_template,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method *disposal_template,
+    tkey_comparer comparer,
+    allocator *allocator,
+    logger *logger):
+    search_tree<tkey, tvalue, tkey_comparer>(comparer, logger, allocator),
+    _root(nullptr),
+    _insertion_template(insertion_template),
+    _obtaining_template(obtaining_template),
+    _disposal_template(disposal_template),
+    _nodes_pool(nullptr)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::binary_search_tree(
+    tkey_comparer keys_comparer,
+    allocator *allocator,
+    logger *logger,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy):
+    binary_search_tree(
+        new binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(this, insertion_strategy),
+        new binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(this),
+        new binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(this, disposal_strategy),
+        keys_comparer,
+        allocator,
+        logger)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tforward_iterator,
+    typename>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::binary_search_tree(
+    tforward_iterator first,
+    tforward_iterator last,
+    tkey_comparer comparer,
+    allocator *allocator,
+    logger *logger,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy):
+    binary_search_tree(comparer, allocator, logger, insertion_strategy, disposal_strategy)
+{
+    assign_sorted(first, last);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::binary_search_tree(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other):
+    binary_search_tree(
+        other._keys_comparer,
+        other.get_allocator(),
+        other.get_logger(),
+        other._insertion_template->get_insertion_strategy(),
+        other._disposal_template->get_disposal_strategy())
+{
+    _root = relocate_subtree(other._root);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::binary_search_tree(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept:
+    search_tree<tkey, tvalue, tkey_comparer>(std::move(other._keys_comparer), other.get_logger(), other.get_allocator()),
+    _root(other._root),
+    _insertion_template(other._insertion_template),
+    _obtaining_template(other._obtaining_template),
+    _disposal_template(other._disposal_template),
+    _nodes_pool(std::move(other._nodes_pool))
+{
+    other._root = nullptr;
+    other._insertion_template = nullptr;
+    other._obtaining_template = nullptr;
+    other._disposal_template = nullptr;
+    
+    rebind_template_methods();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other)
+{
+    if (this != &other)
+    {
+        tkey_comparer keys_comparer = other._keys_comparer;
+        node *copied = relocate_subtree(other._root);
+        
+        destroy_subtree(_root);
+        _root = copied;
+        this->_keys_comparer = std::move(keys_comparer);
+        _insertion_template->set_insertion_strategy(other._insertion_template->get_insertion_strategy());
+        _disposal_template->set_disposal_strategy(other._disposal_template->get_disposal_strategy());
+    }
+    
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept
+{
+    if (this != &other)
+    {
+        std::swap(this->_keys_comparer, other._keys_comparer);
+        std::swap(_root, other._root);
+        std::swap(_insertion_template, other._insertion_template);
+        std::swap(_obtaining_template, other._obtaining_template);
+        std::swap(_disposal_template, other._disposal_template);
+        std::swap(_nodes_pool, other._nodes_pool);
+        
+        rebind_template_methods();
+        other.rebind_template_methods();
+    }
+    
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::~binary_search_tree()
+{
+    destroy_subtree(_root);
+    
+    delete _insertion_template;
+    delete _obtaining_template;
+    delete _disposal_template;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::rebind_template_methods() noexcept
+{
+    for (template_method_basics *template_method: std::initializer_list<template_method_basics *>{ _insertion_template, _obtaining_template, _disposal_template })
+    {
+        if (template_method != nullptr)
+        {
+            template_method->rebind(this);
+        }
+    }
+}
+
+// endregion construction, assignment, destruction implementation
+
+// region associative_container<tkey, tvalue> contract implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insert(
+    tkey const &key,
+    tvalue const &value)
+{
+    _insertion_template->insert(key, value);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insert(
+    tkey const &key,
+    tvalue &&value)
+{
+    _insertion_template->insert(key, std::move(value));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtain(
+    tkey const &key)
+{
+    return _obtaining_template->obtain(key);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+std::vector<typename associative_container<tkey, tvalue>::key_value_pair> binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtain_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive)
+{
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> range;
+    
+    for_each_between(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive,
+        [&range](tkey const &key, tvalue const &value)
+        {
+            range.push_back({ key, value });
+            
+            return true;
+        });
+    
+    return range;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::dispose(
+    tkey const &key)
+{
+    return _disposal_template->dispose(key);
+}
+
+// endregion associative_containers contract implementations
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_insertion_strategy(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy) noexcept
+{
+    _insertion_template->set_insertion_strategy(insertion_strategy);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_removal_strategy(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy) noexcept
+{
+    _disposal_template->set_disposal_strategy(disposal_strategy);
+}
+
+// region iterators requesting implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::begin_prefix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::end_prefix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::cbegin_prefix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::cend_prefix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::rbegin_prefix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::rend_prefix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_reverse_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::crbegin_prefix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::crend_prefix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_const_reverse_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::begin_infix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::end_infix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::cbegin_infix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::cend_infix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::rbegin_infix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::rend_infix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_reverse_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::crbegin_infix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::crend_infix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_reverse_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::begin_postfix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::end_postfix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::cbegin_postfix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::cend_postfix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::rbegin_postfix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::rend_postfix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_reverse_iterator(this, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::crbegin_postfix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator(this, dynamic_cast<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::crend_postfix() const noexcept
+{
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_const_reverse_iterator(this, nullptr);
+}
+
+
+// endregion iterators request implementation
+
+// region range queries implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::lower_bound(
+    tkey const &key) const
+{
+    infix_iterator bound(this, nullptr);
+    bound._current_node = find_bound(key, true);
+    bound._depth = depth_of(bound._current_node);
+    
+    return bound;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::upper_bound(
+    tkey const &key) const
+{
+    infix_iterator bound(this, nullptr);
+    bound._current_node = find_bound(key, false);
+    bound._depth = depth_of(bound._current_node);
+    
+    return bound;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::clower_bound(
+    tkey const &key) const
+{
+    infix_const_iterator bound(this, nullptr);
+    bound._current_node = find_bound(key, true);
+    bound._depth = depth_of(bound._current_node);
+    
+    return bound;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::cupper_bound(
+    tkey const &key) const
+{
+    infix_const_iterator bound(this, nullptr);
+    bound._current_node = find_bound(key, false);
+    bound._depth = depth_of(bound._current_node);
+    
+    return bound;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tvisitor>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::for_each_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive,
+    tvisitor &&visitor) const
+{
+    for (node *current = find_bound(lower_bound, lower_bound_inclusive); current != nullptr; current = infix_next(current, false))
+    {
+        int comparison = this->_keys_comparer(current->key, upper_bound);
+        if (comparison > 0 || (comparison == 0 && !upper_bound_inclusive))
+        {
+            return;
+        }
+        
+        if (!visitor(static_cast<tkey const &>(current->key), static_cast<tvalue const &>(current->value)))
+        {
+            return;
+        }
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::find_bound(
+    tkey const &key,
+    bool inclusive) const
+{
+    node *current = _root;
+    node *bound = nullptr;
+    
+    while (current != nullptr)
+    {
+        int comparison = this->_keys_comparer(current->key, key);
+        
+        if (comparison > 0 || (comparison == 0 && inclusive))
+        {
+            bound = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    
+    return bound;
+}
+
+// endregion range queries implementation
+
+// region order statistics implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::rank(
+    tkey const &key) const
+{
+    return count_less(key, false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_const_iterator binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::select(
+    size_t index) const
+{
+    node *current = _root;
+    
+    while (current != nullptr)
+    {
+        size_t left_size = get_subtree_size(current->left_subtree);
+        
+        if (index == left_size)
+        {
+            break;
+        }
+        
+        if (index < left_size)
+        {
+            current = current->left_subtree;
+        }
+        else
+        {
+            index -= left_size + 1;
+            current = current->right_subtree;
+        }
+    }
+    
+    infix_const_iterator selected(this, nullptr);
+    selected._current_node = current;
+    selected._depth = depth_of(current);
+    
+    return selected;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::count_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive) const
+{
+    size_t up_to_upper_bound = count_less(upper_bound, upper_bound_inclusive);
+    size_t below_lower_bound = count_less(lower_bound, !lower_bound_inclusive);
+    
+    return up_to_upper_bound > below_lower_bound
+        ? up_to_upper_bound - below_lower_bound
+        : 0;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_subtree_size(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept
+{
+    static_assert(std::is_base_of<subtree_size_augmentation, taugmentation>::value,
+        "order statistics require subtree_size_augmentation or an augmentation derived from it");
+    
+    return subtree_root == nullptr
+        ? 0
+        : static_cast<subtree_size_augmentation const *>(subtree_root)->subtree_size;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::count_less(
+    tkey const &key,
+    bool inclusive) const
+{
+    size_t count = 0;
+    
+    for (node const *current = _root; current != nullptr;)
+    {
+        int comparison = this->_keys_comparer(current->key, key);
+        
+        if (comparison < 0 || (comparison == 0 && inclusive))
+        {
+            count += get_subtree_size(current->left_subtree) + 1;
+            current = current->right_subtree;
+        }
+        else
+        {
+            current = current->left_subtree;
+        }
+    }
+    
+    return count;
+}
+
+// endregion order statistics implementation
+
+// region range aggregates implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tmonoid_augmentation>
+typename tmonoid_augmentation::aggregate_type binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::aggregate_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive) const
+{
+    static_assert(std::is_same<tmonoid_augmentation, taugmentation>::value,
+        "aggregate_between has to be called with the tree augmentation");
+    
+    typedef typename tmonoid_augmentation::aggregate_type aggregate_type;
+    
+    auto aggregate_of = [](node const *subtree_root) -> aggregate_type
+    {
+        return subtree_root == nullptr
+            ? tmonoid_augmentation::identity()
+            : static_cast<tmonoid_augmentation const *>(subtree_root)->subtree_aggregate;
+    };
+    
+    auto above_lower_bound = [&](node const *target)
+    {
+        int comparison = this->_keys_comparer(target->key, lower_bound);
+        
+        return comparison > 0 || (comparison == 0 && lower_bound_inclusive);
+    };
+    
+    auto below_upper_bound = [&](node const *target)
+    {
+        int comparison = this->_keys_comparer(target->key, upper_bound);
+        
+        return comparison < 0 || (comparison == 0 && upper_bound_inclusive);
+    };
+    
+    // the highest node inside the range, where the paths to both bounds part
+    node const *fork = _root;
+    while (fork != nullptr && !(above_lower_bound(fork) && below_upper_bound(fork)))
+    {
+        fork = above_lower_bound(fork)
+            ? fork->left_subtree
+            : fork->right_subtree;
+    }
+    
+    if (fork == nullptr)
+    {
+        return tmonoid_augmentation::identity();
+    }
+    
+    // left of the fork: every node above the lower bound brings itself and its right subtree,
+    // which lie to the left of everything gathered on the way down so far
+    aggregate_type left_part = tmonoid_augmentation::identity();
+    for (node const *current = fork->left_subtree; current != nullptr;)
+    {
+        if (above_lower_bound(current))
+        {
+            left_part = tmonoid_augmentation::combine(
+                tmonoid_augmentation::combine(tmonoid_augmentation::of(current->key, current->value), aggregate_of(current->right_subtree)),
+                left_part);
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    
+    // and symmetrically on the right
+    aggregate_type right_part = tmonoid_augmentation::identity();
+    for (node const *current = fork->right_subtree; current != nullptr;)
+    {
+        if (below_upper_bound(current))
+        {
+            right_part = tmonoid_augmentation::combine(
+                right_part,
+                tmonoid_augmentation::combine(aggregate_of(current->left_subtree), tmonoid_augmentation::of(current->key, current->value)));
+            current = current->right_subtree;
+        }
+        else
+        {
+            current = current->left_subtree;
+        }
+    }
+    
+    return tmonoid_augmentation::combine(
+        tmonoid_augmentation::combine(left_part, tmonoid_augmentation::of(fork->key, fork->value)),
+        right_part);
+}
+
+// endregion range aggregates implementation
+
+// region bulk loading implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tforward_iterator>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::assign_sorted(
+    tforward_iterator first,
+    tforward_iterator last)
+{
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    
+    node *previous = nullptr;
+    size_t height;
+    node *built = build_balanced(first, count, 0, get_complete_levels_count(count), previous, height);
+    
+    destroy_subtree(_root);
+    _root = built;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tinput_iterator>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::assign(
+    tinput_iterator first,
+    tinput_iterator last)
+{
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> sorted(first, last);
+    
+    std::sort(sorted.begin(), sorted.end(),
+        [this](typename associative_container<tkey, tvalue>::key_value_pair const &left, typename associative_container<tkey, tvalue>::key_value_pair const &right)
+        {
+            return this->_keys_comparer(left.key, right.key) < 0;
+        });
+    
+    assign_sorted(sorted.cbegin(), sorted.cend());
+}
+
+// endregion bulk loading implementation
+
+// region batched updates implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tinput_iterator>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insert_many(
+    tinput_iterator first,
+    tinput_iterator last)
+{
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> batch(first, last);
+    
+    std::stable_sort(batch.begin(), batch.end(),
+        [this](typename associative_container<tkey, tvalue>::key_value_pair const &left, typename associative_container<tkey, tvalue>::key_value_pair const &right)
+        {
+            return this->_keys_comparer(left.key, right.key) < 0;
+        });
+    
+    bool update_existent = _insertion_template->get_insertion_strategy() == insertion_of_existent_key_attempt_strategy::update_value;
+    
+    // only the last of equal keys is inserted
+    std::vector<tkey const *> keys;
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair const *> entries;
+    for (auto batch_iterator = batch.cbegin(); batch_iterator != batch.cend(); ++batch_iterator)
+    {
+        auto next = std::next(batch_iterator);
+        if (next != batch.cend() && this->_keys_comparer(batch_iterator->key, next->key) == 0)
+        {
+            if (!update_existent)
+            {
+                throw insertion_of_existent_key_attempt_exception(batch_iterator->key);
+            }
+            
+            continue;
+        }
+        
+        keys.push_back(&batch_iterator->key);
+        entries.push_back(&*batch_iterator);
+    }
+    
+    if (!update_existent)
+    {
+        std::vector<bool> present(keys.size(), false);
+        mark_present(_root, keys, 0, keys.size(), present);
+        
+        auto found = std::find(present.cbegin(), present.cend(), true);
+        if (found != present.cend())
+        {
+            throw insertion_of_existent_key_attempt_exception(*keys[found - present.cbegin()]);
+        }
+    }
+    
+    // allocate everything before touching the tree, so a failure leaves it as it was
+    std::vector<node *> created;
+    created.reserve(entries.size());
+    std::vector<node *> replaced;
+    
+    try
+    {
+        for (auto const *entry: entries)
+        {
+            created.push_back(create_node(entry->key, entry->value));
+        }
+        
+        replaced.reserve(entries.size());
+    }
+    catch (...)
+    {
+        for (auto *node_to_destroy: created)
+        {
+            destroy_subtree(node_to_destroy);
+        }
+        
+        throw;
+    }
+    
+    settle_root(insert_subtrees(detach_root(), created.data(), created.size(), replaced));
+    
+    for (auto *node_to_destroy: replaced)
+    {
+        destroy_subtree(node_to_destroy);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tinput_iterator>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::dispose_many(
+    tinput_iterator first,
+    tinput_iterator last)
+{
+    std::vector<tkey> batch(first, last);
+    
+    std::sort(batch.begin(), batch.end(),
+        [this](tkey const &left, tkey const &right)
+        {
+            return this->_keys_comparer(left, right) < 0;
+        });
+    batch.erase(std::unique(batch.begin(), batch.end(),
+        [this](tkey const &left, tkey const &right)
+        {
+            return this->_keys_comparer(left, right) == 0;
+        }), batch.end());
+    
+    if (_disposal_template->get_disposal_strategy() == disposal_of_nonexistent_key_attempt_strategy::throw_an_exception)
+    {
+        std::vector<tkey const *> keys;
+        keys.reserve(batch.size());
+        for (auto const &key: batch)
+        {
+            keys.push_back(&key);
+        }
+        
+        std::vector<bool> present(keys.size(), false);
+        mark_present(_root, keys, 0, keys.size(), present);
+        
+        auto missing = std::find(present.cbegin(), present.cend(), false);
+        if (missing != present.cend())
+        {
+            throw disposal_of_nonexistent_key_attempt_exception(*keys[missing - present.cbegin()]);
+        }
+    }
+    
+    std::vector<node *> disposed;
+    disposed.reserve(batch.size());
+    
+    settle_root(dispose_subtrees(detach_root(), batch.data(), batch.size(), disposed));
+    
+    for (auto *node_to_destroy: disposed)
+    {
+        destroy_subtree(node_to_destroy);
+    }
+    
+    return disposed.size();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::mark_present(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root,
+    std::vector<tkey const *> const &keys,
+    size_t first,
+    size_t last,
+    std::vector<bool> &present) const
+{
+    if (subtree_root == nullptr || first == last)
+    {
+        return;
+    }
+    
+    auto bound = std::lower_bound(keys.cbegin() + first, keys.cbegin() + last, subtree_root->key,
+        [this](tkey const *left, tkey const &right)
+        {
+            return this->_keys_comparer(*left, right) < 0;
+        });
+    size_t middle = bound - keys.cbegin();
+    size_t right_first = middle;
+    
+    if (middle != last && this->_keys_comparer(*keys[middle], subtree_root->key) == 0)
+    {
+        present[middle] = true;
+        ++right_first;
+    }
+    
+    mark_present(subtree_root->left_subtree, keys, first, middle, present);
+    mark_present(subtree_root->right_subtree, keys, right_first, last, present);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insert_subtrees(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *const *batch,
+    size_t count,
+    std::vector<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *> &replaced) const
+{
+    if (count == 0)
+    {
+        return subtree_root;
+    }
+    
+    if (subtree_root == nullptr)
+    {
+        size_t height;
+        
+        return link_balanced(batch, count, 0, get_complete_levels_count(count), height);
+    }
+    
+    size_t middle = count / 2;
+    node *pivot = batch[middle];
+    
+    node *left;
+    node *right;
+    node *matched = split_around(subtree_root, pivot->key, left, right);
+    if (matched != nullptr)
+    {
+        replaced.push_back(matched);
+    }
+    
+    left = insert_subtrees(left, batch, middle, replaced);
+    right = insert_subtrees(right, batch + middle + 1, count - middle - 1, replaced);
+    
+    return join_subtrees(left, pivot, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::dispose_subtrees(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    tkey const *keys,
+    size_t count,
+    std::vector<typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *> &disposed) const
+{
+    if (subtree_root == nullptr || count == 0)
+    {
+        return subtree_root;
+    }
+    
+    size_t middle = count / 2;
+    
+    node *left;
+    node *right;
+    node *matched = split_around(subtree_root, keys[middle], left, right);
+    if (matched != nullptr)
+    {
+        disposed.push_back(matched);
+    }
+    
+    left = dispose_subtrees(left, keys, middle, disposed);
+    right = dispose_subtrees(right, keys + middle + 1, count - middle - 1, disposed);
+    
+    return join_adjacent_subtrees(left, right);
+}
+
+// endregion batched updates implementation
+
+// region subtree rotations implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::small_left_rotation(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
+    bool validate) const
+{
+    if (validate && (subtree_root == nullptr || subtree_root->right_subtree == nullptr))
+    {
+        throw std::logic_error("small_left_rotation: subtree root has no right subtree to rotate with");
+    }
+    
+    node *pivot = subtree_root->right_subtree;
+    
+    subtree_root->right_subtree = pivot->left_subtree;
+    if (pivot->left_subtree != nullptr)
+    {
+        pivot->left_subtree->parent = subtree_root;
+    }
+    
+    pivot->parent = subtree_root->parent;
+    pivot->left_subtree = subtree_root;
+    subtree_root->parent = pivot;
+    
+    update_augmentation(subtree_root);
+    update_augmentation(pivot);
+    
+    subtree_root = pivot;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::small_right_rotation(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
+    bool validate) const
+{
+    if (validate && (subtree_root == nullptr || subtree_root->left_subtree == nullptr))
+    {
+        throw std::logic_error("small_right_rotation: subtree root has no left subtree to rotate with");
+    }
+    
+    node *pivot = subtree_root->left_subtree;
+    
+    subtree_root->left_subtree = pivot->right_subtree;
+    if (pivot->right_subtree != nullptr)
+    {
+        pivot->right_subtree->parent = subtree_root;
+    }
+    
+    pivot->parent = subtree_root->parent;
+    pivot->right_subtree = subtree_root;
+    subtree_root->parent = pivot;
+    
+    update_augmentation(subtree_root);
+    update_augmentation(pivot);
+    
+    subtree_root = pivot;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::update_augmentation(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept
+{
+    target->recompute(target->key, target->value, target->left_subtree, target->right_subtree);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::update_augmentations_upwards(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept
+{
+    for (; target != nullptr; target = target->parent)
+    {
+        update_augmentation(target);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_link_to(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept
+{
+    if (target->parent == nullptr)
+    {
+        return _root;
+    }
+    
+    return target->parent->left_subtree == target
+        ? target->parent->left_subtree
+        : target->parent->right_subtree;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::big_left_rotation(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
+    bool validate) const
+{
+    if (validate && (subtree_root == nullptr || subtree_root->right_subtree == nullptr || subtree_root->right_subtree->left_subtree == nullptr))
+    {
+        throw std::logic_error("big_left_rotation: subtree has no right-left grandchild to rotate with");
+    }
+    
+    small_right_rotation(subtree_root->right_subtree, false);
+    small_left_rotation(subtree_root, false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::big_right_rotation(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
+    bool validate) const
+{
+    if (validate && (subtree_root == nullptr || subtree_root->left_subtree == nullptr || subtree_root->left_subtree->right_subtree == nullptr))
+    {
+        throw std::logic_error("big_right_rotation: subtree has no left-right grandchild to rotate with");
+    }
+    
+    small_left_rotation(subtree_root->left_subtree, false);
+    small_right_rotation(subtree_root, false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::double_left_rotation(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
+    bool at_grandparent_first,
+    bool validate) const
+{
+    if (validate && (subtree_root == nullptr || subtree_root->right_subtree == nullptr || subtree_root->right_subtree->right_subtree == nullptr))
+    {
+        throw std::logic_error("double_left_rotation: subtree has no right-right grandchild to rotate with");
+    }
+    
+    if (at_grandparent_first)
+    {
+        small_left_rotation(subtree_root, false);
+        small_left_rotation(subtree_root, false);
+    }
+    else
+    {
+        small_left_rotation(subtree_root->right_subtree, false);
+        small_left_rotation(subtree_root, false);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::double_right_rotation(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&subtree_root,
+    bool at_grandparent_first,
+    bool validate) const
+{
+    if (validate && (subtree_root == nullptr || subtree_root->left_subtree == nullptr || subtree_root->left_subtree->left_subtree == nullptr))
+    {
+        throw std::logic_error("double_right_rotation: subtree has no left-left grandchild to rotate with");
+    }
+    
+    if (at_grandparent_first)
+    {
+        small_right_rotation(subtree_root, false);
+        small_right_rotation(subtree_root, false);
+    }
+    else
+    {
+        small_right_rotation(subtree_root->left_subtree, false);
+        small_right_rotation(subtree_root, false);
+    }
+}
+
+// endregion subtree rotations implementation
+
+// region stackless traversal implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_first(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) noexcept
+{
+    return subtree_root;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::prefix_next(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *current,
+    bool mirrored,
+    unsigned int *depth) noexcept
+{
+    if (current == nullptr)
+    {
+        return nullptr;
+    }
+    
+    node *near = mirrored ? current->right_subtree : current->left_subtree;
+    node *far = mirrored ? current->left_subtree : current->right_subtree;
+    
+    if (near != nullptr || far != nullptr)
+    {
+        step_depth(depth, 1);
+        
+        return near != nullptr ? near : far;
+    }
+    
+    while (current->parent != nullptr)
+    {
+        node *parent = current->parent;
+        far = mirrored ? parent->left_subtree : parent->right_subtree;
+        
+        // the far sibling lies at the depth of the node climbed from
+        if (far != nullptr && far != current)
+        {
+            return far;
+        }
+        
+        current = parent;
+        step_depth(depth, -1);
+    }
+    
+    return nullptr;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_first(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    bool mirrored,
+    unsigned int *depth) noexcept
+{
+    if (subtree_root == nullptr)
+    {
+        return nullptr;
+    }
+    
+    while (node *near = mirrored ? subtree_root->right_subtree : subtree_root->left_subtree)
+    {
+        subtree_root = near;
+        step_depth(depth, 1);
+    }
+    
+    return subtree_root;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::infix_next(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *current,
+    bool mirrored,
+    unsigned int *depth) noexcept
+{
+    if (current == nullptr)
+    {
+        return nullptr;
+    }
+    
+    node *far = mirrored ? current->left_subtree : current->right_subtree;
+    
+    if (far != nullptr)
+    {
+        step_depth(depth, 1);
+        
+        return infix_first(far, mirrored, depth);
+    }
+    
+    while (current->parent != nullptr && current == (mirrored ? current->parent->left_subtree : current->parent->right_subtree))
+    {
+        current = current->parent;
+        step_depth(depth, -1);
+    }
+    
+    if (current->parent != nullptr)
+    {
+        step_depth(depth, -1);
+    }
+    
+    return current->parent;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_first(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    bool mirrored,
+    unsigned int *depth) noexcept
+{
+    if (subtree_root == nullptr)
+    {
+        return nullptr;
+    }
+    
+    while (true)
+    {
+        node *near = mirrored ? subtree_root->right_subtree : subtree_root->left_subtree;
+        node *far = mirrored ? subtree_root->left_subtree : subtree_root->right_subtree;
+        
+        if (near == nullptr && far == nullptr)
+        {
+            return subtree_root;
+        }
+        
+        subtree_root = near != nullptr ? near : far;
+        step_depth(depth, 1);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::postfix_next(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *current,
+    bool mirrored,
+    unsigned int *depth) noexcept
+{
+    if (current == nullptr || current->parent == nullptr)
+    {
+        return nullptr;
+    }
+    
+    node *parent = current->parent;
+    node *far = mirrored ? parent->left_subtree : parent->right_subtree;
+    
+    if (far != nullptr && far != current)
+    {
+        return postfix_first(far, mirrored, depth);
+    }
+    
+    step_depth(depth, -1);
+    
+    return parent;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+unsigned int binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::depth_of(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *target) noexcept
+{
+    unsigned int depth = 0;
+    
+    while (target != nullptr && target->parent != nullptr)
+    {
+        target = target->parent;
+        ++depth;
+    }
+    
+    return depth;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::step_depth(
+    unsigned int *depth,
+    int delta) noexcept
+{
+    if (depth != nullptr)
+    {
+        *depth += delta;
+    }
+}
+
+// endregion stackless traversal implementation
+
+// region nodes allocation implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_node_size() const noexcept
+{
+    return sizeof(typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+[[nodiscard]] allocator *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_nodes_allocator() const
+{
+    if (_nodes_pool == nullptr)
+    {
+        _nodes_pool = std::shared_ptr<allocator_pool>(new allocator_pool(get_node_size(), nodes_per_slab, this->get_allocator(), this->get_logger()));
+    }
+    
+    return _nodes_pool.get();
+}
+
+// endregion nodes allocation implementation
+
+// region nodes construction implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::construct_node(
+    void *at,
+    tkey const &key,
+    tvalue const &value) const
+{
+    return new (at) node(key, value);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::construct_iterator_data(
+    void *at,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *viewed,
+    unsigned int depth) const noexcept
+{
+    return new (at) iterator_data(depth, *viewed);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::initialize_balanced_node(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *,
+    size_t,
+    size_t,
+    size_t) const
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::create_node(
+    tkey const &key,
+    tvalue const &value) const
+{
+    void *at = get_nodes_allocator()->allocate(get_node_size(), 1);
+    node *created;
+    
+    try
+    {
+        created = construct_node(at, key, value);
+    }
+    catch (...)
+    {
+        get_nodes_allocator()->deallocate(at);
+        throw;
+    }
+    
+    update_augmentation(created);
+    
+    return created;
+}
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::small_left_rotation(
-    binary_search_tree<tkey, tvalue>::node *&subtree_root,
-    bool validate) const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::destroy_subtree(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::small_left_rotation(binary_search_tree<tkey, tvalue>::node *&, bool) const", "your code should be here...");
+    node *current = postfix_first(subtree_root, false);
+    
+    while (current != nullptr)
+    {
+        node *next = current == subtree_root
+            ? nullptr
+            : postfix_next(current, false);
+        
+        // extended nodes only add trivially destructible fields, so the base part is all there is to destroy
+        current->~node();
+        get_nodes_allocator()->deallocate(current);
+        
+        current = next;
+    }
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::small_right_rotation(
-    binary_search_tree<tkey, tvalue>::node *&subtree_root,
-    bool validate) const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tforward_iterator>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::build_balanced(
+    tforward_iterator &current,
+    size_t count,
+    size_t depth,
+    size_t complete_levels_count,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&previous,
+    size_t &subtree_height) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::small_right_rotation(binary_search_tree<tkey, tvalue>::node *&, bool) const", "your code should be here...");
+    if (count == 0)
+    {
+        subtree_height = 0;
+        
+        return nullptr;
+    }
+    
+    size_t left_count = count / 2;
+    size_t left_height;
+    size_t right_height;
+    
+    node *left_subtree = build_balanced(current, left_count, depth + 1, complete_levels_count, previous, left_height);
+    node *subtree_root = nullptr;
+    
+    try
+    {
+        if (previous != nullptr && this->_keys_comparer(previous->key, current->key) >= 0)
+        {
+            throw std::logic_error("binary_search_tree::assign_sorted: keys are not in strictly ascending order");
+        }
+        
+        subtree_root = create_node(current->key, current->value);
+        ++current;
+        previous = subtree_root;
+        
+        subtree_root->left_subtree = left_subtree;
+        if (left_subtree != nullptr)
+        {
+            left_subtree->parent = subtree_root;
+        }
+        
+        subtree_root->right_subtree = build_balanced(current, count - left_count - 1, depth + 1, complete_levels_count, previous, right_height);
+        if (subtree_root->right_subtree != nullptr)
+        {
+            subtree_root->right_subtree->parent = subtree_root;
+        }
+    }
+    catch (...)
+    {
+        destroy_subtree(subtree_root == nullptr
+            ? left_subtree
+            : subtree_root);
+        throw;
+    }
+    
+    subtree_height = std::max(left_height, right_height) + 1;
+    initialize_balanced_node(subtree_root, subtree_height, depth, complete_levels_count);
+    update_augmentation(subtree_root);
+    
+    return subtree_root;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::big_left_rotation(
-    binary_search_tree<tkey, tvalue>::node *&subtree_root,
-    bool validate) const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::link_balanced(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *const *nodes,
+    size_t count,
+    size_t depth,
+    size_t complete_levels_count,
+    size_t &subtree_height) const
+{
+    if (count == 0)
+    {
+        subtree_height = 0;
+        
+        return nullptr;
+    }
+    
+    size_t left_count = count / 2;
+    size_t left_height;
+    size_t right_height;
+    
+    node *subtree_root = nodes[left_count];
+    
+    subtree_root->parent = nullptr;
+    subtree_root->left_subtree = link_balanced(nodes, left_count, depth + 1, complete_levels_count, left_height);
+    subtree_root->right_subtree = link_balanced(nodes + left_count + 1, count - left_count - 1, depth + 1, complete_levels_count, right_height);
+    
+    for (node *subtree: { subtree_root->left_subtree, subtree_root->right_subtree })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = subtree_root;
+        }
+    }
+    
+    subtree_height = std::max(left_height, right_height) + 1;
+    initialize_balanced_node(subtree_root, subtree_height, depth, complete_levels_count);
+    update_augmentation(subtree_root);
+    
+    return subtree_root;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_complete_levels_count(
+    size_t nodes_count) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::big_left_rotation(binary_search_tree<tkey, tvalue>::node *&, bool) const", "your code should be here...");
+    size_t complete_levels_count = 0;
+    
+    while (complete_levels_count + 1 < sizeof(size_t) * 8 && (static_cast<size_t>(1) << (complete_levels_count + 1)) - 1 <= nodes_count)
+    {
+        ++complete_levels_count;
+    }
+    
+    return complete_levels_count;
 }
 
+// endregion nodes construction implementation
+
+// region split and join implementation
+
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::big_right_rotation(
-    binary_search_tree<tkey, tvalue>::node *&subtree_root,
-    bool validate) const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_root() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::big_right_rotation(binary_search_tree<tkey, tvalue>::node *&, bool) const", "your code should be here...");
+    return _root;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::double_left_rotation(
-    binary_search_tree<tkey, tvalue>::node *&subtree_root,
-    bool at_grandparent_first,
-    bool validate) const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::detach_root() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::double_left_rotation(binary_search_tree<tkey, tvalue>::node *&, bool, bool) const", "your code should be here...");
+    node *detached = _root;
+    _root = nullptr;
+    
+    return detached;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void binary_search_tree<tkey, tvalue>::double_right_rotation(
-    binary_search_tree<tkey, tvalue>::node *&subtree_root,
-    bool at_grandparent_first,
-    bool validate) const
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::attach_root(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &nodes_owner)
+{
+    destroy_subtree(_root);
+    
+    if (&nodes_owner != this)
+    {
+        // nodes come only from an owner that has allocated them, so its pool exists whenever subtree_root does
+        _nodes_pool = nodes_owner._nodes_pool;
+    }
+    
+    _root = subtree_root;
+    if (_root != nullptr)
+    {
+        _root->parent = nullptr;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::shares_nodes_pool_with(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> void binary_search_tree<tkey, tvalue>::double_right_rotation(binary_search_tree<tkey, tvalue>::node *&, bool, bool) const", "your code should be here...");
+    return _nodes_pool != nullptr && _nodes_pool == other._nodes_pool;
 }
 
-// endregion subtree rotations implementation
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::relocate_subtree(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) const
+{
+    std::vector<node *> relocated;
+    
+    try
+    {
+        for (node const *current = infix_first(const_cast<node *>(subtree_root), false); current != nullptr; current = infix_next(const_cast<node *>(current), false))
+        {
+            relocated.push_back(create_node(current->key, current->value));
+        }
+    }
+    catch (...)
+    {
+        for (auto *node_to_destroy: relocated)
+        {
+            destroy_subtree(node_to_destroy);
+        }
+        
+        throw;
+    }
+    
+    size_t height;
+    
+    return link_balanced(relocated.data(), relocated.size(), 0, get_complete_levels_count(relocated.size()), height);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_subtrees(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const
+{
+    pivot->parent = nullptr;
+    pivot->left_subtree = left;
+    pivot->right_subtree = right;
+    
+    for (node *subtree: { left, right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = pivot;
+        }
+    }
+    
+    update_augmentation(pivot);
+    
+    return pivot;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::settle_root(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) noexcept
+{
+    if (subtree_root != nullptr)
+    {
+        subtree_root->parent = nullptr;
+    }
+    
+    _root = subtree_root;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_adjacent_subtrees(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const
+{
+    if (left == nullptr || right == nullptr)
+    {
+        return left == nullptr
+            ? right
+            : left;
+    }
+    
+    node *last;
+    node *rest = split_last(left, last);
+    
+    return join_subtrees(rest, last, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_subtree(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    tkey const &key,
+    bool key_goes_left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right) const
+{
+    if (subtree_root == nullptr)
+    {
+        left = right = nullptr;
+        
+        return;
+    }
+    
+    node *subtree_left = subtree_root->left_subtree;
+    node *subtree_right = subtree_root->right_subtree;
+    
+    for (node *subtree: { subtree_left, subtree_right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = nullptr;
+        }
+    }
+    
+    int comparison = this->_keys_comparer(subtree_root->key, key);
+    
+    if (comparison < 0 || (comparison == 0 && key_goes_left))
+    {
+        node *right_part_left;
+        split_subtree(subtree_right, key, key_goes_left, right_part_left, right);
+        left = join_subtrees(subtree_left, subtree_root, right_part_left);
+    }
+    else
+    {
+        node *left_part_right;
+        split_subtree(subtree_left, key, key_goes_left, left, left_part_right);
+        right = join_subtrees(left_part_right, subtree_root, subtree_right);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_last(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&last) const
+{
+    node *subtree_left = subtree_root->left_subtree;
+    node *subtree_right = subtree_root->right_subtree;
+    
+    for (node *subtree: { subtree_left, subtree_right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = nullptr;
+        }
+    }
+    
+    if (subtree_right == nullptr)
+    {
+        subtree_root->left_subtree = nullptr;
+        subtree_root->parent = nullptr;
+        update_augmentation(subtree_root);
+        last = subtree_root;
+        
+        return subtree_left;
+    }
+    
+    node *rest = split_last(subtree_right, last);
+    
+    return join_subtrees(subtree_left, subtree_root, rest);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_into(
+    tkey const &key,
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &right)
+{
+    if (&left == &right)
+    {
+        throw std::logic_error("binary_search_tree::split: left and right parts have to be different trees");
+    }
+    
+    node *left_part;
+    node *right_part;
+    split_subtree(detach_root(), key, false, left_part, right_part);
+    
+    left.attach_root(left_part, *this);
+    right.attach_root(right_part, *this);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_from(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+    tkey const &key,
+    tvalue const &value,
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &right)
+{
+    if (&left == &right)
+    {
+        throw std::logic_error("binary_search_tree::join: left and right parts have to be different trees");
+    }
+    
+    node *left_last = infix_first(left._root, true);
+    node *right_first = infix_first(right._root, false);
+    if ((left_last != nullptr && this->_keys_comparer(left_last->key, key) >= 0) ||
+        (right_first != nullptr && this->_keys_comparer(key, right_first->key) >= 0))
+    {
+        throw std::logic_error("binary_search_tree::join: keys of the left part have to be less than the pivot key and keys of the right part greater");
+    }
+    
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &nodes_owner = left._root != nullptr || right._root == nullptr
+        ? left
+        : right;
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &other = &nodes_owner == &left
+        ? right
+        : left;
+    
+    node *pivot = nodes_owner.create_node(key, value);
+    
+    if (other._root != nullptr && !nodes_owner.shares_nodes_pool_with(other))
+    {
+        node *relocated;
+        
+        try
+        {
+            relocated = nodes_owner.relocate_subtree(other._root);
+        }
+        catch (...)
+        {
+            nodes_owner.destroy_subtree(pivot);
+            throw;
+        }
+        
+        other.destroy_subtree(other._root);
+        other._root = relocated;
+    }
+    
+    node *left_part = left.detach_root();
+    node *right_part = right.detach_root();
+    
+    attach_root(join_subtrees(left_part, pivot, right_part), nodes_owner);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::dispose_range(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive)
+{
+    node *below;
+    node *rest;
+    node *range;
+    node *above;
+    
+    split_subtree(detach_root(), lower_bound, !lower_bound_inclusive, below, rest);
+    split_subtree(rest, upper_bound, upper_bound_inclusive, range, above);
+    
+    size_t disposed_count = 0;
+    for (node *current = infix_first(range, false); current != nullptr; current = infix_next(current, false))
+    {
+        ++disposed_count;
+    }
+    
+    destroy_subtree(range);
+    
+    _root = join_adjacent_subtrees(below, above);
+    if (_root != nullptr)
+    {
+        _root->parent = nullptr;
+    }
+    
+    return disposed_count;
+}
+
+// endregion split and join implementation
+
+// region set operations implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::combine_from(
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_operation operation,
+    size_t threads_limit)
+{
+    if (&other == this)
+    {
+        if (operation == set_operation::subtract)
+        {
+            destroy_subtree(detach_root());
+        }
+        
+        return;
+    }
+    
+    if (operation == set_operation::unite && _root == nullptr)
+    {
+        attach_root(other.detach_root(), other);
+        
+        return;
+    }
+    
+    // the union keeps nodes of both trees, so they have to come from one pool;
+    // the other operations only dispose other's nodes and leave them where they are
+    bool relocate = operation == set_operation::unite && other._root != nullptr && !shares_nodes_pool_with(other);
+    if (relocate)
+    {
+        node *relocated = relocate_subtree(other._root);
+        other.destroy_subtree(other.detach_root());
+        other._root = relocated;
+    }
+    
+    if (threads_limit == 0)
+    {
+        threads_limit = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    
+    std::atomic<size_t> spare_threads(threads_limit - 1);
+    node *discarded_own = nullptr;
+    node *discarded_other = nullptr;
+    
+    node *own_part = detach_root();
+    node *other_part = other.detach_root();
+    
+    settle_root(combine_subtrees(own_part, other_part, operation, get_parallel_depth(threads_limit), spare_threads, discarded_own, discarded_other));
+    
+    destroy_discarded(discarded_own);
+    
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation> const &discarded_other_owner = relocate
+        ? *this
+        : other;
+    discarded_other_owner.destroy_discarded(discarded_other);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::combine_subtrees(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *own,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *other,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_operation operation,
+    size_t parallel_depth,
+    std::atomic<size_t> &spare_threads,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&discarded_own,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&discarded_other) const
+{
+    if (own == nullptr || other == nullptr)
+    {
+        switch (operation)
+        {
+            case set_operation::unite:
+                return own == nullptr
+                    ? other
+                    : own;
+            case set_operation::intersect:
+                if (own != nullptr)
+                {
+                    discard(own, discarded_own);
+                }
+                if (other != nullptr)
+                {
+                    discard(other, discarded_other);
+                }
+                
+                return nullptr;
+            default:
+                if (other != nullptr)
+                {
+                    discard(other, discarded_other);
+                }
+                
+                return own;
+        }
+    }
+    
+    bool in_parallel = parallel_depth != 0 &&
+        get_left_spine_length(own) >= parallel_set_operation_min_spine_length &&
+        get_left_spine_length(other) >= parallel_set_operation_min_spine_length;
+    
+    node *other_left = other->left_subtree;
+    node *other_right = other->right_subtree;
+    
+    for (node *subtree: { other_left, other_right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = nullptr;
+        }
+    }
+    
+    other->left_subtree = other->right_subtree = other->parent = nullptr;
+    update_augmentation(other);
+    
+    node *own_left;
+    node *own_right;
+    node *matched = split_around(own, other->key, own_left, own_right);
+    
+    node *left;
+    node *right;
+    
+    if (in_parallel)
+    {
+        node *left_discarded_own = nullptr;
+        node *left_discarded_other = nullptr;
+        std::future<void> left_done;
+        
+        auto combine_left = [&]()
+        {
+            left = combine_subtrees(own_left, other_left, operation, parallel_depth - 1, spare_threads, left_discarded_own, left_discarded_other);
+        };
+        
+        // a fork needs a spare thread, otherwise the left part is combined here after the right one
+        size_t spare = spare_threads.load();
+        while (spare != 0 && !spare_threads.compare_exchange_weak(spare, spare - 1))
+        {
+            // spare holds the current count again
+        }
+        
+        if (spare != 0)
+        {
+            try
+            {
+                left_done = std::async(std::launch::async, [&]()
+                    {
+                        combine_left();
+                        spare_threads.fetch_add(1);
+                    });
+            }
+            catch (...)
+            {
+                spare_threads.fetch_add(1);
+            }
+        }
+        
+        right = combine_subtrees(own_right, other_right, operation, parallel_depth - 1, spare_threads, discarded_own, discarded_other);
+        
+        if (left_done.valid())
+        {
+            left_done.get();
+        }
+        else
+        {
+            combine_left();
+        }
+        
+        append_discarded(discarded_own, left_discarded_own);
+        append_discarded(discarded_other, left_discarded_other);
+    }
+    else
+    {
+        left = combine_subtrees(own_left, other_left, operation, 0, spare_threads, discarded_own, discarded_other);
+        right = combine_subtrees(own_right, other_right, operation, 0, spare_threads, discarded_own, discarded_other);
+    }
+    
+    switch (operation)
+    {
+        case set_operation::unite:
+            if (matched == nullptr)
+            {
+                return join_subtrees(left, other, right);
+            }
+            
+            discard(other, discarded_other);
+            
+            return join_subtrees(left, matched, right);
+        case set_operation::intersect:
+            discard(other, discarded_other);
+            
+            return matched == nullptr
+                ? join_adjacent_subtrees(left, right)
+                : join_subtrees(left, matched, right);
+        default:
+            discard(other, discarded_other);
+            if (matched != nullptr)
+            {
+                discard(matched, discarded_own);
+            }
+            
+            return join_adjacent_subtrees(left, right);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_around(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    tkey const &key,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right) const
+{
+    if (subtree_root == nullptr)
+    {
+        left = right = nullptr;
+        
+        return nullptr;
+    }
+    
+    node *subtree_left = subtree_root->left_subtree;
+    node *subtree_right = subtree_root->right_subtree;
+    
+    for (node *subtree: { subtree_left, subtree_right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = nullptr;
+        }
+    }
+    
+    int comparison = this->_keys_comparer(subtree_root->key, key);
+    
+    if (comparison == 0)
+    {
+        left = subtree_left;
+        right = subtree_right;
+        subtree_root->left_subtree = subtree_root->right_subtree = subtree_root->parent = nullptr;
+        update_augmentation(subtree_root);
+        
+        return subtree_root;
+    }
+    
+    node *matched;
+    
+    if (comparison < 0)
+    {
+        node *right_part_left;
+        matched = split_around(subtree_right, key, right_part_left, right);
+        left = join_subtrees(subtree_left, subtree_root, right_part_left);
+    }
+    else
+    {
+        node *left_part_right;
+        matched = split_around(subtree_left, key, left, left_part_right);
+        right = join_subtrees(left_part_right, subtree_root, subtree_right);
+    }
+    
+    return matched;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::discard(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&discarded) noexcept
+{
+    subtree_root->parent = discarded;
+    discarded = subtree_root;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::append_discarded(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&discarded,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *more_discarded) noexcept
+{
+    if (more_discarded == nullptr)
+    {
+        return;
+    }
+    
+    node *last = more_discarded;
+    while (last->parent != nullptr)
+    {
+        last = last->parent;
+    }
+    
+    last->parent = discarded;
+    discarded = more_discarded;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::destroy_discarded(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *discarded) const noexcept
+{
+    while (discarded != nullptr)
+    {
+        node *next = discarded->parent;
+        discarded->parent = nullptr;
+        destroy_subtree(discarded);
+        discarded = next;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_parallel_depth(
+    size_t threads_count) noexcept
+{
+    if (threads_count <= 1)
+    {
+        return 0;
+    }
+    
+    // twice as many leaf tasks as threads, so the uneven splits even out
+    size_t depth = 0;
+    for (size_t tasks_count = 1; tasks_count < 2 * threads_count; tasks_count <<= 1)
+    {
+        ++depth;
+    }
+    
+    return depth;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_left_spine_length(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept
+{
+    size_t length = 0;
+    
+    for (; subtree_root != nullptr; subtree_root = subtree_root->left_subtree)
+    {
+        ++length;
+    }
+    
+    return length;
+}
+
+// endregion set operations implementation
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
\ No newline at end of file
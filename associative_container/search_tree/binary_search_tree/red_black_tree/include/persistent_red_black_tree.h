@@ -0,0 +1,814 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_PERSISTENT_RED_BLACK_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_PERSISTENT_RED_BLACK_TREE_H
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <allocator.h>
+#include <allocator_std_adapter.h>
+#include <search_tree.h>
+
+// red-black tree with path copying: insert and dispose never touch a published node, they copy the O(log n) nodes
+// on the search path and publish the new version atomically. Readers take a snapshot, a refcounted handle to one
+// version, and read it without any lock while writers go on; the nodes of a version are released with the last
+// snapshot or version sharing them. Writers are serialized among themselves only.
+// Nodes have no parent links (a node can be shared by many versions), so unlike red_black_tree this one
+// does not offer the stackless iterators; snapshots are scanned with visitors instead
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer = default_keys_comparer<tkey>>
+class persistent_red_black_tree final
+{
+
+public:
+    
+    enum class node_color
+    {
+        RED,
+        BLACK
+    };
+
+private:
+    
+    struct node;
+    
+    typedef std::shared_ptr<node const> node_pointer;
+    
+    struct node final
+    {
+    
+    public:
+        
+        tkey key;
+        
+        tvalue value;
+        
+        node_color color;
+        
+        node_pointer left_subtree;
+        
+        node_pointer right_subtree;
+    
+    public:
+        
+        node(
+            tkey const &key,
+            tvalue const &value,
+            node_color color,
+            node_pointer left_subtree,
+            node_pointer right_subtree);
+        
+    };
+    
+    struct version final
+    {
+    
+    public:
+        
+        node_pointer root;
+        
+        size_t size;
+    
+    public:
+        
+        version(
+            node_pointer root,
+            size_t size);
+        
+    };
+
+public:
+    
+    // an immutable view of one version; copying it is as cheap as copying a std::shared_ptr
+    class snapshot final
+    {
+        
+        friend class persistent_red_black_tree<tkey, tvalue, tkey_comparer>;
+    
+    private:
+        
+        std::shared_ptr<version const> _version;
+        
+        tkey_comparer _keys_comparer;
+    
+    private:
+        
+        snapshot(
+            std::shared_ptr<version const> version,
+            tkey_comparer keys_comparer);
+    
+    public:
+        
+        size_t size() const noexcept;
+        
+        // pointer to the value stored in the snapshot or nullptr if there is no such key; valid while the snapshot lives
+        tvalue const *find(
+            tkey const &key) const;
+        
+        bool contains(
+            tkey const &key) const;
+        
+        // calls visitor(key, value) for the entries of the range in key order; the scan stops as soon as the visitor returns false
+        template<
+            typename tvisitor>
+        void for_each_between(
+            tkey const &lower_bound,
+            tkey const &upper_bound,
+            bool lower_bound_inclusive,
+            bool upper_bound_inclusive,
+            tvisitor &&visitor) const;
+        
+        template<
+            typename tvisitor>
+        void for_each(
+            tvisitor &&visitor) const;
+    
+    private:
+        
+        // returns false if the visitor has stopped the scan
+        template<
+            typename tvisitor>
+        bool visit_between(
+            node const *subtree_root,
+            tkey const &lower_bound,
+            tkey const &upper_bound,
+            bool lower_bound_inclusive,
+            bool upper_bound_inclusive,
+            tvisitor &visitor) const;
+        
+    };
+
+private:
+    
+    tkey_comparer _keys_comparer;
+    
+    allocator *_allocator;
+    
+    // read by everyone through std::atomic_load, replaced by writers through std::atomic_store
+    std::shared_ptr<version const> _published;
+    
+    std::mutex _writers_lock;
+
+public:
+    
+    // nodes are released by whichever thread drops the last reference to them, readers included,
+    // so a custom allocator has to be safe for concurrent use (e.g. allocator_synchronized)
+    explicit persistent_red_black_tree(
+        tkey_comparer keys_comparer = tkey_comparer(),
+        allocator *allocator = nullptr);
+    
+    persistent_red_black_tree(
+        persistent_red_black_tree<tkey, tvalue, tkey_comparer> const &other) = delete;
+    
+    persistent_red_black_tree<tkey, tvalue, tkey_comparer> &operator=(
+        persistent_red_black_tree<tkey, tvalue, tkey_comparer> const &other) = delete;
+
+public:
+    
+    snapshot get_snapshot() const;
+    
+    // replaces the value of an existent key; returns whether the key is new
+    bool insert(
+        tkey const &key,
+        tvalue const &value);
+    
+    // returns whether the key has been there; nothing is published if it has not
+    bool dispose(
+        tkey const &key);
+
+private:
+    
+    void publish(
+        node_pointer root,
+        size_t size);
+    
+    node_pointer create_node(
+        node_color color,
+        node_pointer left_subtree,
+        tkey const &key,
+        tvalue const &value,
+        node_pointer right_subtree) const;
+    
+    node_pointer create_node(
+        node_color color,
+        node_pointer left_subtree,
+        node_pointer const &entry,
+        node_pointer right_subtree) const;
+    
+    node_pointer with_color(
+        node_pointer const &target,
+        node_color color) const;
+    
+    static bool is_red(
+        node_pointer const &subtree_root) noexcept;
+    
+    static bool is_black(
+        node_pointer const &subtree_root) noexcept;
+
+private:
+    
+    // the copying rebalancing below follows S. Kahrs, "Red-black trees with types", J. Funct. Program. 11(4), 2001
+    
+    node_pointer insert_into(
+        node_pointer const &subtree_root,
+        tkey const &key,
+        tvalue const &value) const;
+    
+    // a black node over entry and the subtrees, resolving a red-red violation in either of them
+    node_pointer balance(
+        node_pointer const &left,
+        node_pointer const &entry,
+        node_pointer const &right) const;
+    
+    // disposing from a black rooted subtree lowers its black height by one, from a red rooted one keeps it
+    node_pointer dispose_from(
+        node_pointer const &subtree_root,
+        tkey const &key) const;
+    
+    // restores the black height after the left subtree has lost one level
+    node_pointer balance_left(
+        node_pointer const &left,
+        node_pointer const &entry,
+        node_pointer const &right) const;
+    
+    node_pointer balance_right(
+        node_pointer const &left,
+        node_pointer const &entry,
+        node_pointer const &right) const;
+    
+    // joins two subtrees of the same black height without a separating entry
+    node_pointer append(
+        node_pointer const &left,
+        node_pointer const &right) const;
+    
+    node_pointer turn_red(
+        node_pointer const &target) const;
+    
+};
+
+// region persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node::node(
+    tkey const &key,
+    tvalue const &value,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_color color,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer left_subtree,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer right_subtree):
+    key(key),
+    value(value),
+    color(color),
+    left_subtree(std::move(left_subtree)),
+    right_subtree(std::move(right_subtree))
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+persistent_red_black_tree<tkey, tvalue, tkey_comparer>::version::version(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer root,
+    size_t size):
+    root(std::move(root)),
+    size(size)
+{
+
+}
+
+// endregion persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node implementation
+
+// region persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot::snapshot(
+    std::shared_ptr<typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::version const> version,
+    tkey_comparer keys_comparer):
+    _version(std::move(version)),
+    _keys_comparer(std::move(keys_comparer))
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+size_t persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot::size() const noexcept
+{
+    return _version->size;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+tvalue const *persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot::find(
+    tkey const &key) const
+{
+    node const *current = _version->root.get();
+    
+    while (current != nullptr)
+    {
+        int comparison = _keys_comparer(key, current->key);
+        
+        if (comparison == 0)
+        {
+            return &current->value;
+        }
+        
+        current = comparison < 0
+            ? current->left_subtree.get()
+            : current->right_subtree.get();
+    }
+    
+    return nullptr;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+bool persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot::contains(
+    tkey const &key) const
+{
+    return find(key) != nullptr;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+template<
+    typename tvisitor>
+void persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot::for_each_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive,
+    tvisitor &&visitor) const
+{
+    visit_between(_version->root.get(), lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive, visitor);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+template<
+    typename tvisitor>
+void persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot::for_each(
+    tvisitor &&visitor) const
+{
+    node const *leftmost = _version->root.get();
+    node const *rightmost = leftmost;
+    
+    if (leftmost == nullptr)
+    {
+        return;
+    }
+    
+    while (leftmost->left_subtree != nullptr)
+    {
+        leftmost = leftmost->left_subtree.get();
+    }
+    
+    while (rightmost->right_subtree != nullptr)
+    {
+        rightmost = rightmost->right_subtree.get();
+    }
+    
+    visit_between(_version->root.get(), leftmost->key, rightmost->key, true, true, visitor);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+template<
+    typename tvisitor>
+bool persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot::visit_between(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node const *subtree_root,
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive,
+    tvisitor &visitor) const
+{
+    // the recursion depth is bounded by the tree height, at most 2 log2(n + 1)
+    if (subtree_root == nullptr)
+    {
+        return true;
+    }
+    
+    int lower_comparison = _keys_comparer(subtree_root->key, lower_bound);
+    int upper_comparison = _keys_comparer(subtree_root->key, upper_bound);
+    bool above_lower_bound = lower_comparison > 0 || (lower_comparison == 0 && lower_bound_inclusive);
+    bool below_upper_bound = upper_comparison < 0 || (upper_comparison == 0 && upper_bound_inclusive);
+    
+    if (lower_comparison > 0 && !visit_between(subtree_root->left_subtree.get(), lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive, visitor))
+    {
+        return false;
+    }
+    
+    if (above_lower_bound && below_upper_bound &&
+        !visitor(static_cast<tkey const &>(subtree_root->key), static_cast<tvalue const &>(subtree_root->value)))
+    {
+        return false;
+    }
+    
+    return upper_comparison >= 0 ||
+        visit_between(subtree_root->right_subtree.get(), lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive, visitor);
+}
+
+// endregion persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot implementation
+
+// region persistent_red_black_tree<tkey, tvalue, tkey_comparer> implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+persistent_red_black_tree<tkey, tvalue, tkey_comparer>::persistent_red_black_tree(
+    tkey_comparer keys_comparer,
+    allocator *allocator):
+    _keys_comparer(std::move(keys_comparer)),
+    _allocator(allocator)
+{
+    publish(nullptr, 0);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::snapshot persistent_red_black_tree<tkey, tvalue, tkey_comparer>::get_snapshot() const
+{
+    return snapshot(std::atomic_load(&_published), _keys_comparer);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+bool persistent_red_black_tree<tkey, tvalue, tkey_comparer>::insert(
+    tkey const &key,
+    tvalue const &value)
+{
+    std::lock_guard<std::mutex> lock(_writers_lock);
+    
+    snapshot current = get_snapshot();
+    bool is_new = !current.contains(key);
+    
+    publish(with_color(insert_into(current._version->root, key, value), node_color::BLACK), current.size() + (is_new ? 1 : 0));
+    
+    return is_new;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+bool persistent_red_black_tree<tkey, tvalue, tkey_comparer>::dispose(
+    tkey const &key)
+{
+    std::lock_guard<std::mutex> lock(_writers_lock);
+    
+    snapshot current = get_snapshot();
+    if (!current.contains(key))
+    {
+        return false;
+    }
+    
+    publish(with_color(dispose_from(current._version->root, key), node_color::BLACK), current.size() - 1);
+    
+    return true;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+void persistent_red_black_tree<tkey, tvalue, tkey_comparer>::publish(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer root,
+    size_t size)
+{
+    std::atomic_store(&_published, std::shared_ptr<version const>(std::allocate_shared<version>(allocator_std_adapter<version>(_allocator), std::move(root), size)));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::create_node(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_color color,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer left_subtree,
+    tkey const &key,
+    tvalue const &value,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer right_subtree) const
+{
+    return std::allocate_shared<node>(allocator_std_adapter<node>(_allocator), key, value, color, std::move(left_subtree), std::move(right_subtree));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::create_node(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_color color,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer left_subtree,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &entry,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer right_subtree) const
+{
+    return create_node(color, std::move(left_subtree), entry->key, entry->value, std::move(right_subtree));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::with_color(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &target,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_color color) const
+{
+    return target == nullptr || target->color == color
+        ? target
+        : create_node(color, target->left_subtree, target, target->right_subtree);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+bool persistent_red_black_tree<tkey, tvalue, tkey_comparer>::is_red(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &subtree_root) noexcept
+{
+    return subtree_root != nullptr && subtree_root->color == node_color::RED;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+bool persistent_red_black_tree<tkey, tvalue, tkey_comparer>::is_black(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &subtree_root) noexcept
+{
+    return subtree_root != nullptr && subtree_root->color == node_color::BLACK;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::insert_into(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &subtree_root,
+    tkey const &key,
+    tvalue const &value) const
+{
+    if (subtree_root == nullptr)
+    {
+        return create_node(node_color::RED, nullptr, key, value, nullptr);
+    }
+    
+    int comparison = _keys_comparer(key, subtree_root->key);
+    
+    if (comparison == 0)
+    {
+        return create_node(subtree_root->color, subtree_root->left_subtree, key, value, subtree_root->right_subtree);
+    }
+    
+    node_pointer left = comparison < 0
+        ? insert_into(subtree_root->left_subtree, key, value)
+        : subtree_root->left_subtree;
+    node_pointer right = comparison < 0
+        ? subtree_root->right_subtree
+        : insert_into(subtree_root->right_subtree, key, value);
+    
+    return subtree_root->color == node_color::BLACK
+        ? balance(left, subtree_root, right)
+        : create_node(node_color::RED, left, subtree_root, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::balance(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &left,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &entry,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &right) const
+{
+    if (is_red(left) && is_red(right))
+    {
+        return create_node(node_color::RED, with_color(left, node_color::BLACK), entry, with_color(right, node_color::BLACK));
+    }
+    
+    if (is_red(left) && is_red(left->left_subtree))
+    {
+        return create_node(node_color::RED,
+            with_color(left->left_subtree, node_color::BLACK),
+            left,
+            create_node(node_color::BLACK, left->right_subtree, entry, right));
+    }
+    
+    if (is_red(left) && is_red(left->right_subtree))
+    {
+        node_pointer const &middle = left->right_subtree;
+        
+        return create_node(node_color::RED,
+            create_node(node_color::BLACK, left->left_subtree, left, middle->left_subtree),
+            middle,
+            create_node(node_color::BLACK, middle->right_subtree, entry, right));
+    }
+    
+    if (is_red(right) && is_red(right->right_subtree))
+    {
+        return create_node(node_color::RED,
+            create_node(node_color::BLACK, left, entry, right->left_subtree),
+            right,
+            with_color(right->right_subtree, node_color::BLACK));
+    }
+    
+    if (is_red(right) && is_red(right->left_subtree))
+    {
+        node_pointer const &middle = right->left_subtree;
+        
+        return create_node(node_color::RED,
+            create_node(node_color::BLACK, left, entry, middle->left_subtree),
+            middle,
+            create_node(node_color::BLACK, middle->right_subtree, right, right->right_subtree));
+    }
+    
+    return create_node(node_color::BLACK, left, entry, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::dispose_from(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &subtree_root,
+    tkey const &key) const
+{
+    if (subtree_root == nullptr)
+    {
+        return nullptr;
+    }
+    
+    int comparison = _keys_comparer(key, subtree_root->key);
+    
+    if (comparison == 0)
+    {
+        return append(subtree_root->left_subtree, subtree_root->right_subtree);
+    }
+    
+    if (comparison < 0)
+    {
+        return is_black(subtree_root->left_subtree)
+            ? balance_left(dispose_from(subtree_root->left_subtree, key), subtree_root, subtree_root->right_subtree)
+            : create_node(node_color::RED, dispose_from(subtree_root->left_subtree, key), subtree_root, subtree_root->right_subtree);
+    }
+    
+    return is_black(subtree_root->right_subtree)
+        ? balance_right(subtree_root->left_subtree, subtree_root, dispose_from(subtree_root->right_subtree, key))
+        : create_node(node_color::RED, subtree_root->left_subtree, subtree_root, dispose_from(subtree_root->right_subtree, key));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::balance_left(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &left,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &entry,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &right) const
+{
+    if (is_red(left))
+    {
+        return create_node(node_color::RED, with_color(left, node_color::BLACK), entry, right);
+    }
+    
+    if (is_black(right))
+    {
+        return balance(left, entry, with_color(right, node_color::RED));
+    }
+    
+    if (is_red(right) && is_black(right->left_subtree))
+    {
+        node_pointer const &middle = right->left_subtree;
+        
+        return create_node(node_color::RED,
+            create_node(node_color::BLACK, left, entry, middle->left_subtree),
+            middle,
+            balance(middle->right_subtree, right, turn_red(right->right_subtree)));
+    }
+    
+    throw std::logic_error("persistent_red_black_tree::balance_left: red-black invariants are broken");
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::balance_right(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &left,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &entry,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &right) const
+{
+    if (is_red(right))
+    {
+        return create_node(node_color::RED, left, entry, with_color(right, node_color::BLACK));
+    }
+    
+    if (is_black(left))
+    {
+        return balance(with_color(left, node_color::RED), entry, right);
+    }
+    
+    if (is_red(left) && is_black(left->right_subtree))
+    {
+        node_pointer const &middle = left->right_subtree;
+        
+        return create_node(node_color::RED,
+            balance(turn_red(left->left_subtree), left, middle->left_subtree),
+            middle,
+            create_node(node_color::BLACK, middle->right_subtree, entry, right));
+    }
+    
+    throw std::logic_error("persistent_red_black_tree::balance_right: red-black invariants are broken");
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::append(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &left,
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &right) const
+{
+    if (left == nullptr || right == nullptr)
+    {
+        return left == nullptr
+            ? right
+            : left;
+    }
+    
+    if (is_red(left) && is_red(right))
+    {
+        node_pointer middle = append(left->right_subtree, right->left_subtree);
+        
+        return is_red(middle)
+            ? create_node(node_color::RED,
+                create_node(node_color::RED, left->left_subtree, left, middle->left_subtree),
+                middle,
+                create_node(node_color::RED, middle->right_subtree, right, right->right_subtree))
+            : create_node(node_color::RED,
+                left->left_subtree,
+                left,
+                create_node(node_color::RED, middle, right, right->right_subtree));
+    }
+    
+    if (is_black(left) && is_black(right))
+    {
+        node_pointer middle = append(left->right_subtree, right->left_subtree);
+        
+        return is_red(middle)
+            ? create_node(node_color::RED,
+                create_node(node_color::BLACK, left->left_subtree, left, middle->left_subtree),
+                middle,
+                create_node(node_color::BLACK, middle->right_subtree, right, right->right_subtree))
+            : balance_left(left->left_subtree, left, create_node(node_color::BLACK, middle, right, right->right_subtree));
+    }
+    
+    return is_red(right)
+        ? create_node(node_color::RED, append(left, right->left_subtree), right, right->right_subtree)
+        : create_node(node_color::RED, left->left_subtree, left, append(left->right_subtree, right));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer>
+typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer persistent_red_black_tree<tkey, tvalue, tkey_comparer>::turn_red(
+    typename persistent_red_black_tree<tkey, tvalue, tkey_comparer>::node_pointer const &target) const
+{
+    if (!is_black(target))
+    {
+        throw std::logic_error("persistent_red_black_tree::turn_red: red-black invariants are broken");
+    }
+    
+    return with_color(target, node_color::RED);
+}
+
+// endregion persistent_red_black_tree<tkey, tvalue, tkey_comparer> implementation
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_PERSISTENT_RED_BLACK_TREE_H
\ No newline at end of file
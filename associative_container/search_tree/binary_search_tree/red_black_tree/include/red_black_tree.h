@@ -5,9 +5,11 @@
 
 template<
     typename tkey,
-    typename tvalue>
+    typename tvalue,
+    typename tkey_comparer = default_keys_comparer<tkey>,
+    typename taugmentation = no_augmentation>
 class red_black_tree final:
-    public binary_search_tree<tkey, tvalue>
+    public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>
 {
 
 public:
@@ -21,9 +23,13 @@ public:
 private:
     
     struct node final:
-        binary_search_tree<tkey, tvalue>::node
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node
     {
         
+        using binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node::node;
+        
+        node_color color = node_color::RED;
+        
         // TODO: think about it!
         
     };
@@ -31,7 +37,7 @@ private:
 public:
     
     struct iterator_data final:
-        public binary_search_tree<tkey, tvalue>::iterator_data
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data
     {
     
     public:
@@ -46,50 +52,60 @@ public:
             tvalue const &value,
             node_color color);
         
+        explicit iterator_data(
+            unsigned int depth,
+            node const &viewed) noexcept;
+        
     };
 
 private:
     
     class insertion_template_method final:
-        public binary_search_tree<tkey, tvalue>::insertion_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method
     {
     
     public:
         
         explicit insertion_template_method(
-            red_black_tree<tkey, tvalue> *tree,
-            typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy);
+            red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy);
     
     private:
         
-        // TODO: think about it!
+        void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept override;
         
     };
     
     class obtaining_template_method final:
-        public binary_search_tree<tkey, tvalue>::obtaining_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method
     {
     
     public:
         
         explicit obtaining_template_method(
-            red_black_tree<tkey, tvalue> *tree);
+            red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
         
         // TODO: think about it!
         
     };
     
     class disposal_template_method final:
-        public binary_search_tree<tkey, tvalue>::disposal_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method
     {
     
     public:
         
         explicit disposal_template_method(
-            red_black_tree<tkey, tvalue> *tree,
-            typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy);
+            red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy);
+    
+    private:
         
-        // TODO: think about it!
+        void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+            bool from_left_subtree,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *disposed) noexcept override;
         
     };
 
@@ -98,125 +114,1218 @@ public:
     explicit red_black_tree(
         allocator *allocator = nullptr,
         logger *logger = nullptr,
-        typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
-        typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception);
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception,
+        tkey_comparer keys_comparer = tkey_comparer());
+    
+    template<
+        typename tforward_iterator,
+        typename = typename std::iterator_traits<tforward_iterator>::iterator_category>
+    explicit red_black_tree(
+        tforward_iterator first,
+        tforward_iterator last,
+        allocator *allocator = nullptr,
+        logger *logger = nullptr,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy::throw_an_exception,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy = binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception,
+        tkey_comparer keys_comparer = tkey_comparer());
 
 public:
     
     ~red_black_tree() noexcept final;
     
     red_black_tree(
-        red_black_tree<tkey, tvalue> const &other);
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
-    red_black_tree<tkey, tvalue> &operator=(
-        red_black_tree<tkey, tvalue> const &other);
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
     red_black_tree(
-        red_black_tree<tkey, tvalue> &&other) noexcept;
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
+    
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
+
+public:
+    
+    // region split and join definition
+    
+    // moves the entries with keys less than key into left and the rest into right in O(log n);
+    // the previous content of both parts is disposed, this tree ends up empty unless it is one of them
+    void split(
+        tkey const &key,
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &right);
+    
+    // replaces the content with the entries of left, the given entry and the entries of right in O(log n);
+    // all keys of left have to be less than key and all keys of right greater, both parts end up empty
+    void join(
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+        tkey const &key,
+        tvalue const &value,
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &right);
+    
+    // two splits and a join: O(log n) plus freeing the disposed nodes; returns how many entries were disposed
+    size_t dispose_between(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive);
+    
+    // endregion split and join definition
+
+public:
+    
+    // region set operations definition
+    
+    // the set operations take O(m log(n / m + 1)) work for trees of m <= n entries and are split across up to threads_limit
+    // threads for large trees (0 means one per hardware thread, 1 keeps them on the calling thread);
+    // on equal keys the entries of this tree are kept, other ends up empty
+    
+    void unite(
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+        size_t threads_limit = 0);
+    
+    void intersect(
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+        size_t threads_limit = 0);
+    
+    void subtract(
+        red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+        size_t threads_limit = 0);
+    
+    // endregion set operations definition
+
+public:
+    
+    // walks the whole tree in O(n): the root is black, no red node has a red child, every path down
+    // passes the same number of black nodes and the children link back to their parents
+    bool check_invariants() const noexcept;
+
+private:
+    
+    size_t get_node_size() const noexcept override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *construct_node(
+        void *at,
+        tkey const &key,
+        tvalue const &value) const override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *construct_iterator_data(
+        void *at,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *viewed,
+        unsigned int depth) const noexcept override;
+    
+    void initialize_balanced_node(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+        size_t,
+        size_t depth,
+        size_t complete_levels_count) const override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *join_subtrees(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const override;
+    
+    void settle_root(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) noexcept override;
+    
+    // the splits take the black height of the whole subtree once and derive the ones of the parts on the way down,
+    // as finding a black height on every join along the path would make a split O(log^2 n)
+    void split_subtree(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+        tkey const &key,
+        bool key_goes_left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right) const override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *split_last(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&last) const override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *split_around(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+        tkey const &key,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right) const override;
     
-    red_black_tree<tkey, tvalue> &operator=(
-        red_black_tree<tkey, tvalue> &&other) noexcept;
+    void split_with_black_heights(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+        size_t black_height,
+        tkey const &key,
+        bool key_goes_left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+        size_t &left_black_height,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right,
+        size_t &right_black_height) const;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *split_last_with_black_heights(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+        size_t black_height,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&last,
+        size_t &rest_black_height) const;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *split_around_with_black_heights(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+        size_t black_height,
+        tkey const &key,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+        size_t &left_black_height,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right,
+        size_t &right_black_height) const;
+    
+    // join_subtrees for parts of known black heights, O(difference of the black heights)
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *join_with_black_heights(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        size_t left_black_height,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right,
+        size_t right_black_height,
+        size_t &joined_black_height) const;
+    
+    // descends the right spine of the left subtree to a black node of the right subtree black height
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *join_right(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right,
+        size_t left_black_height,
+        size_t right_black_height) const;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *join_left(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right,
+        size_t left_black_height,
+        size_t right_black_height) const;
+    
+    static bool is_red(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept;
+    
+    static void set_color(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+        node_color color) noexcept;
+    
+    static size_t get_black_height(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept;
+    
+    // the inserted node is red: recolours and rotates upwards while it has a red parent
+    void fix_red_violation(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept;
+    
+    // a black node was unlinked from the given side of parent, so that side lacks one black node on every path
+    void fix_black_deficit(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+        bool from_left_subtree) noexcept;
+    
+    static bool check_subtree(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root,
+        size_t &black_height) noexcept;
+    
+    static typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *link(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) noexcept;
     
 };
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue>::iterator_data::iterator_data(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data::iterator_data(
     unsigned int depth,
     tkey const &key,
     tvalue const &value,
-    typename red_black_tree<tkey, tvalue>::node_color color):
-    binary_search_tree<tkey, tvalue>::iterator_data(depth, key, value)
+    typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::node_color color):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data(depth, key, value),
+    color(color)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue>::iterator_data::iterator_data(unsigned int, tkey const &, tvalue const &, typename red_black_tree<tkey, tvalue>::node_color)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(
-    red_black_tree<tkey, tvalue> *tree,
-    typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy):
-    binary_search_tree<tkey, tvalue>::insertion_template_method(tree, insertion_strategy)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data::iterator_data(
+    unsigned int depth,
+    typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const &viewed) noexcept:
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data(depth, viewed),
+    color(viewed.color)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(red_black_tree<tkey, tvalue> *, typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(
-    red_black_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::insertion_template_method(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(tree, insertion_strategy)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(red_black_tree<tkey, tvalue> *)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(
-    red_black_tree<tkey, tvalue> *tree,
-    typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy):
-    binary_search_tree<tkey, tvalue>::disposal_template_method(tree, disposal_strategy)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method::obtaining_template_method(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(red_black_tree<tkey, tvalue> *, typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue>::red_black_tree(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::disposal_template_method(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(tree, disposal_strategy)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept
+{
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::balance(inserted);
+    
+    static_cast<red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree)->fix_red_violation(inserted);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+    bool from_left_subtree,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *disposed) noexcept
+{
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::balance(parent, from_left_subtree, disposed);
+    
+    if (!is_red(disposed))
+    {
+        static_cast<red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree)->fix_black_deficit(parent, from_left_subtree);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::red_black_tree(
     allocator *allocator,
     logger *logger,
-    typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy insertion_strategy,
-    typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy)
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy,
+    tkey_comparer keys_comparer):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>(
+        new typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(this, insertion_strategy),
+        new typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(this),
+        new typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(this, disposal_strategy),
+        keys_comparer,
+        allocator,
+        logger)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue>::red_black_tree(allocator *, logger *, typename binary_search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_strategy, typename binary_search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_strategy)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue>::~red_black_tree() noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tforward_iterator,
+    typename>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::red_black_tree(
+    tforward_iterator first,
+    tforward_iterator last,
+    allocator *allocator,
+    logger *logger,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy insertion_strategy,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy disposal_strategy,
+    tkey_comparer keys_comparer):
+    red_black_tree(allocator, logger, insertion_strategy, disposal_strategy, keys_comparer)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue>::~red_black_tree() noexcept", "your code should be here...");
+    this->assign_sorted(first, last);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue>::red_black_tree(
-    red_black_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::~red_black_tree() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue>::red_black_tree(red_black_tree<tkey, tvalue> const &)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue> &red_black_tree<tkey, tvalue>::operator=(
-    red_black_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::red_black_tree(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other):
+    red_black_tree(other.get_allocator(), other.get_logger())
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue> &red_black_tree<tkey, tvalue>::operator=(red_black_tree<tkey, tvalue> const &)", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue>::red_black_tree(
-    red_black_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue>::red_black_tree(red_black_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(other);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-red_black_tree<tkey, tvalue> &red_black_tree<tkey, tvalue>::operator=(
-    red_black_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::red_black_tree(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept:
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>(std::move(other))
 {
-    throw not_implemented("template<typename tkey, typename tvalue> red_black_tree<tkey, tvalue> &red_black_tree<tkey, tvalue>::operator=(red_black_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+
 }
 
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept
+{
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(std::move(other));
+    
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_node_size() const noexcept
+{
+    return sizeof(typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::node);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::construct_node(
+    void *at,
+    tkey const &key,
+    tvalue const &value) const
+{
+    return new (at) typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::node(key, value);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::construct_iterator_data(
+    void *at,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *viewed,
+    unsigned int depth) const noexcept
+{
+    static_assert(sizeof(typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data) <= binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data_capacity, "the red-black iterator_data has to fit in an iterator");
+    
+    return new (at) typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data(depth, *static_cast<typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *>(viewed));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::initialize_balanced_node(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+    size_t,
+    size_t depth,
+    size_t complete_levels_count) const
+{
+    // every path passes complete_levels_count black nodes; the partially filled bottom level is red
+    static_cast<typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(target)->color = depth < complete_levels_count
+        ? node_color::BLACK
+        : node_color::RED;
+}
+
+
+// region split and join implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::split(
+    tkey const &key,
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &right)
+{
+    this->split_into(key, left, right);
+    
+    set_color(left.get_root(), node_color::BLACK);
+    set_color(right.get_root(), node_color::BLACK);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::join(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &left,
+    tkey const &key,
+    tvalue const &value,
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &right)
+{
+    this->join_from(left, key, value, right);
+    
+    set_color(this->get_root(), node_color::BLACK);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::dispose_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive)
+{
+    size_t disposed_count = this->dispose_range(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive);
+    
+    set_color(this->get_root(), node_color::BLACK);
+    
+    return disposed_count;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_subtrees(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const
+{
+    size_t joined_black_height;
+    
+    return join_with_black_heights(left, get_black_height(left), pivot, right, get_black_height(right), joined_black_height);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_with_black_heights(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    size_t left_black_height,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right,
+    size_t right_black_height,
+    size_t &joined_black_height) const
+{
+    // a red root can always be turned black, which keeps the joined parts valid and the cases below simple
+    if (is_red(left))
+    {
+        set_color(left, node_color::BLACK);
+        ++left_black_height;
+    }
+    
+    if (is_red(right))
+    {
+        set_color(right, node_color::BLACK);
+        ++right_black_height;
+    }
+    
+    if (left_black_height > right_black_height)
+    {
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *joined = join_right(left, pivot, right, left_black_height, right_black_height);
+        joined_black_height = left_black_height;
+        if (is_red(joined) && is_red(joined->right_subtree))
+        {
+            set_color(joined, node_color::BLACK);
+            ++joined_black_height;
+        }
+        
+        return joined;
+    }
+    
+    if (right_black_height > left_black_height)
+    {
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *joined = join_left(left, pivot, right, left_black_height, right_black_height);
+        joined_black_height = right_black_height;
+        if (is_red(joined) && is_red(joined->left_subtree))
+        {
+            set_color(joined, node_color::BLACK);
+            ++joined_black_height;
+        }
+        
+        return joined;
+    }
+    
+    set_color(pivot, node_color::RED);
+    joined_black_height = left_black_height;
+    
+    return link(pivot, left, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::settle_root(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) noexcept
+{
+    set_color(subtree_root, node_color::BLACK);
+    
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::settle_root(subtree_root);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_subtree(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    tkey const &key,
+    bool key_goes_left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right) const
+{
+    size_t left_black_height;
+    size_t right_black_height;
+    
+    split_with_black_heights(subtree_root, get_black_height(subtree_root), key, key_goes_left, left, left_black_height, right, right_black_height);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_last(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&last) const
+{
+    size_t rest_black_height;
+    
+    return split_last_with_black_heights(subtree_root, get_black_height(subtree_root), last, rest_black_height);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_around(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    tkey const &key,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right) const
+{
+    size_t left_black_height;
+    size_t right_black_height;
+    
+    return split_around_with_black_heights(subtree_root, get_black_height(subtree_root), key, left, left_black_height, right, right_black_height);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_with_black_heights(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    size_t black_height,
+    tkey const &key,
+    bool key_goes_left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+    size_t &left_black_height,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right,
+    size_t &right_black_height) const
+{
+    if (subtree_root == nullptr)
+    {
+        left = right = nullptr;
+        left_black_height = right_black_height = 0;
+        
+        return;
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_left = subtree_root->left_subtree;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_right = subtree_root->right_subtree;
+    size_t children_black_height = black_height - (is_red(subtree_root)
+        ? 0
+        : 1);
+    
+    for (typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree: { subtree_left, subtree_right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = nullptr;
+        }
+    }
+    
+    int comparison = this->_keys_comparer(subtree_root->key, key);
+    
+    if (comparison < 0 || (comparison == 0 && key_goes_left))
+    {
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right_part_left;
+        size_t right_part_left_black_height;
+        split_with_black_heights(subtree_right, children_black_height, key, key_goes_left, right_part_left, right_part_left_black_height, right, right_black_height);
+        left = join_with_black_heights(subtree_left, children_black_height, subtree_root, right_part_left, right_part_left_black_height, left_black_height);
+    }
+    else
+    {
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left_part_right;
+        size_t left_part_right_black_height;
+        split_with_black_heights(subtree_left, children_black_height, key, key_goes_left, left, left_black_height, left_part_right, left_part_right_black_height);
+        right = join_with_black_heights(left_part_right, left_part_right_black_height, subtree_root, subtree_right, children_black_height, right_black_height);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_last_with_black_heights(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    size_t black_height,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&last,
+    size_t &rest_black_height) const
+{
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_left = subtree_root->left_subtree;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_right = subtree_root->right_subtree;
+    size_t children_black_height = black_height - (is_red(subtree_root)
+        ? 0
+        : 1);
+    
+    for (typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree: { subtree_left, subtree_right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = nullptr;
+        }
+    }
+    
+    if (subtree_right == nullptr)
+    {
+        subtree_root->left_subtree = nullptr;
+        subtree_root->parent = nullptr;
+        this->update_augmentation(subtree_root);
+        last = subtree_root;
+        rest_black_height = children_black_height;
+        
+        return subtree_left;
+    }
+    
+    size_t right_rest_black_height;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right_rest = split_last_with_black_heights(subtree_right, children_black_height, last, right_rest_black_height);
+    
+    return join_with_black_heights(subtree_left, children_black_height, subtree_root, right_rest, right_rest_black_height, rest_black_height);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::split_around_with_black_heights(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root,
+    size_t black_height,
+    tkey const &key,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&left,
+    size_t &left_black_height,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&right,
+    size_t &right_black_height) const
+{
+    if (subtree_root == nullptr)
+    {
+        left = right = nullptr;
+        left_black_height = right_black_height = 0;
+        
+        return nullptr;
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_left = subtree_root->left_subtree;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_right = subtree_root->right_subtree;
+    size_t children_black_height = black_height - (is_red(subtree_root)
+        ? 0
+        : 1);
+    
+    for (typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree: { subtree_left, subtree_right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = nullptr;
+        }
+    }
+    
+    int comparison = this->_keys_comparer(subtree_root->key, key);
+    
+    if (comparison == 0)
+    {
+        left = subtree_left;
+        right = subtree_right;
+        left_black_height = right_black_height = children_black_height;
+        subtree_root->left_subtree = subtree_root->right_subtree = subtree_root->parent = nullptr;
+        this->update_augmentation(subtree_root);
+        
+        return subtree_root;
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *matched;
+    
+    if (comparison < 0)
+    {
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right_part_left;
+        size_t right_part_left_black_height;
+        matched = split_around_with_black_heights(subtree_right, children_black_height, key, right_part_left, right_part_left_black_height, right, right_black_height);
+        left = join_with_black_heights(subtree_left, children_black_height, subtree_root, right_part_left, right_part_left_black_height, left_black_height);
+    }
+    else
+    {
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left_part_right;
+        size_t left_part_right_black_height;
+        matched = split_around_with_black_heights(subtree_left, children_black_height, key, left, left_black_height, left_part_right, left_part_right_black_height);
+        right = join_with_black_heights(left_part_right, left_part_right_black_height, subtree_root, subtree_right, children_black_height, right_black_height);
+    }
+    
+    return matched;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_right(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right,
+    size_t left_black_height,
+    size_t right_black_height) const
+{
+    if (!is_red(left) && left_black_height == right_black_height)
+    {
+        set_color(pivot, node_color::RED);
+        
+        return link(pivot, left, right);
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *joined = join_right(left->right_subtree, pivot, right, left_black_height - (is_red(left) ? 0 : 1), right_black_height);
+    link(left, left->left_subtree, joined);
+    
+    if (!is_red(left) && is_red(joined) && is_red(joined->right_subtree))
+    {
+        set_color(joined->right_subtree, node_color::BLACK);
+        this->small_left_rotation(left, false);
+    }
+    
+    return left;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_left(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right,
+    size_t left_black_height,
+    size_t right_black_height) const
+{
+    if (!is_red(right) && left_black_height == right_black_height)
+    {
+        set_color(pivot, node_color::RED);
+        
+        return link(pivot, left, right);
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *joined = join_left(left, pivot, right->left_subtree, left_black_height, right_black_height - (is_red(right) ? 0 : 1));
+    link(right, joined, right->right_subtree);
+    
+    if (!is_red(right) && is_red(joined) && is_red(joined->left_subtree))
+    {
+        set_color(joined->left_subtree, node_color::BLACK);
+        this->small_right_rotation(right, false);
+    }
+    
+    return right;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::is_red(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept
+{
+    return subtree_root != nullptr && static_cast<typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *>(subtree_root)->color == node_color::RED;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_color(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+    node_color color) noexcept
+{
+    if (target != nullptr)
+    {
+        static_cast<typename red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *>(target)->color = color;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_black_height(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept
+{
+    size_t black_height = 0;
+    
+    for (; subtree_root != nullptr; subtree_root = subtree_root->left_subtree)
+    {
+        if (!is_red(subtree_root))
+        {
+            ++black_height;
+        }
+    }
+    
+    return black_height;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::fix_red_violation(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept
+{
+    while (is_red(target->parent))
+    {
+        // a red parent is never the root, so the grandparent exists
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent = target->parent;
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *grandparent = parent->parent;
+        bool parent_is_left = grandparent->left_subtree == parent;
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *uncle = parent_is_left
+            ? grandparent->right_subtree
+            : grandparent->left_subtree;
+        
+        if (is_red(uncle))
+        {
+            set_color(parent, node_color::BLACK);
+            set_color(uncle, node_color::BLACK);
+            set_color(grandparent, node_color::RED);
+            target = grandparent;
+            
+            continue;
+        }
+        
+        if (parent_is_left)
+        {
+            if (parent->right_subtree == target)
+            {
+                this->small_left_rotation(grandparent->left_subtree, false);
+                parent = target;
+            }
+            
+            set_color(parent, node_color::BLACK);
+            set_color(grandparent, node_color::RED);
+            this->small_right_rotation(this->get_link_to(grandparent), false);
+        }
+        else
+        {
+            if (parent->left_subtree == target)
+            {
+                this->small_right_rotation(grandparent->right_subtree, false);
+                parent = target;
+            }
+            
+            set_color(parent, node_color::BLACK);
+            set_color(grandparent, node_color::RED);
+            this->small_left_rotation(this->get_link_to(grandparent), false);
+        }
+        
+        break;
+    }
+    
+    set_color(this->get_root(), node_color::BLACK);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::fix_black_deficit(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+    bool from_left_subtree) noexcept
+{
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *current = parent == nullptr
+        ? this->get_root()
+        : (from_left_subtree
+            ? parent->left_subtree
+            : parent->right_subtree);
+    
+    while (parent != nullptr && !is_red(current))
+    {
+        // the side without the deficit has at least one black node on every path, so the sibling exists
+        if (from_left_subtree)
+        {
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *sibling = parent->right_subtree;
+            
+            if (is_red(sibling))
+            {
+                set_color(sibling, node_color::BLACK);
+                set_color(parent, node_color::RED);
+                this->small_left_rotation(this->get_link_to(parent), false);
+                sibling = parent->right_subtree;
+            }
+            
+            if (!is_red(sibling->left_subtree) && !is_red(sibling->right_subtree))
+            {
+                set_color(sibling, node_color::RED);
+                current = parent;
+                parent = current->parent;
+                from_left_subtree = parent != nullptr && parent->left_subtree == current;
+                
+                continue;
+            }
+            
+            if (!is_red(sibling->right_subtree))
+            {
+                set_color(sibling->left_subtree, node_color::BLACK);
+                set_color(sibling, node_color::RED);
+                this->small_right_rotation(parent->right_subtree, false);
+                sibling = parent->right_subtree;
+            }
+            
+            set_color(sibling, is_red(parent)
+                ? node_color::RED
+                : node_color::BLACK);
+            set_color(parent, node_color::BLACK);
+            set_color(sibling->right_subtree, node_color::BLACK);
+            this->small_left_rotation(this->get_link_to(parent), false);
+        }
+        else
+        {
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *sibling = parent->left_subtree;
+            
+            if (is_red(sibling))
+            {
+                set_color(sibling, node_color::BLACK);
+                set_color(parent, node_color::RED);
+                this->small_right_rotation(this->get_link_to(parent), false);
+                sibling = parent->left_subtree;
+            }
+            
+            if (!is_red(sibling->left_subtree) && !is_red(sibling->right_subtree))
+            {
+                set_color(sibling, node_color::RED);
+                current = parent;
+                parent = current->parent;
+                from_left_subtree = parent != nullptr && parent->left_subtree == current;
+                
+                continue;
+            }
+            
+            if (!is_red(sibling->left_subtree))
+            {
+                set_color(sibling->right_subtree, node_color::BLACK);
+                set_color(sibling, node_color::RED);
+                this->small_left_rotation(parent->left_subtree, false);
+                sibling = parent->left_subtree;
+            }
+            
+            set_color(sibling, is_red(parent)
+                ? node_color::RED
+                : node_color::BLACK);
+            set_color(parent, node_color::BLACK);
+            set_color(sibling->left_subtree, node_color::BLACK);
+            this->small_right_rotation(this->get_link_to(parent), false);
+        }
+        
+        current = this->get_root();
+        
+        break;
+    }
+    
+    set_color(current, node_color::BLACK);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::link(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) noexcept
+{
+    parent->left_subtree = left;
+    parent->right_subtree = right;
+    
+    for (typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree: { left, right })
+    {
+        if (subtree != nullptr)
+        {
+            subtree->parent = parent;
+        }
+    }
+    
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::update_augmentation(parent);
+    
+    return parent;
+}
+
+// endregion split and join implementation
+
+// region set operations implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::unite(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+    size_t threads_limit)
+{
+    this->combine_from(other, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_operation::unite, threads_limit);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::intersect(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+    size_t threads_limit)
+{
+    this->combine_from(other, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_operation::intersect, threads_limit);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::subtract(
+    red_black_tree<tkey, tvalue, tkey_comparer, taugmentation> &other,
+    size_t threads_limit)
+{
+    this->combine_from(other, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::set_operation::subtract, threads_limit);
+}
+
+// endregion set operations implementation
+
+// region invariants implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::check_invariants() const noexcept
+{
+    size_t black_height;
+    
+    return !is_red(this->get_root()) && (this->get_root() == nullptr || this->get_root()->parent == nullptr) && check_subtree(this->get_root(), black_height);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool red_black_tree<tkey, tvalue, tkey_comparer, taugmentation>::check_subtree(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root,
+    size_t &black_height) noexcept
+{
+    if (subtree_root == nullptr)
+    {
+        black_height = 0;
+        
+        return true;
+    }
+    
+    size_t left_black_height;
+    size_t right_black_height;
+    
+    if ((subtree_root->left_subtree != nullptr && subtree_root->left_subtree->parent != subtree_root) ||
+        (subtree_root->right_subtree != nullptr && subtree_root->right_subtree->parent != subtree_root) ||
+        (is_red(subtree_root) && (is_red(subtree_root->left_subtree) || is_red(subtree_root->right_subtree))) ||
+        !check_subtree(subtree_root->left_subtree, left_black_height) ||
+        !check_subtree(subtree_root->right_subtree, right_black_height) ||
+        left_black_height != right_black_height)
+    {
+        return false;
+    }
+    
+    black_height = left_black_height + (is_red(subtree_root)
+        ? 0
+        : 1);
+    
+    return true;
+}
+
+// endregion invariants implementation
+
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_RED_BLACK_TREE_H
@@ -1,9 +1,12 @@
 #include "gtest/gtest.h"
 #include <red_black_tree.h>
+#include <persistent_red_black_tree.h>
 #include <associative_container.h>
 #include <logger_builder.h>
 #include <client_logger_builder.h>
+#include <search_tree_checks.h>
 #include <iostream>
+#include <thread>
 
 logger *create_logger(
     std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -423,7 +426,7 @@ TEST(redBlackTreePositiveTests, test7)
     
     std::vector<typename red_black_tree<int, std::string>::iterator_data> expected_result =
         {
-            red_black_tree<int, std::string>::iterator_data(2, 2, "i", red_black_tree<int, std::string>::node_color::BLACK),
+            red_black_tree<int, std::string>::iterator_data(2, 2, "l", red_black_tree<int, std::string>::node_color::BLACK),
             red_black_tree<int, std::string>::iterator_data(1, 4, "j", red_black_tree<int, std::string>::node_color::RED),
             red_black_tree<int, std::string>::iterator_data(3, 5, "b", red_black_tree<int, std::string>::node_color::RED),
             red_black_tree<int, std::string>::iterator_data(2, 6, "a", red_black_tree<int, std::string>::node_color::BLACK),
@@ -618,6 +621,377 @@ TEST(redBlackTreePositiveTests, test11)
     delete logger;
 }
 
+TEST(redBlackTreePositiveTests, test12)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test12 started");
+    
+    persistent_red_black_tree<int, std::string, key_comparer> rb;
+    
+    rb.insert(6, "l");
+    rb.insert(8, "c");
+    rb.insert(15, "l");
+    rb.insert(11, "o");
+    
+    auto before = rb.get_snapshot();
+    
+    EXPECT_FALSE(rb.insert(8, "x"));
+    EXPECT_TRUE(rb.insert(2, "e"));
+    EXPECT_TRUE(rb.dispose(15));
+    EXPECT_FALSE(rb.dispose(100));
+    
+    auto after = rb.get_snapshot();
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> actual_before;
+    before.for_each([&actual_before](int const &key, std::string const &value)
+        {
+            actual_before.push_back({ key, value });
+            
+            return true;
+        });
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> actual_after;
+    after.for_each_between(0, 10, true, true, [&actual_after](int const &key, std::string const &value)
+        {
+            actual_after.push_back({ key, value });
+            
+            return true;
+        });
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> expected_before =
+        {
+            { 6, "l" },
+            { 8, "c" },
+            { 11, "o" },
+            { 15, "l" }
+        };
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> expected_after =
+        {
+            { 2, "e" },
+            { 6, "l" },
+            { 8, "x" }
+        };
+    
+    EXPECT_TRUE(compare_results(expected_before, actual_before));
+    EXPECT_TRUE(compare_results(expected_after, actual_after));
+    EXPECT_EQ(before.size(), 4);
+    EXPECT_EQ(after.size(), 4);
+    EXPECT_EQ(after.find(15), nullptr);
+    
+    logger->trace("redBlackTreePositiveTests.test12 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test13)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test13 started");
+    
+    persistent_red_black_tree<int, std::string, key_comparer> rb;
+    
+    // the writer keeps the entries count even after each completed step, so every consistent snapshot has an even size
+    std::thread writer([&rb]()
+        {
+            for (int i = 0; i < 10000; ++i)
+            {
+                rb.insert(2 * i, "a");
+                rb.insert(2 * i + 1, "b");
+                
+                if (i % 3 == 0)
+                {
+                    rb.dispose(2 * i);
+                    rb.dispose(2 * i + 1);
+                }
+            }
+        });
+    
+    size_t inconsistent_scans = 0;
+    
+    for (int scan = 0; scan < 200; ++scan)
+    {
+        auto snapshot = rb.get_snapshot();
+        
+        size_t visited = 0;
+        int previous_key = -1;
+        snapshot.for_each([&visited, &previous_key, &inconsistent_scans](int const &key, std::string const &value)
+            {
+                if (key <= previous_key)
+                {
+                    ++inconsistent_scans;
+                }
+                
+                previous_key = key;
+                ++visited;
+                
+                return true;
+            });
+        
+        if (visited != snapshot.size())
+        {
+            ++inconsistent_scans;
+        }
+    }
+    
+    writer.join();
+    
+    EXPECT_EQ(inconsistent_scans, 0);
+    EXPECT_EQ(rb.get_snapshot().size(), 2 * (10000 - 3334));
+    
+    logger->trace("redBlackTreePositiveTests.test13 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test14)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test14 started");
+    
+    auto descending_order = [](int const &first, int const &second) { return second < first ? -1 : (first < second ? 1 : 0); };
+    
+    // the default comparer type converts from an arbitrary callable, as the std::function based api did
+    persistent_red_black_tree<int, std::string> ascending;
+    persistent_red_black_tree<int, std::string, type_erased_keys_comparer<int>> descending(descending_order);
+    persistent_red_black_tree<int, std::string> converted(descending_order);
+    
+    for (int key: { 5, 1, 9, 3, 7 })
+    {
+        ascending.insert(key, std::to_string(key));
+        descending.insert(key, std::to_string(key));
+        converted.insert(key, std::to_string(key));
+    }
+    
+    std::vector<int> ascending_keys;
+    ascending.get_snapshot().for_each([&ascending_keys](int const &key, std::string const &value)
+        {
+            ascending_keys.push_back(key);
+            
+            return true;
+        });
+    
+    std::vector<int> descending_keys;
+    descending.get_snapshot().for_each([&descending_keys](int const &key, std::string const &value)
+        {
+            descending_keys.push_back(key);
+            
+            return true;
+        });
+    
+    std::vector<int> converted_keys;
+    converted.get_snapshot().for_each([&converted_keys](int const &key, std::string const &value)
+        {
+            converted_keys.push_back(key);
+            
+            return true;
+        });
+    
+    EXPECT_EQ(ascending_keys, std::vector<int>({ 1, 3, 5, 7, 9 }));
+    EXPECT_EQ(descending_keys, std::vector<int>({ 9, 7, 5, 3, 1 }));
+    EXPECT_EQ(converted_keys, descending_keys);
+    EXPECT_NE(descending.get_snapshot().find(3), nullptr);
+    
+    logger->trace("redBlackTreePositiveTests.test14 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test15)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test15 started");
+    
+    check_bulk_load_and_updates<red_black_tree>(logger);
+    
+    logger->trace("redBlackTreePositiveTests.test15 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test16)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test16 started");
+    
+    check_ascending_updates<red_black_tree>(logger);
+    
+    logger->trace("redBlackTreePositiveTests.test16 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test17)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test17 started");
+    
+    check_insert_many<red_black_tree>(logger);
+    
+    logger->trace("redBlackTreePositiveTests.test17 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test18)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test18 started");
+    
+    check_dispose_many<red_black_tree>(logger);
+    
+    logger->trace("redBlackTreePositiveTests.test18 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test19)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test19 started");
+    
+    // every part of a split and every join keeps a black root and equal black heights
+    check_split_and_join<red_black_tree>(logger);
+    
+    logger->trace("redBlackTreePositiveTests.test19 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test20)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test20 started");
+    
+    check_set_operations<red_black_tree>(logger);
+    
+    logger->trace("redBlackTreePositiveTests.test20 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test21)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test21 started");
+    
+    check_rank_and_select<red_black_tree>(logger);
+    
+    logger->trace("redBlackTreePositiveTests.test21 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test22)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test22 started");
+    
+    check_range_aggregates<red_black_tree>(logger);
+    
+    logger->trace("redBlackTreePositiveTests.test22 finished");
+    
+    delete logger;
+}
+
+TEST(redBlackTreePositiveTests, test23)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "red_black_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("redBlackTreePositiveTests.test23 started");
+    
+    red_black_tree<int, std::string> tree(nullptr, logger);
+    
+    check_range_queries(tree);
+    
+    logger->trace("redBlackTreePositiveTests.test23 finished");
+    
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
@@ -5,25 +5,29 @@
 
 template<
     typename tkey,
-    typename tvalue>
+    typename tvalue,
+    typename tkey_comparer = default_keys_comparer<tkey>,
+    typename taugmentation = no_augmentation>
 class scapegoat_tree final:
-    public binary_search_tree<tkey, tvalue>
+    public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>
 {
 
 private:
     
     struct scapegoat_node final:
-        binary_search_tree<tkey, tvalue>::node
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node
     {
         
-        // TODO: think about it!
+        using binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node::node;
+        
+        size_t subtree_size = 1;
         
     };
 
 public:
     
     struct iterator_data final:
-        public binary_search_tree<tkey, tvalue>::iterator_data
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data
     {
     
     public:
@@ -38,177 +42,596 @@ public:
 private:
     
     class insertion_template_method final:
-        public binary_search_tree<tkey, tvalue>::insertion_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method
     {
     
     public:
         
         explicit insertion_template_method(
-            scapegoat_tree<tkey, tvalue> *tree);
+            scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
     
     private:
         
-        // TODO: think about it!
+        // counts the new node in the sizes up to the root and rebuilds the lowest subtree on the way
+        // a child of which now holds more than alpha of its nodes
+        void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept override;
         
     };
     
     class obtaining_template_method final:
-        public binary_search_tree<tkey, tvalue>::obtaining_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method
     {
     
     public:
         
         explicit obtaining_template_method(
-            scapegoat_tree<tkey, tvalue> *tree);
+            scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
         
         // TODO: think about it!
         
     };
     
     class disposal_template_method final:
-        public binary_search_tree<tkey, tvalue>::disposal_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method
     {
     
     public:
         
         explicit disposal_template_method(
-            scapegoat_tree<tkey, tvalue> *tree);
+            scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
+    
+    private:
         
-        // TODO: think about it!
+        // takes the in-order successor of a target with both subtrees
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *select_node_to_unlink(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept override;
+        
+        // uncounts the node in the sizes up to the root and rebuilds the whole tree
+        // once it holds less than alpha of the largest size it had since the last such rebuild
+        void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+            bool,
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *) noexcept override;
         
     };
 
+private:
+    
+    double _alpha;
+    
+    size_t _max_size;
+
 public:
     
     explicit scapegoat_tree(
         allocator *allocator = nullptr,
         logger *logger = nullptr,
-        double alpha = 0.5);
+        double alpha = 0.5,
+        tkey_comparer keys_comparer = tkey_comparer());
+    
+    template<
+        typename tforward_iterator,
+        typename = typename std::iterator_traits<tforward_iterator>::iterator_category>
+    explicit scapegoat_tree(
+        tforward_iterator first,
+        tforward_iterator last,
+        allocator *allocator = nullptr,
+        logger *logger = nullptr,
+        double alpha = 0.5,
+        tkey_comparer keys_comparer = tkey_comparer());
 
 public:
     
     ~scapegoat_tree() noexcept final;
     
     scapegoat_tree(
-        scapegoat_tree<tkey, tvalue> const &other);
+        scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
-    scapegoat_tree<tkey, tvalue> &operator=(
-        scapegoat_tree<tkey, tvalue> const &other);
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
     scapegoat_tree(
-        scapegoat_tree<tkey, tvalue> &&other) noexcept;
+        scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
     
-    scapegoat_tree<tkey, tvalue> &operator=(
-        scapegoat_tree<tkey, tvalue> &&other) noexcept;
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
 
 public:
     
     void setup_alpha(
         double alpha);
+
+private:
+    
+    size_t get_node_size() const noexcept override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *construct_node(
+        void *at,
+        tkey const &key,
+        tvalue const &value) const override;
+    
+    void initialize_balanced_node(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+        size_t,
+        size_t,
+        size_t) const override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *join_subtrees(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const override;
+    
+    void settle_root(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) noexcept override;
+
+private:
+    
+    static size_t get_subtree_size(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept;
+    
+    bool is_alpha_weight_unbalanced(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *target) const noexcept;
+    
+    // relinks the subtree into a perfectly balanced one in O(its size), without allocations
+    void rebuild(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) noexcept;
+    
+    // takes count nodes off an in-order list chained through right_subtree and links them into a balanced subtree
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *link_list_balanced(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&list,
+        size_t count) const noexcept;
+
+public:
+    
+    // walks the whole tree in O(n): every stored size is exact and the children link back to their parents
+    bool check_invariants() const noexcept;
+
+private:
+    
+    static bool check_subtree(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept;
     
 };
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue>::iterator_data::iterator_data(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data::iterator_data(
     unsigned int depth,
     tkey const &key,
     tvalue const &value):
-    binary_search_tree<tkey, tvalue>::iterator_data(depth, key, value)
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data(depth, key, value)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::insertion_template_method(
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(tree, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy::throw_an_exception)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method::obtaining_template_method(
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue>::iterator_data::iterator_data(unsigned int, tkey const &, tvalue const &)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(
-    scapegoat_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::disposal_template_method(
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(tree, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(scapegoat_tree<tkey, tvalue> *)", "your code should be here...");
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept
+{
+    auto *tree = static_cast<scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree);
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *scapegoat = nullptr;
+    
+    for (auto *current = inserted->parent; current != nullptr; current = current->parent)
+    {
+        ++static_cast<scapegoat_node *>(current)->subtree_size;
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::update_augmentation(current);
+        
+        if (scapegoat == nullptr && tree->is_alpha_weight_unbalanced(current))
+        {
+            scapegoat = current;
+        }
+    }
+    
+    if (scapegoat != nullptr)
+    {
+        tree->rebuild(scapegoat);
+    }
+    
+    tree->_max_size = std::max(tree->_max_size, get_subtree_size(tree->get_root()));
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(
-    scapegoat_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::select_node_to_unlink(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(scapegoat_tree<tkey, tvalue> *)", "your code should be here...");
+    if (target->left_subtree == nullptr || target->right_subtree == nullptr)
+    {
+        return target;
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *successor = target->right_subtree;
+    while (successor->left_subtree != nullptr)
+    {
+        successor = successor->left_subtree;
+    }
+    
+    return successor;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(
-    scapegoat_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent,
+    bool,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(scapegoat_tree<tkey, tvalue> *)", "your code should be here...");
+    auto *tree = static_cast<scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree);
+    
+    for (auto *current = parent; current != nullptr; current = current->parent)
+    {
+        --static_cast<scapegoat_node *>(current)->subtree_size;
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::update_augmentation(current);
+    }
+    
+    size_t size = get_subtree_size(tree->get_root());
+    
+    if (size < tree->_alpha * tree->_max_size)
+    {
+        if (size != 0)
+        {
+            tree->rebuild(tree->get_root());
+        }
+        
+        tree->_max_size = size;
+    }
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue>::scapegoat_tree(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::scapegoat_tree(
     allocator *allocator,
     logger *logger,
-    double alpha)
+    double alpha,
+    tkey_comparer keys_comparer):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>(
+        new typename scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(this),
+        new typename scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(this),
+        new typename scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(this),
+        keys_comparer,
+        allocator,
+        logger),
+    _max_size(0)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue>::scapegoat_tree(allocator *, logger *, double)", "your code should be here...");
+    setup_alpha(alpha);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue>::~scapegoat_tree() noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tforward_iterator,
+    typename>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::scapegoat_tree(
+    tforward_iterator first,
+    tforward_iterator last,
+    allocator *allocator,
+    logger *logger,
+    double alpha,
+    tkey_comparer keys_comparer):
+    scapegoat_tree(allocator, logger, alpha, keys_comparer)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue>::~scapegoat_tree() noexcept", "your code should be here...");
+    this->assign_sorted(first, last);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue>::scapegoat_tree(
-    scapegoat_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::~scapegoat_tree() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue>::scapegoat_tree(scapegoat_tree<tkey, tvalue> const &)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue> &scapegoat_tree<tkey, tvalue>::operator=(
-    scapegoat_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::scapegoat_tree(
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other):
+    scapegoat_tree(other.get_allocator(), other.get_logger(), other._alpha)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue> &scapegoat_tree<tkey, tvalue>::operator=(scapegoat_tree<tkey, tvalue> const &)", "your code should be here...");
+    operator=(other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue>::scapegoat_tree(
-    scapegoat_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> &scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue>::scapegoat_tree(scapegoat_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(other);
+    _alpha = other._alpha;
+    _max_size = get_subtree_size(this->get_root());
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-scapegoat_tree<tkey, tvalue> &scapegoat_tree<tkey, tvalue>::operator=(
-    scapegoat_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::scapegoat_tree(
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept:
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>(std::move(other)),
+    _alpha(other._alpha),
+    _max_size(other._max_size)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> scapegoat_tree<tkey, tvalue> &scapegoat_tree<tkey, tvalue>::operator=(scapegoat_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    other._max_size = 0;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void scapegoat_tree<tkey, tvalue>::setup_alpha(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> &scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept
+{
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(std::move(other));
+    std::swap(_alpha, other._alpha);
+    std::swap(_max_size, other._max_size);
+    
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::setup_alpha(
     double alpha)
 {
-    throw not_implemented("", "your code should be here...");
+    // below one half no tree with two nodes is balanced, at one the subtrees are never rebuilt
+    if (!(alpha >= 0.5 && alpha < 1))
+    {
+        throw std::invalid_argument("scapegoat_tree: alpha has to be in [0.5, 1)");
+    }
+    
+    _alpha = alpha;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_node_size() const noexcept
+{
+    return sizeof(typename scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::scapegoat_node);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::construct_node(
+    void *at,
+    tkey const &key,
+    tvalue const &value) const
+{
+    return new (at) typename scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::scapegoat_node(key, value);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::initialize_balanced_node(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+    size_t,
+    size_t,
+    size_t) const
+{
+    static_cast<scapegoat_node *>(target)->subtree_size = 1 + get_subtree_size(target->left_subtree) + get_subtree_size(target->right_subtree);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_subtrees(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *right) const
+{
+    static_cast<scapegoat_node *>(pivot)->subtree_size = 1 + get_subtree_size(left) + get_subtree_size(right);
+    
+    return binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::join_subtrees(left, pivot, right);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::settle_root(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) noexcept
+{
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::settle_root(subtree_root);
+    _max_size = get_subtree_size(subtree_root);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_subtree_size(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept
+{
+    return subtree_root == nullptr
+        ? 0
+        : static_cast<scapegoat_node const *>(subtree_root)->subtree_size;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::is_alpha_weight_unbalanced(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *target) const noexcept
+{
+    double limit = _alpha * get_subtree_size(target);
+    
+    return get_subtree_size(target->left_subtree) > limit || get_subtree_size(target->right_subtree) > limit;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::rebuild(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root) noexcept
+{
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&link = this->get_link_to(subtree_root);
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent = subtree_root->parent;
+    size_t count = get_subtree_size(subtree_root);
+    
+    // right rotations at the head of the rest flatten the subtree into the in-order list
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *list = nullptr;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node **tail = &list;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *rest = subtree_root;
+    
+    while (rest != nullptr)
+    {
+        if (rest->left_subtree != nullptr)
+        {
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left = rest->left_subtree;
+            
+            rest->left_subtree = left->right_subtree;
+            left->right_subtree = rest;
+            rest = left;
+        }
+        else
+        {
+            *tail = rest;
+            tail = &rest->right_subtree;
+            rest = rest->right_subtree;
+        }
+    }
+    
+    link = link_list_balanced(list, count);
+    link->parent = parent;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::link_list_balanced(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *&list,
+    size_t count) const noexcept
+{
+    if (count == 0)
+    {
+        return nullptr;
+    }
+    
+    size_t left_count = count / 2;
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *left = link_list_balanced(list, left_count);
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *pivot = list;
+    
+    list = list->right_subtree;
+    
+    return join_subtrees(left, pivot, link_list_balanced(list, count - left_count - 1));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::check_invariants() const noexcept
+{
+    return (this->get_root() == nullptr || this->get_root()->parent == nullptr) && check_subtree(this->get_root());
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+bool scapegoat_tree<tkey, tvalue, tkey_comparer, taugmentation>::check_subtree(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *subtree_root) noexcept
+{
+    if (subtree_root == nullptr)
+    {
+        return true;
+    }
+    
+    return (subtree_root->left_subtree == nullptr || subtree_root->left_subtree->parent == subtree_root) &&
+        (subtree_root->right_subtree == nullptr || subtree_root->right_subtree->parent == subtree_root) &&
+        check_subtree(subtree_root->left_subtree) &&
+        check_subtree(subtree_root->right_subtree) &&
+        get_subtree_size(subtree_root) == 1 + get_subtree_size(subtree_root->left_subtree) + get_subtree_size(subtree_root->right_subtree);
 }
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SCAPEGOAT_TREE_H
\ No newline at end of file
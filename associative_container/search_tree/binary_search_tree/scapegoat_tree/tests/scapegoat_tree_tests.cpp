@@ -4,6 +4,8 @@
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <cmath>
+#include <stdexcept>
 
 logger *create_logger(
     std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -568,6 +570,57 @@ TEST(scapegoatTreePositiveTests, test10)
     delete logger;
 }
 
+TEST(scapegoatTreePositiveTests, test11)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "scapegoat_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        });
+    
+    logger->trace("scapegoatTreePositiveTests.test11 started");
+    
+    // ascending insertions keep rebuilding the scapegoats, so the height stays logarithmic in the alpha base
+    scapegoat_tree<int, std::string> subject(nullptr, logger, 0.7);
+    
+    for (int key = 0; key < 1024; ++key)
+    {
+        subject.insert(key, std::to_string(key));
+        ASSERT_TRUE(subject.check_invariants());
+    }
+    
+    unsigned int height = 0;
+    for (auto it = subject.begin_prefix(); it != subject.end_prefix(); ++it)
+    {
+        height = std::max(height, it.depth());
+    }
+    
+    EXPECT_LE(height, static_cast<unsigned int>(std::log(1024) / std::log(1 / 0.7)) + 1);
+    
+    for (int key = 0; key < 1000; ++key)
+    {
+        EXPECT_EQ(subject.dispose(key), std::to_string(key));
+        ASSERT_TRUE(subject.check_invariants());
+    }
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> actual_result = subject.obtain_between(0, 1024, true, false);
+    std::vector<associative_container<int, std::string>::key_value_pair> expected_result;
+    for (int key = 1000; key < 1024; ++key)
+    {
+        expected_result.push_back({ key, std::to_string(key) });
+    }
+    
+    EXPECT_TRUE(compare_results(expected_result, actual_result));
+    EXPECT_THROW((scapegoat_tree<int, std::string>(nullptr, logger, 0.4)), std::invalid_argument);
+    EXPECT_THROW((scapegoat_tree<int, std::string>(nullptr, logger, 1)), std::invalid_argument);
+    
+    logger->trace("scapegoatTreePositiveTests.test11 finished");
+    
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
@@ -5,17 +5,21 @@
 
 template<
     typename tkey,
-    typename tvalue>
+    typename tvalue,
+    typename tkey_comparer = default_keys_comparer<tkey>,
+    typename taugmentation = no_augmentation>
 class splay_tree final:
-    public binary_search_tree<tkey, tvalue>
+    public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>
 {
 
 private:
     
     struct splay_node final:
-        binary_search_tree<tkey, tvalue>::node
+        binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node
     {
         
+        using binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node::node;
+        
         // TODO: think about it!
         
     };
@@ -23,7 +27,7 @@ private:
 public:
     
     struct iterator_data final:
-        public binary_search_tree<tkey, tvalue>::iterator_data
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data
     {
     
         explicit iterator_data(
@@ -36,43 +40,53 @@ public:
 private:
     
     class insertion_template_method final:
-        public binary_search_tree<tkey, tvalue>::insertion_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method
     {
     
     public:
         
         explicit insertion_template_method(
-            splay_tree<tkey, tvalue> *tree);
+            splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
     
     private:
         
-        // TODO: think about it!
+        void balance(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept override;
         
     };
     
     class obtaining_template_method final:
-        public binary_search_tree<tkey, tvalue>::obtaining_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method
     {
     
     public:
         
         explicit obtaining_template_method(
-            splay_tree<tkey, tvalue> *tree);
+            splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
+    
+    public:
         
-        // TODO: think about it!
+        // splays the node holding the key or, when there is none, the last node visited
+        tvalue const &obtain(
+            tkey const &key) override;
         
     };
     
     class disposal_template_method final:
-        public binary_search_tree<tkey, tvalue>::disposal_template_method
+        public binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method
     {
     
     public:
         
         explicit disposal_template_method(
-            splay_tree<tkey, tvalue> *tree);
+            splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree);
+    
+    private:
         
-        // TODO: think about it!
+        // splays target to the root and its in-order predecessor right below it, so unlinking the predecessor
+        // joins the two subtrees of target the way a splay tree does
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *select_node_to_unlink(
+            typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept override;
         
     };
 
@@ -80,117 +94,349 @@ public:
     
     explicit splay_tree(
         allocator *allocator = nullptr,
-        logger *logger = nullptr);
+        logger *logger = nullptr,
+        tkey_comparer keys_comparer = tkey_comparer());
+    
+    template<
+        typename tforward_iterator,
+        typename = typename std::iterator_traits<tforward_iterator>::iterator_category>
+    explicit splay_tree(
+        tforward_iterator first,
+        tforward_iterator last,
+        allocator *allocator = nullptr,
+        logger *logger = nullptr,
+        tkey_comparer keys_comparer = tkey_comparer());
 
 public:
     
     ~splay_tree() noexcept final;
     
     splay_tree(
-        splay_tree<tkey, tvalue> const &other);
+        splay_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
-    splay_tree<tkey, tvalue> &operator=(
-        splay_tree<tkey, tvalue> const &other);
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        splay_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other);
     
     splay_tree(
-        splay_tree<tkey, tvalue> &&other) noexcept;
+        splay_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
     
-    splay_tree<tkey, tvalue> &operator=(
-        splay_tree<tkey, tvalue> &&other) noexcept;
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> &operator=(
+        splay_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept;
+
+private:
+    
+    size_t get_node_size() const noexcept override;
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *construct_node(
+        void *at,
+        tkey const &key,
+        tvalue const &value) const override;
+    
+    // rotates target up until its parent is until: two levels at a time, by zig-zig or zig-zag steps,
+    // and by a single rotation when only one level is left
+    void splay(
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *until = nullptr) noexcept;
     
 };
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue>::iterator_data::iterator_data(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data::iterator_data(
     unsigned int depth,
     tkey const &key,
     tvalue const &value):
-    binary_search_tree<tkey, tvalue>::iterator_data(depth, key, value)
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::iterator_data(depth, key, value)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::insertion_template_method(
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(tree, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_of_existent_key_attempt_strategy::throw_an_exception)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue>::iterator_data::iterator_data(unsigned int, tkey const &, tvalue const &)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(
-    splay_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method::obtaining_template_method(
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(tree)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue>::insertion_template_method::insertion_template_method(splay_tree<tkey, tvalue> *)", "your code should be here...");
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::disposal_template_method(
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *tree):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(tree, binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_of_nonexistent_key_attempt_strategy::throw_an_exception)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method::balance(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *inserted) noexcept
+{
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::update_augmentations_upwards(inserted->parent);
+    static_cast<splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree)->splay(inserted);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+tvalue const &splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method::obtain(
+    tkey const &key)
+{
+    auto *tree = static_cast<splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree);
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *current = tree->get_root();
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *last_visited = nullptr;
+    
+    while (current != nullptr)
+    {
+        int comparison = tree->_keys_comparer(key, current->key);
+        
+        if (comparison == 0)
+        {
+            tree->splay(current);
+            
+            return current->value;
+        }
+        
+        last_visited = current;
+        current = comparison < 0
+            ? current->left_subtree
+            : current->right_subtree;
+    }
+    
+    if (last_visited != nullptr)
+    {
+        tree->splay(last_visited);
+    }
+    
+    throw typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_of_nonexistent_key_attempt_exception(key);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(
-    splay_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method::select_node_to_unlink(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue>::obtaining_template_method::obtaining_template_method(splay_tree<tkey, tvalue> *)", "your code should be here...");
+    auto *tree = static_cast<splay_tree<tkey, tvalue, tkey_comparer, taugmentation> *>(this->_tree);
+    
+    tree->splay(target);
+    
+    if (target->left_subtree == nullptr || target->right_subtree == nullptr)
+    {
+        return target;
+    }
+    
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *predecessor = target->left_subtree;
+    while (predecessor->right_subtree != nullptr)
+    {
+        predecessor = predecessor->right_subtree;
+    }
+    
+    tree->splay(predecessor, target);
+    
+    return predecessor;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(
-    splay_tree<tkey, tvalue> *tree)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::splay_tree(
+    allocator *allocator,
+    logger *logger,
+    tkey_comparer keys_comparer):
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>(
+        new typename splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::insertion_template_method(this),
+        new typename splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::obtaining_template_method(this),
+        new typename splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::disposal_template_method(this),
+        keys_comparer,
+        allocator,
+        logger)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue>::disposal_template_method::disposal_template_method(splay_tree<tkey, tvalue> *)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue>::splay_tree(
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+template<
+    typename tforward_iterator,
+    typename>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::splay_tree(
+    tforward_iterator first,
+    tforward_iterator last,
     allocator *allocator,
-    logger *logger)
+    logger *logger,
+    tkey_comparer keys_comparer):
+    splay_tree(allocator, logger, keys_comparer)
+{
+    this->assign_sorted(first, last);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::~splay_tree() noexcept
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::splay_tree(
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other):
+    splay_tree(other.get_allocator(), other.get_logger())
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue>::splay_tree(allocator *, logger *)", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(other);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue>::~splay_tree() noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation> &splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue>::~splay_tree() noexcept", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(other);
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue>::splay_tree(
-    splay_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::splay_tree(
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept:
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>(std::move(other))
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue>::splay_tree(splay_tree<tkey, tvalue> const &)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue> &splay_tree<tkey, tvalue>::operator=(
-    splay_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+splay_tree<tkey, tvalue, tkey_comparer, taugmentation> &splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(
+    splay_tree<tkey, tvalue, tkey_comparer, taugmentation> &&other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue> &splay_tree<tkey, tvalue>::operator=(splay_tree<tkey, tvalue> const &)", "your code should be here...");
+    binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::operator=(std::move(other));
+    
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue>::splay_tree(
-    splay_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+size_t splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::get_node_size() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue>::splay_tree(splay_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    return sizeof(typename splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::splay_node);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-splay_tree<tkey, tvalue> &splay_tree<tkey, tvalue>::operator=(
-    splay_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::construct_node(
+    void *at,
+    tkey const &key,
+    tvalue const &value) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue> splay_tree<tkey, tvalue> &splay_tree<tkey, tvalue>::operator=(splay_tree<tkey, tvalue> &&) noexcept", "your code should be here...");
+    return new (at) typename splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::splay_node(key, value);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tkey_comparer,
+    typename taugmentation>
+void splay_tree<tkey, tvalue, tkey_comparer, taugmentation>::splay(
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *target,
+    typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node const *until) noexcept
+{
+    // lifts the child of subtree_root on the given side above it
+    auto rotate = [this](typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *subtree_root, bool lift_left)
+    {
+        if (lift_left)
+        {
+            this->small_right_rotation(this->get_link_to(subtree_root), false);
+        }
+        else
+        {
+            this->small_left_rotation(this->get_link_to(subtree_root), false);
+        }
+    };
+    
+    while (target->parent != until)
+    {
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *parent = target->parent;
+        typename binary_search_tree<tkey, tvalue, tkey_comparer, taugmentation>::node *grandparent = parent->parent;
+        bool target_is_left = parent->left_subtree == target;
+        
+        if (grandparent == until)
+        {
+            rotate(parent, target_is_left);
+            
+            break;
+        }
+        
+        bool parent_is_left = grandparent->left_subtree == parent;
+        
+        if (target_is_left == parent_is_left)
+        {
+            rotate(grandparent, parent_is_left);
+            rotate(parent, target_is_left);
+        }
+        else
+        {
+            rotate(parent, target_is_left);
+            rotate(grandparent, parent_is_left);
+        }
+    }
 }
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SPLAY_TREE_H
\ No newline at end of file
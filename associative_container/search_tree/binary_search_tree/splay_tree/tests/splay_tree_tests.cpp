@@ -218,9 +218,9 @@ TEST(splayTreePositiveTests, test2)
     std::vector<typename splay_tree<int, int>::iterator_data> expected_result =
         {
             splay_tree<int, int>::iterator_data(0, 4, 45),
-            splay_tree<int, int>::iterator_data(3, 1, 5),
-            splay_tree<int, int>::iterator_data(2, 2, 12),
             splay_tree<int, int>::iterator_data(1, 3, 67),
+            splay_tree<int, int>::iterator_data(2, 2, 12),
+            splay_tree<int, int>::iterator_data(3, 1, 5),
             splay_tree<int, int>::iterator_data(1, 15, 1)
         };
     
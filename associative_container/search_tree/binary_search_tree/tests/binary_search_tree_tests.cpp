@@ -2,7 +2,10 @@
 #include <binary_search_tree.h>
 #include <logger_builder.h>
 #include <client_logger_builder.h>
+#include <search_tree_checks.h>
 #include <iostream>
+#include <algorithm>
+#include <random>
 
 logger *create_logger(
     std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -599,6 +602,253 @@ TEST(binarySearchTreePositiveTests, test11)
     delete logger;
 }
 
+class stackless_traversal_probe final:
+    public binary_search_tree<int, std::string>
+{
+
+public:
+    
+    using binary_search_tree<int, std::string>::binary_search_tree;
+    
+    using binary_search_tree<int, std::string>::node;
+    
+    using binary_search_tree<int, std::string>::get_root;
+    
+    using binary_search_tree<int, std::string>::prefix_first;
+    
+    using binary_search_tree<int, std::string>::prefix_next;
+    
+    using binary_search_tree<int, std::string>::infix_first;
+    
+    using binary_search_tree<int, std::string>::infix_next;
+    
+    using binary_search_tree<int, std::string>::postfix_first;
+    
+    using binary_search_tree<int, std::string>::postfix_next;
+    
+    using binary_search_tree<int, std::string>::depth_of;
+    
+    // the root starts a prefix traversal in either direction, at the depth it already has
+    static node *prefix_first_counted(
+        node *subtree_root,
+        bool,
+        unsigned int *)
+    {
+        return prefix_first(subtree_root);
+    }
+    
+};
+
+std::vector<std::pair<int, unsigned int>> traverse(
+    stackless_traversal_probe::node *(*first)(stackless_traversal_probe::node *, bool, unsigned int *),
+    stackless_traversal_probe::node *(*next)(stackless_traversal_probe::node *, bool, unsigned int *),
+    stackless_traversal_probe::node *root,
+    bool mirrored)
+{
+    std::vector<std::pair<int, unsigned int>> visited;
+    unsigned int depth = 0;
+    
+    for (auto *current = first(root, mirrored, &depth); current != nullptr; current = next(current, mirrored, &depth))
+    {
+        // the depth counted along the steps has to agree with the one recounted from the root
+        EXPECT_EQ(depth, stackless_traversal_probe::depth_of(current));
+        visited.emplace_back(current->key, depth);
+    }
+    
+    return visited;
+}
+
+TEST(binarySearchTreePositiveTests, test12)
+{
+    using node = stackless_traversal_probe::node;
+    
+    std::vector<node> nodes;
+    nodes.reserve(6);
+    for (int key: { 5, 3, 8, 1, 4, 9 })
+    {
+        nodes.emplace_back(key, std::to_string(key));
+    }
+    
+    auto link = [](node *parent, node *left, node *right)
+    {
+        parent->left_subtree = left;
+        parent->right_subtree = right;
+        for (auto *child: { left, right })
+        {
+            if (child != nullptr)
+            {
+                child->parent = parent;
+            }
+        }
+    };
+    
+    link(&nodes[0], &nodes[1], &nodes[2]);
+    link(&nodes[1], &nodes[3], &nodes[4]);
+    link(&nodes[2], nullptr, &nodes[5]);
+    
+    std::vector<std::pair<int, unsigned int>> expected_prefix = { { 5, 0 }, { 3, 1 }, { 1, 2 }, { 4, 2 }, { 8, 1 }, { 9, 2 } };
+    std::vector<std::pair<int, unsigned int>> expected_infix = { { 1, 2 }, { 3, 1 }, { 4, 2 }, { 5, 0 }, { 8, 1 }, { 9, 2 } };
+    std::vector<std::pair<int, unsigned int>> expected_postfix = { { 1, 2 }, { 4, 2 }, { 3, 1 }, { 9, 2 }, { 8, 1 }, { 5, 0 } };
+    std::vector<std::pair<int, unsigned int>> expected_mirrored_prefix = { { 5, 0 }, { 8, 1 }, { 9, 2 }, { 3, 1 }, { 4, 2 }, { 1, 2 } };
+    std::vector<std::pair<int, unsigned int>> expected_mirrored_infix(expected_infix.rbegin(), expected_infix.rend());
+    std::vector<std::pair<int, unsigned int>> expected_mirrored_postfix = { { 9, 2 }, { 8, 1 }, { 4, 2 }, { 1, 2 }, { 3, 1 }, { 5, 0 } };
+    
+    EXPECT_EQ(traverse(stackless_traversal_probe::prefix_first_counted, stackless_traversal_probe::prefix_next, &nodes[0], false), expected_prefix);
+    EXPECT_EQ(traverse(stackless_traversal_probe::infix_first, stackless_traversal_probe::infix_next, &nodes[0], false), expected_infix);
+    EXPECT_EQ(traverse(stackless_traversal_probe::postfix_first, stackless_traversal_probe::postfix_next, &nodes[0], false), expected_postfix);
+    EXPECT_EQ(traverse(stackless_traversal_probe::prefix_first_counted, stackless_traversal_probe::prefix_next, &nodes[0], true), expected_mirrored_prefix);
+    EXPECT_EQ(traverse(stackless_traversal_probe::infix_first, stackless_traversal_probe::infix_next, &nodes[0], true), expected_mirrored_infix);
+    EXPECT_EQ(traverse(stackless_traversal_probe::postfix_first, stackless_traversal_probe::postfix_next, &nodes[0], true), expected_mirrored_postfix);
+    EXPECT_TRUE(traverse(stackless_traversal_probe::infix_first, stackless_traversal_probe::infix_next, nullptr, false).empty());
+}
+
+template<
+    typename titerator>
+std::vector<std::pair<int, unsigned int>> walk(
+    titerator begin,
+    titerator end)
+{
+    std::vector<std::pair<int, unsigned int>> visited;
+    
+    for (auto it = begin; it != end; ++it)
+    {
+        EXPECT_EQ(&it->key, &it.key());
+        EXPECT_EQ(&(*it)->value, &it.value());
+        EXPECT_EQ((*it)->depth, it.depth());
+        EXPECT_EQ(it->value, std::to_string(it->key));
+        
+        visited.emplace_back(it->key, it->depth);
+    }
+    
+    return visited;
+}
+
+TEST(binarySearchTreePositiveTests, test13)
+{
+    binary_search_tree<int, std::string> bst(key_comparer(), nullptr, nullptr);
+    
+    for (int key: { 5, 3, 8, 1, 4, 9 })
+    {
+        bst.insert(key, std::to_string(key));
+    }
+    
+    std::vector<std::pair<int, unsigned int>> expected_prefix = { { 5, 0 }, { 3, 1 }, { 1, 2 }, { 4, 2 }, { 8, 1 }, { 9, 2 } };
+    std::vector<std::pair<int, unsigned int>> expected_infix = { { 1, 2 }, { 3, 1 }, { 4, 2 }, { 5, 0 }, { 8, 1 }, { 9, 2 } };
+    std::vector<std::pair<int, unsigned int>> expected_postfix = { { 1, 2 }, { 4, 2 }, { 3, 1 }, { 9, 2 }, { 8, 1 }, { 5, 0 } };
+    std::vector<std::pair<int, unsigned int>> expected_reverse_prefix = { { 5, 0 }, { 8, 1 }, { 9, 2 }, { 3, 1 }, { 4, 2 }, { 1, 2 } };
+    std::vector<std::pair<int, unsigned int>> expected_reverse_infix(expected_infix.rbegin(), expected_infix.rend());
+    std::vector<std::pair<int, unsigned int>> expected_reverse_postfix = { { 9, 2 }, { 8, 1 }, { 4, 2 }, { 1, 2 }, { 3, 1 }, { 5, 0 } };
+    
+    EXPECT_EQ(walk(bst.begin_prefix(), bst.end_prefix()), expected_prefix);
+    EXPECT_EQ(walk(bst.cbegin_prefix(), bst.cend_prefix()), expected_prefix);
+    EXPECT_EQ(walk(bst.rbegin_prefix(), bst.rend_prefix()), expected_reverse_prefix);
+    EXPECT_EQ(walk(bst.crbegin_prefix(), bst.crend_prefix()), expected_reverse_prefix);
+    EXPECT_EQ(walk(bst.begin_infix(), bst.end_infix()), expected_infix);
+    EXPECT_EQ(walk(bst.cbegin_infix(), bst.cend_infix()), expected_infix);
+    EXPECT_EQ(walk(bst.rbegin_infix(), bst.rend_infix()), expected_reverse_infix);
+    EXPECT_EQ(walk(bst.crbegin_infix(), bst.crend_infix()), expected_reverse_infix);
+    EXPECT_EQ(walk(bst.begin_postfix(), bst.end_postfix()), expected_postfix);
+    EXPECT_EQ(walk(bst.cbegin_postfix(), bst.cend_postfix()), expected_postfix);
+    EXPECT_EQ(walk(bst.rbegin_postfix(), bst.rend_postfix()), expected_reverse_postfix);
+    EXPECT_EQ(walk(bst.crbegin_postfix(), bst.crend_postfix()), expected_reverse_postfix);
+    
+    // the entries are views into the nodes: a value written through an iterator is what the tree holds
+    auto it = bst.begin_infix();
+    it.value() = "one";
+    EXPECT_EQ(it->value, "one");
+    EXPECT_EQ(bst.obtain(1), "one");
+}
+
+// recounts a traversal recursively from the root, as the reference for the iterators' own depth tracking
+void collect(
+    stackless_traversal_probe::node const *subtree_root,
+    unsigned int depth,
+    bool mirrored,
+    int order,
+    std::vector<std::pair<int, unsigned int>> &visited)
+{
+    if (subtree_root == nullptr)
+    {
+        return;
+    }
+    
+    auto const *near = mirrored ? subtree_root->right_subtree : subtree_root->left_subtree;
+    auto const *far = mirrored ? subtree_root->left_subtree : subtree_root->right_subtree;
+    
+    if (order == 0)
+    {
+        visited.emplace_back(subtree_root->key, depth);
+    }
+    
+    collect(near, depth + 1, mirrored, order, visited);
+    
+    if (order == 1)
+    {
+        visited.emplace_back(subtree_root->key, depth);
+    }
+    
+    collect(far, depth + 1, mirrored, order, visited);
+    
+    if (order == 2)
+    {
+        visited.emplace_back(subtree_root->key, depth);
+    }
+}
+
+TEST(binarySearchTreePositiveTests, test14)
+{
+    // a tree shaped by shuffled insertions and disposals, walked in every order and direction
+    stackless_traversal_probe bst(key_comparer(), nullptr, nullptr);
+    
+    std::mt19937 engine(14);
+    std::vector<int> keys;
+    for (int key = 0; key < 300; ++key)
+    {
+        keys.push_back(key);
+    }
+    std::shuffle(keys.begin(), keys.end(), engine);
+    
+    for (int key: keys)
+    {
+        bst.insert(key, std::to_string(key));
+    }
+    
+    std::shuffle(keys.begin(), keys.end(), engine);
+    for (size_t i = 0; i < keys.size() / 2; ++i)
+    {
+        bst.dispose(keys[i]);
+    }
+    
+    std::vector<std::pair<int, unsigned int>> expected[2][3];
+    for (int order = 0; order < 3; ++order)
+    {
+        collect(bst.get_root(), 0, false, order, expected[0][order]);
+        collect(bst.get_root(), 0, true, order, expected[1][order]);
+    }
+    
+    ASSERT_EQ(expected[0][1].size(), keys.size() - keys.size() / 2);
+    
+    EXPECT_EQ(walk(bst.begin_prefix(), bst.end_prefix()), expected[0][0]);
+    EXPECT_EQ(walk(bst.cbegin_prefix(), bst.cend_prefix()), expected[0][0]);
+    EXPECT_EQ(walk(bst.rbegin_prefix(), bst.rend_prefix()), expected[1][0]);
+    EXPECT_EQ(walk(bst.crbegin_prefix(), bst.crend_prefix()), expected[1][0]);
+    EXPECT_EQ(walk(bst.begin_infix(), bst.end_infix()), expected[0][1]);
+    EXPECT_EQ(walk(bst.cbegin_infix(), bst.cend_infix()), expected[0][1]);
+    EXPECT_EQ(walk(bst.rbegin_infix(), bst.rend_infix()), expected[1][1]);
+    EXPECT_EQ(walk(bst.crbegin_infix(), bst.crend_infix()), expected[1][1]);
+    EXPECT_EQ(walk(bst.begin_postfix(), bst.end_postfix()), expected[0][2]);
+    EXPECT_EQ(walk(bst.cbegin_postfix(), bst.cend_postfix()), expected[0][2]);
+    EXPECT_EQ(walk(bst.rbegin_postfix(), bst.rend_postfix()), expected[1][2]);
+    EXPECT_EQ(walk(bst.crbegin_postfix(), bst.crend_postfix()), expected[1][2]);
+}
+
+TEST(binarySearchTreePositiveTests, test15)
+{
+    binary_search_tree<int, std::string> bst(key_comparer(), nullptr, nullptr);
+    
+    check_range_queries(bst);
+}
+
 int main(
     int argc,
     char **argv)
@@ -0,0 +1,792 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_SEARCH_TREE_CHECKS_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_SEARCH_TREE_CHECKS_H
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <binary_search_tree.h>
+
+// checks shared by the suites of the binary search trees, on int keys and std::string values unless a check says
+// otherwise; each one asserts the tree's own check_invariants(), so the tree-specific invariants stay with the tree
+
+inline bool same_entries(
+    std::vector<associative_container<int, std::string>::key_value_pair> const &expected,
+    std::vector<associative_container<int, std::string>::key_value_pair> const &actual)
+{
+    return std::equal(expected.begin(), expected.end(), actual.begin(), actual.end(),
+        [](associative_container<int, std::string>::key_value_pair const &left, associative_container<int, std::string>::key_value_pair const &right)
+        {
+            return left.key == right.key && left.value == right.value;
+        });
+}
+
+// fills an empty tree with the keys 10, 20, ..., 100 valued by their decimal spelling; every bound has to land
+// on the node the infix walk reaches with the same key, at the same depth, and the range scans have to honour
+// the inclusivity of both ends
+template<
+    typename ttree>
+void check_range_queries(
+    ttree &tree)
+{
+    EXPECT_TRUE(tree.lower_bound(1) == tree.end_infix());
+    EXPECT_TRUE(tree.upper_bound(1) == tree.end_infix());
+    EXPECT_TRUE(tree.clower_bound(1) == tree.cend_infix());
+    EXPECT_TRUE(tree.cupper_bound(1) == tree.cend_infix());
+    
+    auto scan = [&tree](int lower_bound, int upper_bound, bool lower_bound_inclusive, bool upper_bound_inclusive, size_t visits_limit)
+    {
+        std::vector<int> visited;
+        
+        tree.for_each_between(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive,
+            [&visited, visits_limit](int const &key, std::string const &value)
+            {
+                EXPECT_EQ(value, std::to_string(key));
+                visited.push_back(key);
+                
+                return visited.size() < visits_limit;
+            });
+        
+        return visited;
+    };
+    
+    EXPECT_TRUE(scan(0, 100, true, true, 100).empty());
+    
+    for (int key: { 70, 30, 90, 10, 50, 100, 20, 60, 40, 80 })
+    {
+        tree.insert(key, std::to_string(key));
+    }
+    
+    std::map<int, unsigned int> depths;
+    for (auto it = tree.cbegin_infix(); it != tree.cend_infix(); ++it)
+    {
+        depths.emplace(it.key(), it.depth());
+    }
+    
+    // an expected key of 0 stands for the end of the infix walk
+    auto lands_on = [&depths](auto bound, auto end, int key)
+    {
+        if (key == 0)
+        {
+            return bound == end;
+        }
+        
+        return bound != end &&
+            bound.key() == key &&
+            bound->key == key &&
+            (*bound)->value == std::to_string(key) &&
+            bound.depth() == depths.at(key) &&
+            bound->depth == depths.at(key);
+    };
+    
+    struct
+    {
+        
+        int key;
+        
+        int lower_bound;
+        
+        int upper_bound;
+        
+    } const bounds[] =
+        {
+            { 0, 10, 10 },
+            { 10, 10, 20 },
+            { 30, 30, 40 },
+            { 35, 40, 40 },
+            { 99, 100, 100 },
+            { 100, 100, 0 },
+            { 101, 0, 0 },
+        };
+    
+    for (auto const &bound: bounds)
+    {
+        EXPECT_TRUE(lands_on(tree.lower_bound(bound.key), tree.end_infix(), bound.lower_bound)) << bound.key;
+        EXPECT_TRUE(lands_on(tree.upper_bound(bound.key), tree.end_infix(), bound.upper_bound)) << bound.key;
+        EXPECT_TRUE(lands_on(tree.clower_bound(bound.key), tree.cend_infix(), bound.lower_bound)) << bound.key;
+        EXPECT_TRUE(lands_on(tree.cupper_bound(bound.key), tree.cend_infix(), bound.upper_bound)) << bound.key;
+    }
+    
+    // a bound keeps walking in key order, with the depths the walk from the smallest key reports
+    std::vector<int> walked;
+    for (auto it = tree.clower_bound(35), end = tree.cupper_bound(70); it != end; ++it)
+    {
+        EXPECT_EQ(it.depth(), depths.at(it.key()));
+        walked.push_back(it.key());
+    }
+    EXPECT_EQ(walked, (std::vector<int> { 40, 50, 60, 70 }));
+    
+    // a bound is a view into its node, so a value written through it is what the tree holds
+    tree.lower_bound(45).value() = "fifty";
+    EXPECT_EQ(tree.obtain(50), "fifty");
+    tree.lower_bound(50).value() = "50";
+    EXPECT_EQ(tree.obtain(50), "50");
+    
+    EXPECT_EQ(scan(20, 50, true, true, 100), (std::vector<int> { 20, 30, 40, 50 }));
+    EXPECT_EQ(scan(20, 50, true, false, 100), (std::vector<int> { 20, 30, 40 }));
+    EXPECT_EQ(scan(20, 50, false, true, 100), (std::vector<int> { 30, 40, 50 }));
+    EXPECT_EQ(scan(20, 50, false, false, 100), (std::vector<int> { 30, 40 }));
+    EXPECT_EQ(scan(25, 55, true, true, 100), (std::vector<int> { 30, 40, 50 }));
+    EXPECT_EQ(scan(25, 55, false, false, 100), (std::vector<int> { 30, 40, 50 }));
+    EXPECT_EQ(scan(0, 200, false, false, 100), (std::vector<int> { 10, 20, 30, 40, 50, 60, 70, 80, 90, 100 }));
+    EXPECT_EQ(scan(50, 50, true, true, 100), (std::vector<int> { 50 }));
+    EXPECT_TRUE(scan(50, 50, true, false, 100).empty());
+    EXPECT_TRUE(scan(41, 49, true, true, 100).empty());
+    EXPECT_TRUE(scan(101, 200, true, true, 100).empty());
+    EXPECT_TRUE(scan(0, 5, true, true, 100).empty());
+    EXPECT_TRUE(scan(50, 20, true, true, 100).empty());
+    
+    // the scan stops at the first visit the visitor declines to continue after
+    EXPECT_EQ(scan(20, 90, true, true, 3), (std::vector<int> { 20, 30, 40 }));
+    EXPECT_EQ(scan(20, 90, false, true, 1), (std::vector<int> { 30 }));
+}
+
+template<
+    template<
+        typename tkey,
+        typename tvalue,
+        typename tkey_comparer = default_keys_comparer<tkey>,
+        typename taugmentation = no_augmentation> class ttree>
+void check_bulk_load_and_updates(
+    logger *logger)
+{
+    // bulk loaded even keys, then odd keys inserted and a random half of all keys disposed in shuffled order
+    std::vector<associative_container<int, std::string>::key_value_pair> loaded;
+    for (int key = 0; key < 2000; key += 2)
+    {
+        loaded.push_back({ key, std::to_string(key) });
+    }
+    
+    ttree<int, std::string> subject(loaded.begin(), loaded.end(), nullptr, logger);
+    std::map<int, std::string> expected;
+    for (auto const &entry: loaded)
+    {
+        expected.emplace(entry.key, entry.value);
+    }
+    
+    EXPECT_TRUE(subject.check_invariants());
+    
+    std::mt19937 engine(12);
+    std::vector<int> keys;
+    for (int key = 1; key < 2000; key += 2)
+    {
+        keys.push_back(key);
+    }
+    std::shuffle(keys.begin(), keys.end(), engine);
+    
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        subject.insert(keys[i], std::to_string(keys[i]));
+        expected.emplace(keys[i], std::to_string(keys[i]));
+        
+        if (i % 100 == 0)
+        {
+            ASSERT_TRUE(subject.check_invariants());
+        }
+    }
+    
+    EXPECT_TRUE(subject.check_invariants());
+    
+    keys.clear();
+    for (int key = 0; key < 2000; ++key)
+    {
+        keys.push_back(key);
+    }
+    std::shuffle(keys.begin(), keys.end(), engine);
+    keys.resize(1000);
+    
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        EXPECT_EQ(subject.dispose(keys[i]), std::to_string(keys[i]));
+        expected.erase(keys[i]);
+        
+        if (i % 100 == 0)
+        {
+            ASSERT_TRUE(subject.check_invariants());
+        }
+    }
+    
+    EXPECT_TRUE(subject.check_invariants());
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> actual_result = subject.obtain_between(0, 2000, true, false);
+    std::vector<associative_container<int, std::string>::key_value_pair> expected_result;
+    for (auto const &entry: expected)
+    {
+        expected_result.push_back({ entry.first, entry.second });
+    }
+    
+    EXPECT_TRUE(same_entries(expected_result, actual_result));
+    EXPECT_EQ(subject.obtain(expected.begin()->first), expected.begin()->second);
+}
+
+template<
+    template<
+        typename tkey,
+        typename tvalue,
+        typename tkey_comparer = default_keys_comparer<tkey>,
+        typename taugmentation = no_augmentation> class ttree>
+void check_ascending_updates(
+    logger *logger)
+{
+    // ascending insertions and disposals from the front are the worst case for an unbalanced tree
+    ttree<int, std::string> subject(nullptr, logger);
+    
+    for (int key = 0; key < 1024; ++key)
+    {
+        subject.insert(key, std::to_string(key));
+        ASSERT_TRUE(subject.check_invariants());
+    }
+    
+    for (int key = 0; key < 1000; ++key)
+    {
+        subject.dispose(key);
+        ASSERT_TRUE(subject.check_invariants());
+    }
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> actual_result = subject.obtain_between(0, 1024, true, false);
+    std::vector<associative_container<int, std::string>::key_value_pair> expected_result;
+    for (int key = 1000; key < 1024; ++key)
+    {
+        expected_result.push_back({ key, std::to_string(key) });
+    }
+    
+    EXPECT_TRUE(same_entries(expected_result, actual_result));
+    EXPECT_THROW(subject.dispose(0), std::logic_error);
+}
+
+template<
+    template<
+        typename tkey,
+        typename tvalue,
+        typename tkey_comparer = default_keys_comparer<tkey>,
+        typename taugmentation = no_augmentation> class ttree>
+void check_insert_many(
+    logger *logger)
+{
+    // batches of every size go into trees of every size through the median split and join recursion
+    std::vector<associative_container<int, std::string>::key_value_pair> loaded;
+    for (int key = 0; key < 3000; key += 3)
+    {
+        loaded.push_back({ key, std::to_string(key) });
+    }
+    
+    ttree<int, std::string> subject(loaded.begin(), loaded.end(), nullptr, logger, ttree<int, std::string>::insertion_of_existent_key_attempt_strategy::update_value);
+    std::map<int, std::string> expected;
+    for (auto const &entry: loaded)
+    {
+        expected.emplace(entry.key, entry.value);
+    }
+    
+    std::mt19937 engine(8);
+    for (size_t batch_size: { 1, 7, 100, 2500 })
+    {
+        std::vector<associative_container<int, std::string>::key_value_pair> batch;
+        for (size_t i = 0; i < batch_size; ++i)
+        {
+            int key = static_cast<int>(engine() % 4000);
+            batch.push_back({ key, "v" + std::to_string(i) });
+            expected[key] = "v" + std::to_string(i);
+        }
+        
+        subject.insert_many(batch.begin(), batch.end());
+        ASSERT_TRUE(subject.check_invariants());
+    }
+    
+    // equal keys inside a batch: the last one wins, as with sequential inserts
+    std::vector<associative_container<int, std::string>::key_value_pair> duplicates =
+        {
+            { 5000, "first" },
+            { 1, "first" },
+            { 5000, "second" },
+            { 1, "second" }
+        };
+    subject.insert_many(duplicates.begin(), duplicates.end());
+    expected[5000] = "second";
+    expected[1] = "second";
+    
+    EXPECT_TRUE(subject.check_invariants());
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> actual_result = subject.obtain_between(0, 6000, true, true);
+    std::vector<associative_container<int, std::string>::key_value_pair> expected_result;
+    for (auto const &entry: expected)
+    {
+        expected_result.push_back({ entry.first, entry.second });
+    }
+    
+    EXPECT_TRUE(same_entries(expected_result, actual_result));
+    
+    // with throw_an_exception neither an existent key nor a repeated one changes anything
+    subject.set_insertion_strategy(ttree<int, std::string>::insertion_of_existent_key_attempt_strategy::throw_an_exception);
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> with_existent =
+        {
+            { 7001, "new" },
+            { 3, "old" },
+            { 7002, "new" }
+        };
+    EXPECT_THROW(subject.insert_many(with_existent.begin(), with_existent.end()), std::logic_error);
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> with_repeated =
+        {
+            { 7001, "new" },
+            { 7003, "new" },
+            { 7001, "new" }
+        };
+    EXPECT_THROW(subject.insert_many(with_repeated.begin(), with_repeated.end()), std::logic_error);
+    
+    actual_result = subject.obtain_between(0, 8000, true, true);
+    EXPECT_TRUE(same_entries(expected_result, actual_result));
+    EXPECT_TRUE(subject.check_invariants());
+}
+
+template<
+    template<
+        typename tkey,
+        typename tvalue,
+        typename tkey_comparer = default_keys_comparer<tkey>,
+        typename taugmentation = no_augmentation> class ttree>
+void check_dispose_many(
+    logger *logger)
+{
+    std::vector<associative_container<int, std::string>::key_value_pair> loaded;
+    for (int key = 0; key < 2000; ++key)
+    {
+        loaded.push_back({ key, std::to_string(key) });
+    }
+    
+    ttree<int, std::string> subject(loaded.begin(), loaded.end(), nullptr, logger);
+    
+    // a missing key throws before anything is disposed
+    std::vector<int> with_missing = { 10, 20, 5000, 30 };
+    EXPECT_THROW(subject.dispose_many(with_missing.begin(), with_missing.end()), std::logic_error);
+    EXPECT_EQ(subject.obtain_between(0, 2000, true, false).size(), 2000);
+    
+    // repeated keys are disposed and counted once
+    std::vector<int> with_repeated = { 10, 20, 10, 30, 20 };
+    EXPECT_EQ(subject.dispose_many(with_repeated.begin(), with_repeated.end()), 3);
+    EXPECT_TRUE(subject.check_invariants());
+    
+    // do_nothing skips the missing keys
+    subject.set_removal_strategy(ttree<int, std::string>::disposal_of_nonexistent_key_attempt_strategy::do_nothing);
+    
+    std::vector<int> batch;
+    for (int key = 1; key < 2000; key += 2)
+    {
+        batch.push_back(key);
+    }
+    batch.push_back(-1);
+    batch.push_back(5000);
+    batch.push_back(10);
+    
+    EXPECT_EQ(subject.dispose_many(batch.begin(), batch.end()), 1000);
+    EXPECT_TRUE(subject.check_invariants());
+    
+    std::vector<associative_container<int, std::string>::key_value_pair> actual_result = subject.obtain_between(0, 2000, true, false);
+    std::vector<associative_container<int, std::string>::key_value_pair> expected_result;
+    for (int key = 0; key < 2000; key += 2)
+    {
+        if (key != 10 && key != 20 && key != 30)
+        {
+            expected_result.push_back({ key, std::to_string(key) });
+        }
+    }
+    
+    EXPECT_TRUE(same_entries(expected_result, actual_result));
+    
+    std::vector<int> everything;
+    for (int key = -5; key < 2005; ++key)
+    {
+        everything.push_back(key);
+    }
+    
+    EXPECT_EQ(subject.dispose_many(everything.begin(), everything.end()), expected_result.size());
+    EXPECT_TRUE(subject.obtain_between(-10, 3000, true, true).empty());
+    EXPECT_TRUE(subject.check_invariants());
+}
+
+template<
+    template<
+        typename tkey,
+        typename tvalue,
+        typename tkey_comparer = default_keys_comparer<tkey>,
+        typename taugmentation = no_augmentation> class ttree>
+void check_split_and_join(
+    logger *logger)
+{
+    // splits at keys below, inside and above the content leave parts of very different heights, which the joins
+    // have to rebalance
+    ttree<int, std::string> subject(nullptr, logger);
+    
+    std::vector<int> keys;
+    for (int key = 0; key < 2000; key += 2)
+    {
+        keys.push_back(key);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(15));
+    for (int key: keys)
+    {
+        subject.insert(key, std::to_string(key));
+    }
+    
+    auto entries_between = [](int lower_bound, int upper_bound, int extra_key)
+    {
+        std::vector<associative_container<int, std::string>::key_value_pair> entries;
+        for (int key = lower_bound; key < upper_bound; ++key)
+        {
+            if ((key % 2 == 0 && key >= 0 && key < 2000) || key == extra_key)
+            {
+                entries.push_back({ key, std::to_string(key) });
+            }
+        }
+        
+        return entries;
+    };
+    
+    for (int split_key: { -1, 1, 3, 501, 1001, 1995, 1997, 5001 })
+    {
+        ttree<int, std::string> whole(subject);
+        ttree<int, std::string> left;
+        ttree<int, std::string> right;
+        
+        whole.split(split_key, left, right);
+        
+        ASSERT_TRUE(left.check_invariants());
+        ASSERT_TRUE(right.check_invariants());
+        EXPECT_TRUE(whole.obtain_between(-10, 6000, true, true).empty());
+        
+        auto expected_left = entries_between(0, std::min(split_key, 2000), split_key + 1);
+        auto expected_right = entries_between(std::max(split_key, 0), 2000, split_key + 1);
+        auto actual_left = left.obtain_between(-10, 6000, true, true);
+        auto actual_right = right.obtain_between(-10, 6000, true, true);
+        
+        EXPECT_TRUE(same_entries(expected_left, actual_left));
+        EXPECT_TRUE(same_entries(expected_right, actual_right));
+        
+        whole.join(left, split_key, std::to_string(split_key), right);
+        
+        ASSERT_TRUE(whole.check_invariants());
+        EXPECT_TRUE(left.obtain_between(-10, 6000, true, true).empty());
+        EXPECT_TRUE(right.obtain_between(-10, 6000, true, true).empty());
+        
+        auto expected_whole = entries_between(std::min(split_key, 0), std::max(split_key + 1, 2000), split_key);
+        auto actual_whole = whole.obtain_between(-10, 6000, true, true);
+        
+        EXPECT_TRUE(same_entries(expected_whole, actual_whole));
+    }
+    
+    EXPECT_EQ(subject.dispose_between(100, 900, true, false), 400);
+    EXPECT_TRUE(subject.check_invariants());
+    
+    auto expected_result = entries_between(0, 100, -1);
+    auto rest = entries_between(900, 2000, -1);
+    expected_result.insert(expected_result.end(), rest.begin(), rest.end());
+    auto actual_result = subject.obtain_between(-10, 6000, true, true);
+    
+    EXPECT_TRUE(same_entries(expected_result, actual_result));
+}
+
+template<
+    template<
+        typename tkey,
+        typename tvalue,
+        typename tkey_comparer = default_keys_comparer<tkey>,
+        typename taugmentation = no_augmentation> class ttree>
+void check_set_operations(
+    logger *logger)
+{
+    // trees of 20000 entries are deep enough to fork; a limit of one thread combines them on the calling one
+    auto entries_of = [](int first, int last, int step, std::string const &prefix)
+    {
+        std::vector<associative_container<int, std::string>::key_value_pair> entries;
+        for (int key = first; key < last; key += step)
+        {
+            entries.push_back({ key, prefix + std::to_string(key) });
+        }
+        
+        return entries;
+    };
+    
+    std::vector<std::pair<std::vector<associative_container<int, std::string>::key_value_pair>, std::vector<associative_container<int, std::string>::key_value_pair>>> inputs =
+        {
+            { entries_of(0, 40000, 2, "own"), entries_of(0, 60000, 3, "other") },
+            { entries_of(0, 40000, 2, "own"), entries_of(50000, 90000, 2, "other") },
+            { entries_of(50000, 90000, 2, "own"), entries_of(0, 40000, 2, "other") },
+            { entries_of(0, 40000, 2, "own"), {} },
+            { {}, entries_of(0, 40000, 2, "other") },
+            { {}, {} }
+        };
+    
+    for (size_t threads_limit: { 1, 4 })
+    {
+        for (auto const &input: inputs)
+        {
+            for (int operation = 0; operation < 3; ++operation)
+            {
+                ttree<int, std::string> own(input.first.begin(), input.first.end(), nullptr, logger);
+                ttree<int, std::string> other(input.second.begin(), input.second.end(), nullptr, logger);
+                
+                std::map<int, std::string> own_entries;
+                for (auto const &entry: input.first)
+                {
+                    own_entries.emplace(entry.key, entry.value);
+                }
+                std::map<int, std::string> other_entries;
+                for (auto const &entry: input.second)
+                {
+                    other_entries.emplace(entry.key, entry.value);
+                }
+                
+                std::map<int, std::string> expected;
+                switch (operation)
+                {
+                    case 0:
+                        own.unite(other, threads_limit);
+                        expected = other_entries;
+                        for (auto const &entry: own_entries)
+                        {
+                            expected[entry.first] = entry.second;
+                        }
+                        break;
+                    case 1:
+                        own.intersect(other, threads_limit);
+                        for (auto const &entry: own_entries)
+                        {
+                            if (other_entries.count(entry.first) != 0)
+                            {
+                                expected.insert(entry);
+                            }
+                        }
+                        break;
+                    default:
+                        own.subtract(other, threads_limit);
+                        for (auto const &entry: own_entries)
+                        {
+                            if (other_entries.count(entry.first) == 0)
+                            {
+                                expected.insert(entry);
+                            }
+                        }
+                        break;
+                }
+                
+                ASSERT_TRUE(own.check_invariants());
+                EXPECT_TRUE(other.obtain_between(-1, 100000, true, true).empty());
+                
+                std::vector<associative_container<int, std::string>::key_value_pair> expected_result;
+                for (auto const &entry: expected)
+                {
+                    expected_result.push_back({ entry.first, entry.second });
+                }
+                auto actual_result = own.obtain_between(-1, 100000, true, true);
+                
+                EXPECT_TRUE(same_entries(expected_result, actual_result));
+            }
+        }
+    }
+}
+
+template<
+    template<
+        typename tkey,
+        typename tvalue,
+        typename tkey_comparer = default_keys_comparer<tkey>,
+        typename taugmentation = no_augmentation> class ttree>
+void check_rank_and_select(
+    logger *logger)
+{
+    // keys are multiples of three, so every key has a non-key neighbour on each side
+    ttree<int, std::string, default_keys_comparer<int>, subtree_size_augmentation> tree(nullptr, logger);
+    
+    std::vector<int> keys;
+    for (int key = 0; key < 3000; key += 3)
+    {
+        keys.push_back(key);
+    }
+    std::vector<int> shuffled_keys = keys;
+    std::shuffle(shuffled_keys.begin(), shuffled_keys.end(), std::mt19937(48));
+    for (auto key: shuffled_keys)
+    {
+        tree.insert(key, std::to_string(key));
+    }
+    
+    auto check_order_statistics = [&tree](std::vector<int> const &present_keys)
+    {
+        for (size_t index = 0; index < present_keys.size(); ++index)
+        {
+            int key = present_keys[index];
+            
+            ASSERT_EQ(tree.rank(key), index);
+            ASSERT_EQ(tree.rank(key + 1), index + 1);
+            ASSERT_TRUE(tree.select(index) == tree.clower_bound(key));
+            ASSERT_TRUE(tree.select(tree.rank(key)) == tree.clower_bound(key));
+            ASSERT_TRUE(++tree.select(index) == tree.select(index + 1));
+        }
+        
+        EXPECT_TRUE(tree.select(present_keys.size()) == tree.cend_infix());
+        EXPECT_EQ(tree.rank(-1), 0);
+        EXPECT_EQ(tree.rank(3000), present_keys.size());
+        
+        size_t middle = present_keys.size() / 2;
+        int lower = present_keys[middle / 2];
+        int upper = present_keys[middle];
+        EXPECT_EQ(tree.count_between(lower, upper, true, true), middle - middle / 2 + 1);
+        EXPECT_EQ(tree.count_between(lower, upper, false, true), middle - middle / 2);
+        EXPECT_EQ(tree.count_between(lower, upper, true, false), middle - middle / 2);
+        EXPECT_EQ(tree.count_between(lower, upper, false, false), middle - middle / 2 - 1);
+        EXPECT_EQ(tree.count_between(lower + 1, upper - 1, true, true), middle - middle / 2 - 1);
+        EXPECT_EQ(tree.count_between(-1, 3000, true, true), present_keys.size());
+        EXPECT_EQ(tree.count_between(upper, lower, true, true), 0);
+    };
+    
+    check_order_statistics(keys);
+    
+    // subtree sizes must follow the rotations of the disposals as well
+    std::vector<int> remaining_keys;
+    for (size_t index = 0; index < keys.size(); ++index)
+    {
+        if (index % 3 == 1)
+        {
+            tree.dispose(keys[index]);
+        }
+        else
+        {
+            remaining_keys.push_back(keys[index]);
+        }
+    }
+    
+    ASSERT_TRUE(tree.check_invariants());
+    check_order_statistics(remaining_keys);
+}
+
+// polynomial hash of the keys sequence: combine is not commutative, so any fold out of key order changes the aggregate
+struct keys_sequence_hash
+{
+
+public:
+    
+    struct value_type
+    {
+        
+        unsigned long long hash;
+        
+        unsigned long long power;
+        
+    };
+
+public:
+    
+    static value_type identity() noexcept
+    {
+        return { 0, 1 };
+    }
+    
+    template<
+        typename tvalue>
+    static value_type of(
+        int key,
+        tvalue const &) noexcept
+    {
+        return { static_cast<unsigned long long>(key) + 1, 1000003 };
+    }
+    
+    static value_type combine(
+        value_type const &left,
+        value_type const &right) noexcept
+    {
+        return { left.hash * right.power + right.hash, left.power * right.power };
+    }
+    
+};
+
+template<
+    template<
+        typename tkey,
+        typename tvalue,
+        typename tkey_comparer = default_keys_comparer<tkey>,
+        typename taugmentation = no_augmentation> class ttree>
+void check_range_aggregates(
+    logger *logger)
+{
+    // values equal to the keys make every bound combination give a distinct sum
+    ttree<int, int, default_keys_comparer<int>, monoid_augmentation<values_sum<int>>> sums(nullptr, logger);
+    for (int key = 1; key <= 10; ++key)
+    {
+        sums.insert(key, key);
+    }
+    
+    EXPECT_EQ(sums.aggregate_between(3, 7, true, true), 25);
+    EXPECT_EQ(sums.aggregate_between(3, 7, false, true), 22);
+    EXPECT_EQ(sums.aggregate_between(3, 7, true, false), 18);
+    EXPECT_EQ(sums.aggregate_between(3, 7, false, false), 15);
+    EXPECT_EQ(sums.aggregate_between(4, 4, true, true), 4);
+    EXPECT_EQ(sums.aggregate_between(4, 4, true, false), 0);
+    EXPECT_EQ(sums.aggregate_between(4, 5, false, false), 0);
+    EXPECT_EQ(sums.aggregate_between(7, 3, true, true), 0);
+    EXPECT_EQ(sums.aggregate_between(0, 11, false, false), 55);
+    
+    ttree<int, std::string, default_keys_comparer<int>, monoid_augmentation<keys_sequence_hash>> tree(nullptr, logger);
+    std::map<int, std::string> model;
+    
+    std::vector<int> keys;
+    for (int key = 0; key < 2000; key += 2)
+    {
+        keys.push_back(key);
+    }
+    std::mt19937 engine(49);
+    std::shuffle(keys.begin(), keys.end(), engine);
+    for (auto key: keys)
+    {
+        tree.insert(key, std::to_string(key));
+        model.emplace(key, std::to_string(key));
+    }
+    
+    auto check_aggregates = [&]()
+    {
+        std::uniform_int_distribution<int> bound_distribution(-2, 2001);
+        
+        for (size_t attempt = 0; attempt < 200; ++attempt)
+        {
+            int lower = bound_distribution(engine);
+            int upper = bound_distribution(engine);
+            
+            for (int inclusivity = 0; inclusivity < 4; ++inclusivity)
+            {
+                bool lower_inclusive = (inclusivity & 1) != 0;
+                bool upper_inclusive = (inclusivity & 2) != 0;
+                
+                keys_sequence_hash::value_type expected = keys_sequence_hash::identity();
+                for (auto const &entry: model)
+                {
+                    if ((entry.first > lower || (entry.first == lower && lower_inclusive)) &&
+                        (entry.first < upper || (entry.first == upper && upper_inclusive)))
+                    {
+                        expected = keys_sequence_hash::combine(expected, keys_sequence_hash::of(entry.first, entry.second));
+                    }
+                }
+                
+                auto actual = tree.aggregate_between(lower, upper, lower_inclusive, upper_inclusive);
+                
+                ASSERT_EQ(actual.hash, expected.hash);
+                ASSERT_EQ(actual.power, expected.power);
+            }
+        }
+    };
+    
+    check_aggregates();
+    
+    // the aggregates must follow the rotations of the disposals as well
+    for (size_t index = 0; index < keys.size(); index += 3)
+    {
+        tree.dispose(keys[index]);
+        model.erase(keys[index]);
+    }
+    
+    ASSERT_TRUE(tree.check_invariants());
+    check_aggregates();
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SEARCH_TREE_CHECKS_H
@@ -3,7 +3,10 @@
 
 #include <iostream>
 #include <functional>
+#include <memory>
 #include <stack>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <allocator.h>
@@ -13,9 +16,116 @@
 #include <logger_guardant.h>
 #include <not_implemented.h>
 
+// strict weak ordering of tkey folded into a three way result; inlined into tree descents
+template<
+    typename tkey>
+struct three_way_comparer final
+{
+    
+    int operator()(
+        tkey const &first,
+        tkey const &second) const
+    {
+        return first < second
+            ? -1
+            : (second < first
+                ? 1
+                : 0);
+    }
+    
+};
+
+// comparer for keys ordered by a callable known only at runtime: type erases it
+// behind std::function, so every comparison is an indirect call and every copy may allocate.
+// pass a concrete comparer type as the tkey_comparer template argument to keep custom comparisons inlined
+template<
+    typename tkey>
+class type_erased_keys_comparer final
+{
+
+private:
+    
+    std::function<int(tkey const &, tkey const &)> _comparer;
+
+public:
+    
+    type_erased_keys_comparer():
+        _comparer(three_way_comparer<tkey>())
+    {
+    
+    }
+    
+    template<
+        typename tcallable,
+        typename = typename std::enable_if<!std::is_same<typename std::decay<tcallable>::type, type_erased_keys_comparer>::value>::type>
+    type_erased_keys_comparer(
+        tcallable &&comparer):
+        _comparer(std::forward<tcallable>(comparer))
+    {
+    
+    }
+
+public:
+    
+    int operator()(
+        tkey const &first,
+        tkey const &second) const
+    {
+        return _comparer(first, second);
+    }
+    
+};
+
+// default comparer of the trees: compares with three_way_comparer, which is inlined into the descents.
+// It converts from any other callable for compatibility with the std::function based api; such a callable
+// is type erased into a shared type_erased_keys_comparer, and only those trees pay for an indirect call
+template<
+    typename tkey>
+class default_keys_comparer final
+{
+
+private:
+    
+    std::shared_ptr<type_erased_keys_comparer<tkey> const> _type_erased_comparer;
+
+public:
+    
+    default_keys_comparer() = default;
+    
+    default_keys_comparer(
+        three_way_comparer<tkey> const &) noexcept
+    {
+    
+    }
+    
+    template<
+        typename tcallable,
+        typename = typename std::enable_if<!std::is_same<typename std::decay<tcallable>::type, default_keys_comparer>::value &&
+            !std::is_same<typename std::decay<tcallable>::type, three_way_comparer<tkey>>::value>::type>
+    default_keys_comparer(
+        tcallable &&comparer):
+        _type_erased_comparer(std::make_shared<type_erased_keys_comparer<tkey> const>(std::forward<tcallable>(comparer)))
+    {
+    
+    }
+
+public:
+    
+    int operator()(
+        tkey const &first,
+        tkey const &second) const
+    {
+        return _type_erased_comparer == nullptr
+            ? three_way_comparer<tkey>()(first, second)
+            : (*_type_erased_comparer)(first, second);
+    }
+    
+};
+
 template<
     typename tkey,
-    typename tvalue>
+    typename tvalue,
+    typename tkey_comparer = default_keys_comparer<tkey>>
 class search_tree:
     public associative_container<tkey, tvalue>,
     protected allocator_guardant,
@@ -45,7 +155,7 @@ public:
 
 protected:
     
-    std::function<int(tkey const &, tkey const &)> _keys_comparer;
+    tkey_comparer _keys_comparer;
 
 private:
     
@@ -56,7 +166,7 @@ private:
 protected:
     
     explicit search_tree(
-        std::function<int(tkey const &, tkey const &)> keys_comparer = std::less<tkey>(),
+        tkey_comparer keys_comparer = tkey_comparer(),
         logger *logger = nullptr,
         allocator *allocator = nullptr);
     
@@ -76,51 +186,59 @@ protected:
     
 };
 
-//region search_tree<tkey, tvalue>::node implementation
+//region search_tree<tkey, tvalue, tkey_comparer>::node implementation
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::common_node::common_node()
+    typename tvalue,
+    typename tkey_comparer>
+search_tree<tkey, tvalue, tkey_comparer>::common_node::common_node()
 {
-    throw not_implemented("template<typename tkey, typename tvalue> search_tree<tkey, tvalue>::common_node::common_node()", "your code should be here...");
+    throw not_implemented("template<typename tkey, typename tvalue, typename tkey_comparer> search_tree<tkey, tvalue, tkey_comparer>::common_node::common_node()", "your code should be here...");
 }
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::common_node::~common_node() noexcept
+    typename tvalue,
+    typename tkey_comparer>
+search_tree<tkey, tvalue, tkey_comparer>::common_node::~common_node() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue> search_tree<tkey, tvalue>::common_node::~common_node() noexcept", "your code should be here...");
+    throw not_implemented("template<typename tkey, typename tvalue, typename tkey_comparer> search_tree<tkey, tvalue, tkey_comparer>::common_node::~common_node() noexcept", "your code should be here...");
 }
 
-// endregion search_tree<tkey, tvalue>::node implementation
+// endregion search_tree<tkey, tvalue, tkey_comparer>::node implementation
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::search_tree(
-    std::function<int(tkey const &, tkey const &)> keys_comparer,
+    typename tvalue,
+    typename tkey_comparer>
+search_tree<tkey, tvalue, tkey_comparer>::search_tree(
+    tkey_comparer keys_comparer,
     logger *logger,
-    allocator *allocator)
+    allocator *allocator):
+    _keys_comparer(keys_comparer),
+    _logger(logger),
+    _allocator(allocator)
 {
-    throw not_implemented("template<typename tkey, typename tvalue> search_tree<tkey, tvalue>::search_tree(std::function<int(tkey const &, tkey const &)>, logger *, allocator *)", "your code should be here...");
+
 }
 
 template<
     typename tkey,
-    typename tvalue>
-[[nodiscard]] inline allocator *search_tree<tkey, tvalue>::get_allocator() const
+    typename tvalue,
+    typename tkey_comparer>
+[[nodiscard]] inline allocator *search_tree<tkey, tvalue, tkey_comparer>::get_allocator() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue> [[nodiscard]] inline allocator *search_tree<tkey, tvalue>::get_allocator() const", "your code should be here...");
+    return _allocator;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-[[nodiscard]] inline logger *search_tree<tkey, tvalue>::get_logger() const
+    typename tvalue,
+    typename tkey_comparer>
+[[nodiscard]] inline logger *search_tree<tkey, tvalue, tkey_comparer>::get_logger() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue> [[nodiscard]] inline logger *search_tree<tkey, tvalue>::get_logger() const", "your code should be here...");
+    return _logger;
 }
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SEARCH_TREE_H
\ No newline at end of file